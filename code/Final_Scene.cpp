@@ -15,6 +15,7 @@
 
 #include <basics/Canvas>
 #include <basics/Director>
+#include <basics/Frame_Arena>
 #include <basics/Transformation>
 
 using namespace basics;
@@ -75,8 +76,10 @@ namespace project_template
                     Point2f touch_location = { *event[ID(x)].as< var::Float > (), *event[ID(y)].as< var::Float > () };
 
 
-                     if      (reinicio_button_pointer->contains(touch_location)) play();
-                     else if (menu_button_pointer->contains(touch_location))
+                     basics::Entity_Store::Handle touched = hit_grid.hit(camera.to_world(touch_location));
+
+                     if      (touched == reinicio_button_pointer->get_handle()) play();
+                     else if (touched == menu_button_pointer->get_handle())
                          director.run_scene (shared_ptr< Scene >(new Menu_Scene()));
 
 
@@ -209,10 +212,10 @@ namespace project_template
     {
 
 
-        // Se crean los objetos no dinámicos de la escena
-        GameObject_Handle play_button_object(new GameObject (textures[ID(restart_button_id)]. get(), real_aspect_ratio, 2));
-        GameObject_Handle instructions_button_object(new GameObject (textures[ID(menu_button_id)]. get(), real_aspect_ratio, 2));
-        GameObject_Handle background(new GameObject (textures[ID(background_id)].get(), 2));
+        // Se crean los objetos no dinámicos de la escena (en el orden en el que se dibujan)
+        GameObject_Handle background = make_pooled< GameObject > (entities, textures[ID(background_id)].get(), 2);
+        GameObject_Handle play_button_object = make_pooled< GameObject > (entities, textures[ID(restart_button_id)]. get(), real_aspect_ratio, 2);
+        GameObject_Handle instructions_button_object = make_pooled< GameObject > (entities, textures[ID(menu_button_id)]. get(), real_aspect_ratio, 2);
 
         //Posicionamos los objetos
         play_button_object-> set_position({(canvas_width * 0.5f), (canvas_height * 0.5f)});
@@ -229,6 +232,15 @@ namespace project_template
         reinicio_button_pointer         = play_button_object .get();
         menu_button_pointer = instructions_button_object.get();
 
+        //La camara empieza mostrando todo el canvas
+        camera.set_viewport({ float(canvas_width), float(canvas_height) });
+        camera.set_position({ canvas_width * 0.5f, canvas_height * 0.5f });
+
+        //Registramos los botones en el indice espacial
+        hit_grid.resize({ 0.f, 0.f }, { float(canvas_width), float(canvas_height) });
+        hit_grid.add(entities, reinicio_button_pointer->get_handle());
+        hit_grid.add(entities, menu_button_pointer->get_handle());
+
     }
 
     // ---------------------------------------------------------------------------------------------
@@ -236,10 +248,8 @@ namespace project_template
     {
         // Se actualiza el estado de todos los gameobjects:
 
-        for (auto & obj : objects)
-        {
-            obj->update (time);
-        }
+        entities.move (time);
+        hit_grid.synchronize (entities);
 
 
     }
@@ -249,10 +259,8 @@ namespace project_template
 
     void Final_Scene::render_playfield (Canvas & canvas)
     {
-        for (auto & obj : objects)
-        {
-            obj->render (canvas);
-        }
+        camera.apply (canvas);
+        entities.render (canvas, camera.get_visible_bounds ());
 
         drawFont(canvas);
     }
@@ -272,13 +280,13 @@ namespace project_template
         canvas.set_color (1, 1, 0);
 
         // Se crea el text layout a partir de la cadena creada:
-        Text_Layout text(*font, L"Tu puntuacion");
+        Text_Layout text(*font, L"Tu puntuacion", &frame_arena);
 
         // Y se dibuja en el centro de la pantalla:
         canvas.draw_text({canvas_width * 0.5, canvas_height * 0.90}, text, CENTER);
 
         // Se crea el text layout a partir de la cadena creada:
-        Text_Layout puntuacion_text(*font, std::to_wstring(puntuacion));
+        Text_Layout puntuacion_text(*font, std::to_wstring(puntuacion), &frame_arena);
 
         // Y se dibuja en el centro de la pantalla:
         canvas.draw_text({canvas_width * 0.5, canvas_height * 0.75}, puntuacion_text, CENTER);
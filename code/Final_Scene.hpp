@@ -15,9 +15,11 @@
 #include <list>
 #include <memory>
 
+#include <basics/Camera>
 #include <basics/Canvas>
 #include <basics/Id>
 #include <basics/Scene>
+#include <basics/Spatial_Grid>
 #include <basics/Texture_2D>
 #include <basics/Timer>
 
@@ -33,7 +35,7 @@ namespace project_template {
     class Final_Scene : public basics::Scene {
 
         // Estos typedefs pueden ayudar a hacer el código más compacto y claro:
-        typedef std::shared_ptr<GameObject> GameObject_Handle;
+        typedef basics::Pooled< GameObject > GameObject_Handle;
         typedef std::vector<GameObject_Handle> GameObject_List;
         typedef std::shared_ptr<Texture_2D> Texture_Handle;
         typedef std::map<Id, Texture_Handle> Texture_Map;
@@ -77,8 +79,14 @@ namespace project_template {
 
         //Punteros a las texturas creadas
         Texture_Map textures;
+        //Almacen con los datos de todos los gameobjects de la escena (debe declararse antes que la lista)
+        basics::Entity_Store entities;
         //Lista de gameobjects que se utilizan en la escena
         GameObject_List objects;
+        //Indice espacial de los botones para saber cual se toca
+        basics::Spatial_Grid hit_grid;
+        //Camara con la que se ve la escena (solo se dibuja lo que queda dentro de su vista)
+        basics::Camera camera;
 
         Timer timer;
 
@@ -5,16 +5,19 @@ using namespace basics;
 namespace project_template {
 
     //Constructor del objeto
-    GameObject::GameObject(Texture_2D* _texture, float _aspect_ratio, float _scale)
+    GameObject::GameObject(Entity_Store & _store, Texture_2D* _texture, float _aspect_ratio, float _scale)
+    :
+        store(_store)
     {
-        texture = _texture;
-        anchor = basics::CENTER;
-        position = { 0.f, 0.f };
         scale = _scale;
         aspect_ratio = _aspect_ratio;
-        size = { texture->get_width() * scale, texture->get_height() * scale * aspect_ratio };
-        speed = { 0.f, 0.f };
-        visible = true;
+        handle = store.create(_texture, { _texture->get_width() * scale, _texture->get_height() * scale * aspect_ratio }, basics::CENTER);
+    }
+
+    //Destructor del objeto
+    GameObject::~GameObject()
+    {
+        store.destroy(handle);
     }
 
     //Comprobamos que hay un punto dentro del rectangulo
@@ -26,10 +29,10 @@ namespace project_template {
             float this_bottom = this->get_bottom_y();
 
             if (point.coordinates.y() > this_bottom) {
-                float this_right = this_left + this->size.width;
+                float this_right = this_left + this->get_width();
 
                 if (point.coordinates.x() < this_right) {
-                    float this_top = this_bottom + this->size.height;
+                    float this_top = this_bottom + this->get_height();
 
                     if (point.coordinates.y() < this_top) {
                         return true;
@@ -3,6 +3,8 @@
 
 #include <memory>
 #include <basics/Canvas>
+#include <basics/Entity_Store>
+#include <basics/Object_Pool>
 #include <basics/Texture_2D>
 #include <basics/Vector>
 
@@ -14,80 +16,79 @@ namespace project_template {
     using basics::Vector2f;
     using basics::Texture_2D;
 
-    //Todos los elementos que aparezcan en pantalla heredaran de esta clase
+    using basics::Entity_Store;
+    using basics::make_pooled;
+
+    //Todos los elementos que aparezcan en pantalla son un GameObject. El GameObject solo guarda un
+    //handle a la entidad: sus datos estan en el Entity_Store de la escena, que es quien los mueve y
+    //los dibuja todos de una vez. El Entity_Store debe vivir mas que sus GameObject.
     class GameObject {
     protected:
 
-          //Puntero a la textura de esta clase
-        Texture_2D* texture;
-        //Lugar donde se crea la textura en x e y
-        int anchor;
+        //Almacen donde estan los datos del objeto
+        Entity_Store & store;
+        //Entidad del objeto dentro del almacen
+        Entity_Store::Handle handle;
 
-        //Tamaño del objeto
-        Size2f size;
-        //Posicion
-        Point2f position;
         //Escala del objeto - Por defecto es 0.3
         float scale;
         //aspect_ratio
         float aspect_ratio;
 
-        //Velocidad del gameobject, si se mueve
-        Vector2f speed;
-
-        //Indica si es visible en la escena
-        bool visible;
-
     public:
 
         //Constructor que determina algunos parametros del gameobject. Si no se declara una escala, se pone la de 0.3
-        GameObject(Texture_2D* texture, float aspect_ratio, float _scale = 0.3f);
+        GameObject(Entity_Store & store, Texture_2D* texture, float aspect_ratio, float _scale = 0.3f);
 
- //Destructor de la clase
-        virtual ~GameObject() = default;
+        //Destructor de la clase, elimina la entidad del almacen
+        ~GameObject();
+
+        GameObject(const GameObject & ) = delete;
+        GameObject & operator = (const GameObject & ) = delete;
 
     public:
         // Getters (con nombres autoexplicativos):
 
-        const Size2f& get_size() const { return size; }
-        const float& get_width() const { return size.width; }
-        const float& get_height() const { return size.height; }
-        const Point2f& get_position() const { return position; }
-        void set_sullScreen(){ size = { texture->get_width() * scale * aspect_ratio, texture->get_height() * scale * aspect_ratio }; };
-        const float& get_position_x() const { return position[0]; }
-        const float& get_position_y() const { return position[1]; }
-        const Vector2f& get_speed() const { return speed; }
-        const float& get_speed_x() const { return speed[0]; }
-        const float& get_speed_y() const { return speed[1]; }
+        Entity_Store::Handle get_handle() const { return handle; }
+        Size2f get_size() const { return store.get_size(handle); }
+        float get_width() const { return store.get_size(handle).width; }
+        float get_height() const { return store.get_size(handle).height; }
+        Point2f get_position() const { return store.get_position(handle); }
+        void set_sullScreen(){ const Texture_2D * texture = store.get_texture(handle); store.set_size(handle, { texture->get_width() * scale * aspect_ratio, texture->get_height() * scale * aspect_ratio }); };
+        float get_position_x() const { return store.get_position(handle)[0]; }
+        float get_position_y() const { return store.get_position(handle)[1]; }
+        Vector2f get_speed() const { return store.get_speed(handle); }
+        float get_speed_x() const { return store.get_speed(handle)[0]; }
+        float get_speed_y() const { return store.get_speed(handle)[1]; }
 
         float get_left_x() const
         {
-            return (anchor & 0x3) == basics::LEFT ? position[0] : (anchor & 0x3) == basics::RIGHT ? position[0] - size[0] : position[0] - size[0] * .5f;
+            return store.get_left_x(handle);
         }
 
         float get_right_x() const
         {
-            return get_left_x() + size.width;
+            return get_left_x() + get_width();
         }
 
         float get_bottom_y() const
         {
-            return (anchor & 0xC) == basics::BOTTOM ? position[1] : (anchor & 0xC) == basics::TOP ? position[1] - size[1] : position[1] - size[1] * .5f;
+            return store.get_bottom_y(handle);
         }
 
         float get_top_y() const
         {
-            return get_bottom_y() + size.height;
+            return get_bottom_y() + get_height();
         }
 
         bool is_visible() const
         {
-            return visible;
+            return store.is_visible(handle);
         }
 
         bool is_not_visible() const
         {
-            return !visible;
+            return !is_visible();
         }
 
     public:
@@ -95,62 +96,64 @@ namespace project_template {
 
         void set_anchor(int new_anchor)
         {
-            anchor = new_anchor;
+            store.set_anchor(handle, new_anchor);
         }
 
         void set_position(const Point2f& new_position)
         {
-            position = new_position;
+            store.set_position(handle, new_position);
         }
 
         void set_position_x(const float& new_position_x)
         {
-            position.coordinates.x() = new_position_x;
+            store.set_position_x(handle, new_position_x);
         }
 
         void set_position_y(const float& new_position_y)
         {
-            position.coordinates.y() = new_position_y;
+            store.set_position_y(handle, new_position_y);
         }
 
         void set_scale(float new_scale)
         {
+            const Texture_2D * texture = store.get_texture(handle);
+
             scale = new_scale;
-            size = { texture->get_width() * scale, texture->get_height() * scale * aspect_ratio };
+            store.set_size(handle, { texture->get_width() * scale, texture->get_height() * scale * aspect_ratio });
 
         }
 
         void set_speed(const Vector2f& new_speed)
         {
-            speed = new_speed;
+            store.set_speed(handle, new_speed);
         }
 
         void set_speed_x(const float& new_speed_x)
         {
-            speed.coordinates.x() = new_speed_x;
+            store.set_speed_x(handle, new_speed_x);
         }
 
         void set_speed_y(const float& new_speed_y)
         {
-            speed.coordinates.y() = new_speed_y;
+            store.set_speed_y(handle, new_speed_y);
         }
 
         void set_texture(Texture_2D* _texture)
         {
-            texture = _texture;
+            store.set_texture(handle, _texture);
         }
 
     public:
      //Hace el objeto invisible
         void hide()
         {
-            visible = false;
+            store.set_visible(handle, false);
         }
 
       //Hace el objeto visible
         void show()
         {
-            visible = true;
+            store.set_visible(handle, true);
         }
 
     public:
@@ -158,25 +161,6 @@ namespace project_template {
     //Comprueba si un punto está dentro de otro
         bool contains(const Point2f& point);
 
-    public:
-       //Actualiza la posicion del objeto
-        virtual void update(float time)
-        {
-            if (visible) {
-                Vector2f displacement = speed * time;
-
-                position.coordinates.x() += displacement.coordinates.x();
-                position.coordinates.y() += displacement.coordinates.y();
-            }
-        }
-
-        //Renderiza el objeto para mostrarlo por pantalla
-        virtual void render(Canvas& canvas)
-        {
-            if (visible) {
-                canvas.fill_rectangle(position, size, texture, anchor);
-            }
-        }
     };
 }
 
@@ -15,6 +15,8 @@
 #include <cstdlib>
 #include <basics/Canvas>
 #include <basics/Director>
+#include <basics/Frame_Arena>
+#include <basics/Profiler>
 
 using namespace basics;
 using namespace std;
@@ -51,6 +53,8 @@ namespace project_template
     // ---------------------------------------------------------------------------------------------
 
     Game_Scene::Game_Scene()
+    :
+        sparks(512)
     {
         // Se establece la resolución virtual (independiente de la resolución virtual del dispositivo).
         // En este caso no se hace ajuste de aspect ratio, por lo que puede haber distorsión cuando
@@ -126,11 +130,14 @@ namespace project_template
                             *event[ID(y)].as< var::Float > ()
                     };
 
+                    // Objeto visible que está más arriba en el punto tocado:
+                    basics::Entity_Store::Handle touched = hit_grid.hit(camera.to_world(touch_location));
+
                     if(game_paused)
                     {
-                        if(menuBtn->contains(touch_location))
+                        if(touched == menuBtn->get_handle())
                             director.run_scene (shared_ptr< Scene >(new Menu_Scene()));
-                        else if(reiniciarBtn->contains(touch_location)) {
+                        else if(touched == reiniciarBtn->get_handle()) {
                             director.run_scene (shared_ptr< Scene >(new Game_Scene()));
 
                         }
@@ -143,11 +150,12 @@ namespace project_template
                             menuBtn->hide();
                             reiniciarBtn->hide();
                             clicable_ptr->show();
+                            hit_grid.synchronize(entities);
                         }
                     }
                     else
                     {
-                        if(clicable_ptr->contains(touch_location)) {
+                        if(touched == clicable_ptr->get_handle()) {
                             int randX = rand() % ((int)(canvas_width * .9) - (int)(canvas_width * 0.1) + 1) + (int)(canvas_width * 0.1);
                             int randY = rand() % ((int)(canvas_height * 0.9f) - (int)(canvas_height * 0.1) + 1) + (canvas_height * 0.1);
 
@@ -157,11 +165,16 @@ namespace project_template
                             float diff = 0.3 - 0.2;
                             float r = 0.3 + (random * diff);
 
+                            // Chispas en el punto donde estaba el objeto:
+                            sparks_emitter.position = clicable_ptr->get_position();
+                            sparks.burst(sparks_emitter, 40);
+
                             clicable_ptr->set_position({randX, randY});
                             clicable_ptr->set_scale(r);
+                            hit_grid.update(entities, clicable_ptr->get_handle());
                             clicks++;
                         } else
-                        if(pause->contains(touch_location)){
+                        if(touched == pause->get_handle()){
 
                             //Pausamos el juego
                             pause_the_game(true);
@@ -171,6 +184,7 @@ namespace project_template
                             menuBtn->show();
                             reiniciarBtn->show();
                             clicable_ptr->hide();
+                            hit_grid.synchronize(entities);
                         }
                     }
 
@@ -288,7 +302,7 @@ namespace project_template
     void Game_Scene::create_gameobjects()
     {
 
-        //GameObject_Handle  nombre_objeto(new GameObject (textures[ID(nombre_ID)].get() ));
+        //GameObject_Handle  nombre_objeto = make_pooled< GameObject > (entities, textures[ID(nombre_ID)].get() );
         //...
 
         // 2) Se establecen los anchor y position de los GameObject
@@ -300,12 +314,12 @@ namespace project_template
         //gameobjects.push_back (nombre_objeto);
 
 
-        // Se crean los objetos no dinámicos de la escena
-        GameObject_Handle clicable  (new GameObject (textures[ID(clicable)].get(), real_aspect_ratio, 0.5));
-        GameObject_Handle background (new GameObject (textures[ID(background)].get(), 2));
-        GameObject_Handle pausa_button (new GameObject (textures[ID(pausa)].get(), real_aspect_ratio, 0.5));
-        GameObject_Handle reiniciar_btn(new GameObject (textures[ID(reiniciar_btn)]. get(), real_aspect_ratio, 2));
-        GameObject_Handle menu_btn(new GameObject (textures[ID(menu_btn)]. get(), real_aspect_ratio, 2));
+        // Se crean los objetos no dinámicos de la escena (en el orden en el que se dibujan)
+        GameObject_Handle background = make_pooled< GameObject > (entities, textures[ID(background)].get(), 2);
+        GameObject_Handle clicable = make_pooled< GameObject > (entities, textures[ID(clicable)].get(), real_aspect_ratio, 0.5);
+        GameObject_Handle pausa_button = make_pooled< GameObject > (entities, textures[ID(pausa)].get(), real_aspect_ratio, 0.5);
+        GameObject_Handle reiniciar_btn = make_pooled< GameObject > (entities, textures[ID(reiniciar_btn)]. get(), real_aspect_ratio, 2);
+        GameObject_Handle menu_btn = make_pooled< GameObject > (entities, textures[ID(menu_btn)]. get(), real_aspect_ratio, 2);
 
 
         pausa_button->set_position({pausa_button -> get_width() * 0.5f + (pausa_button -> get_width()), (canvas_height - pausa_button -> get_height())});
@@ -316,7 +330,7 @@ namespace project_template
         menu_btn-> set_position({(canvas_width * 0.5f), ((reiniciar_btn -> get_bottom_y()) - 10 - (menu_btn -> get_height() * 0.5f))});
 
 
-//Determina el Z-Index
+//Lista de objetos de la escena (el Z-Index lo determina el orden de creacion)
         gameobjects.push_back(background);
         gameobjects.push_back(clicable);
         gameobjects.push_back(pausa_button);
@@ -335,6 +349,29 @@ namespace project_template
         menuBtn->hide();
         reiniciarBtn->hide();
 
+        // La cámara empieza mostrando todo el canvas:
+        camera.set_viewport({ float(canvas_width), float(canvas_height) });
+        camera.set_position({ canvas_width * 0.5f, canvas_height * 0.5f });
+
+        // Se registran los objetos que se pueden tocar en el índice espacial:
+        hit_grid.resize({ 0.f, 0.f }, { float(canvas_width), float(canvas_height) });
+        hit_grid.add(entities, clicable_ptr->get_handle());
+        hit_grid.add(entities, pause->get_handle());
+        hit_grid.add(entities, menuBtn->get_handle());
+        hit_grid.add(entities, reiniciarBtn->get_handle());
+
+        // Las chispas usan la textura del objeto clicable entera como slice:
+        Texture_Handle & spark_texture = textures[ID(clicable)];
+        sparks_atlas.reset(new Atlas(spark_texture));
+        sparks.set_slice(sparks_atlas->add_slice(ID(spark), { 0.f, 0.f }, { spark_texture->get_width(), spark_texture->get_height() }));
+        sparks.set_gravity({ 0.f, -600.f });
+
+        sparks_emitter.min_speed  = 200.f;
+        sparks_emitter.max_speed  = 500.f;
+        sparks_emitter.start_size = 40.f;
+        sparks_emitter.end_size   = 4.f;
+        sparks_emitter.color      = 0xFF40D0FF;     // Amarillo anaranjado
+
     }
 
     // ---------------------------------------------------------------------------------------------
@@ -362,13 +399,14 @@ namespace project_template
 
     void Game_Scene::run_simulation (float time)
     {
+        BASICS_PROFILE_ZONE("Game_Scene::run_simulation");
 
         if(gameplay != ENDING) {
 
             // Se actualiza el estado de todos los gameobjects:
-            for (auto &gameobject : gameobjects) {
-                gameobject->update(time);
-            }
+            entities.move(time);
+            hit_grid.synchronize(entities);
+            sparks.update(time);
 
             //Manejamos el timer
             if(!game_paused){
@@ -401,10 +439,11 @@ namespace project_template
 
     void Game_Scene::render_playfield (Canvas & canvas)
     {
-        for (auto & gameobject : gameobjects)
-        {
-            gameobject->render (canvas);
-        }
+        BASICS_PROFILE_ZONE("Game_Scene::render_playfield");
+
+        camera.apply (canvas);
+        entities.render (canvas, camera.get_visible_bounds ());
+        sparks.render (canvas);
 
         if(font && !game_paused && gameplay == PLAYING)
             drawFont(canvas);
@@ -438,8 +477,9 @@ namespace project_template
         canvas.set_color (1, 1, 0);
 
         if(!game_paused) {
-            // Se crea el text layout a partir de la cadena creada:
-            Text_Layout puntuacion_text(*font, std::to_wstring(clicks));
+            // Se crea el text layout a partir de la cadena creada (los glifos van a la arena del
+            // frame, asi que no se reserva memoria cada vez que se pinta):
+            Text_Layout puntuacion_text(*font, std::to_wstring(clicks), &frame_arena);
 
             // Y se dibuja en el centro de la pantalla:
             canvas.draw_text({canvas_width * 0.5, canvas_height * 0.1}, puntuacion_text, CENTER);
@@ -448,15 +488,13 @@ namespace project_template
             //Tiempo que nos queda
             // Se crea el text layout a partir de la cadena creada:
             int tiempo = floor(max_time - currentTime);
-            Text_Layout tiempo_restante(*font, std::to_wstring(tiempo));
+            Text_Layout tiempo_restante(*font, std::to_wstring(tiempo), &frame_arena);
 
             // Y se dibuja en el centro de la pantalla:
             canvas.draw_text({canvas_width * 0.8, canvas_height * 0.9}, tiempo_restante, RIGHT);
         } else {
             //Texto del menu de pause
-            std::string s = "El juego esta pausado, haz click en cualquier lugar de la pantalla para continuar";
-            std::wstring ws(s.begin(), s.end());
-            Text_Layout texto_pausa(*font, ws);
+            Text_Layout texto_pausa(*font, L"El juego esta pausado, haz click en cualquier lugar de la pantalla para continuar", &frame_arena);
 
             // Y se dibuja en el centro de la pantalla:
             canvas.draw_text({canvas_width * 0.5, canvas_height * 0.5}, texto_pausa, CENTER);
@@ -17,9 +17,12 @@
 #include <string>
 
 
+#include <basics/Camera>
 #include <basics/Canvas>
     #include <basics/Id>
+    #include <basics/Particle_System>
     #include <basics/Scene>
+    #include <basics/Spatial_Grid>
     #include <basics/Texture_2D>
     #include <basics/Timer>
 
@@ -37,7 +40,7 @@
         {
 
             // Estos typedefs pueden ayudar a hacer el código más compacto y claro:
-            typedef std::shared_ptr < GameObject >         GameObject_Handle;
+            typedef basics::Pooled< GameObject >           GameObject_Handle;
             typedef std::vector< GameObject_Handle >       GameObject_List;
             typedef std::shared_ptr< Texture_2D  >         Texture_Handle;
             typedef std::map< Id, Texture_Handle >         Texture_Map;
@@ -105,7 +108,14 @@
             float real_aspect_ratio;
 
             Texture_Map textures;
+            basics::Entity_Store entities;      // Datos de los gameobjects (debe declararse antes que la lista)
             GameObject_List gameobjects;
+            basics::Spatial_Grid hit_grid;      // Indice espacial de los objetos que se pueden tocar
+            basics::Camera camera;              // Solo se dibujan los objetos que quedan dentro de su vista
+
+            std::unique_ptr< basics::Atlas > sparks_atlas;  // Atlas con un único slice para las chispas
+            basics::Particle_System sparks;                 // Chispas que salen al tocar el objeto clicable
+            basics::Particle_Emitter sparks_emitter;
 
             Timer timer; // Cronómetro usado para medir intervalos de tiempo
             float timer_in_pause = 0;
@@ -30,10 +30,7 @@ namespace project_template
         }
         else
         {
-            timer.reset ();
-
-            opacity = 0.f;
-            state   = FADING_IN;
+            start_fading_in ();
         }
         return true;
     }
@@ -44,9 +41,8 @@ namespace project_template
         if (!suspended) switch (state)
         {
             case LOADING:    update_loading    (); break;
-            case FADING_IN:  update_fading_in  (); break;
-            case WAITING:    update_waiting    (); break;
-            case FADING_OUT: update_fading_out (); break;
+            case FADING_IN:
+            case FADING_OUT: tweener.update (time); break;
             default: break;
         }
     }
@@ -111,63 +107,47 @@ namespace project_template
             {
                 context->add (logo_texture);
 
-                timer.reset ();
-
-
-                opacity = 0.f;
-                state   = FADING_IN;
+                start_fading_in ();
             }
             else
                 state   = ERROR;
         }
     }
 
-    void Intro_Scene::update_fading_in ()
+    void Intro_Scene::start_fading_in ()
     {
-        float elapsed_seconds = timer.get_elapsed_seconds ();
-
-        if (elapsed_seconds < 1.f)
-        {
-            // Se aumenta la opacidad del logo a medida que pasa el tiempo
-            opacity = elapsed_seconds;
-        }
-        else
-        {
-            timer.reset ();
+        // Se aumenta la opacidad del logo de 0 a 1 en un segundo:
+        tweener.clear ();
+        tweener.add (&opacity, 0.f, 1.f, 1.f, Tweener::LINEAR, 0.f, next_state, this);
 
-            opacity = 1.f;
-            state   = WAITING;
-        }
+        opacity = 0.f;
+        state   = FADING_IN;
     }
 
-    void Intro_Scene::update_waiting ()
+    void Intro_Scene::next_state (void * scene_pointer, Tweener::Handle )
     {
+        Intro_Scene * scene = static_cast< Intro_Scene * >(scene_pointer);
 
-        // Se esperan un segundo sin hacer nada:
-        if (timer.get_elapsed_seconds () > 1.f)
+        switch (scene->state)
         {
-            timer.reset ();
-
-            state = FADING_OUT;
-        }
-    }
-
-    void Intro_Scene::update_fading_out ()
-    {
-        float elapsed_seconds = timer.get_elapsed_seconds ();
+            case FADING_IN:
+            {
+                // Se espera un segundo (el retardo del tween) y se reduce la opacidad de 1 a 0 en medio segundo
+                scene->tweener.add (&scene->opacity, 1.f, 0.f, .5f, Tweener::LINEAR, 1.f, next_state, scene);
+                scene->state = FADING_OUT;
+                break;
+            }
 
-        if (elapsed_seconds < .5f)
-        {
-            // Se reduce la opacidad de 1 a 0 en medio segundo
-            opacity = 1.f - elapsed_seconds * 2.f;
-        }
-        else
-        {
+            case FADING_OUT:
+            {
+                // Cuando el faceout se ha completado, se lanza la siguiente escena:
+                scene->state = FINISHED;
 
-            // Cuando el faceout se ha completado, se lanza la siguiente escena:
-            state = FINISHED;
+                director.run_scene (shared_ptr< Scene >(new Menu_Scene));
+                break;
+            }
 
-            director.run_scene (shared_ptr< Scene >(new Menu_Scene));
+            default: break;
         }
     }
 
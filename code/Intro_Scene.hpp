@@ -16,6 +16,7 @@
 #include <basics/Scene>
 #include <basics/Texture_2D>
 #include <basics/Timer>
+#include <basics/Tweener>
 
 namespace project_template {
 
@@ -33,7 +34,6 @@ namespace project_template {
             UNINITIALIZED,
             LOADING,
             FADING_IN,
-            WAITING,
             FADING_OUT,
             FINISHED,
             ERROR
@@ -50,8 +50,8 @@ namespace project_template {
         unsigned canvas_width;
         unsigned canvas_height;
 
-        //Cronometro para determinar el tiempo del fade out y fade in
-        Timer timer;
+        //Anima la opacidad del logo durante el fade in, la espera y el fade out
+        basics::Tweener tweener;
 
         //Opacidad de la tecxtura elegida como logo
         float opacity;
@@ -97,9 +97,9 @@ namespace project_template {
 
     private:
         void update_loading();
-        void update_fading_in();
-        void update_waiting();
-        void update_fading_out();
+        void start_fading_in();
+        //Se llama al terminar cada fase de la animacion del logo para pasar a la siguiente
+        static void next_state(void * scene, basics::Tweener::Handle tween);
         void adjust_aspect_ratio(Context& context);
     };
 }
@@ -0,0 +1,64 @@
+/*
+ * MENU LAYOUT
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include "Menu_Layout.hpp"
+
+using namespace basics;
+
+namespace project_template
+{
+
+    // ---------------------------------------------------------------------------------------------
+    // ID y ruta de las texturas que se deben cargar para el menu.
+
+    const Menu_Texture_Data menu_textures_data[] =
+            {
+                    { ID(play_button_id),          "menu/comenzarbtn.png"},
+                    { ID(background_id),           "menu/background.png"},
+                    { ID(instructions_button_id),  "menu/objetivobtn.png"},
+                    { ID(logo_button_id),          "menu/logo.png"},
+                    { ID(objetivo_text_id),          "menu/instruccionesinfo.png"}
+
+            };
+
+    // Para determinar el número de items en el array menu_textures_data, se divide el tamaño en
+    // bytes del array completo entre el tamaño en bytes de un item:
+
+    const unsigned menu_textures_count = sizeof(menu_textures_data) / sizeof(Menu_Texture_Data);
+
+    // ---------------------------------------------------------------------------------------------
+    // Crea los objetos del menu
+
+    Menu_Objects create_menu_objects(Entity_Store & entities, Menu_Texture_Map & textures, unsigned canvas_width, unsigned canvas_height, float aspect_ratio)
+    {
+        Menu_Objects menu;
+
+        // Se crean los objetos no dinámicos de la escena (en el orden en el que se dibujan)
+        menu.background = make_pooled< GameObject > (entities, textures[ID(background_id)].get(), 2);
+        menu.play_button = make_pooled< GameObject > (entities, textures[ID(play_button_id)]. get(), aspect_ratio, 2);
+        menu.logo = make_pooled< GameObject > (entities, textures[ID(logo_button_id)].get(), aspect_ratio, 0.5);
+        menu.instructions_button = make_pooled< GameObject > (entities, textures[ID(instructions_button_id)]. get(), aspect_ratio, 2);
+        menu.instructions_text = make_pooled< GameObject > (entities, textures[ID(objetivo_text_id)].get(), aspect_ratio, 1.25f);
+
+        //Posicionamos los objetos
+        menu.logo-> set_position({(canvas_width * 0.5f), (canvas_height - (menu.logo  -> get_height() * 0.5f))});
+        menu.play_button-> set_position({(canvas_width * 0.5f), (canvas_height * 0.5f)});
+        menu.instructions_button-> set_position({(canvas_width * 0.5f), ((menu.play_button -> get_bottom_y()) - 10 - (menu.instructions_button -> get_height() * 0.5f))});
+        menu.background-> set_position({(canvas_width * 0.5f), (canvas_height * 0.5f)});
+        menu.background->set_sullScreen();
+        menu.instructions_text-> set_position({(canvas_width * 0.5f), (canvas_height * 0.5f)});
+
+        //Ocultamos las instrucciones
+        menu.instructions_text->hide();
+
+        return menu;
+    }
+
+}
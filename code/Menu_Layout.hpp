@@ -0,0 +1,59 @@
+/*
+ * MENU LAYOUT
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef MENU_LAYOUT_HEADER
+#define MENU_LAYOUT_HEADER
+
+#include <map>
+#include <memory>
+
+#include <basics/Entity_Store>
+#include <basics/Id>
+#include <basics/Object_Pool>
+#include <basics/Texture_2D>
+
+#include "GameObject.hpp"
+
+namespace project_template {
+
+    using basics::Id;
+
+    //Texturas y objetos del menu. Los usa Menu_Scene y tambien el benchmark de render de basics++,
+    //para que el presupuesto de OpenGL se mida con la misma escena que ve el jugador.
+
+    //Estructura que almacena informacion de la textura y de la ruta a buscar (Las imagenes)
+    struct Menu_Texture_Data {
+        Id id;
+        const char* path;
+    };
+
+    //Array que almacena la informacion de las texturas del menu
+    extern const Menu_Texture_Data menu_textures_data[];
+
+    //Numero de texturas en el array de menu_textures_data
+    extern const unsigned menu_textures_count;
+
+    typedef std::map<Id, std::shared_ptr<basics::Texture_2D>> Menu_Texture_Map;
+
+    //Objetos del menu en el orden en el que se dibujan
+    struct Menu_Objects {
+        basics::Pooled<GameObject> background;
+        basics::Pooled<GameObject> play_button;
+        basics::Pooled<GameObject> logo;
+        basics::Pooled<GameObject> instructions_button;
+        basics::Pooled<GameObject> instructions_text;
+    };
+
+    //Crea y coloca los objetos del menu. Las instrucciones empiezan ocultas.
+    Menu_Objects create_menu_objects(Entity_Store & entities, Menu_Texture_Map & textures, unsigned canvas_width, unsigned canvas_height, float aspect_ratio);
+
+}
+
+#endif
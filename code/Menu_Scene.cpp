@@ -21,24 +21,6 @@ using namespace std;
 namespace project_template
 {
 
-    // ---------------------------------------------------------------------------------------------
-    // ID y ruta de las texturas que se deben cargar para esta escena.
-
-    Menu_Scene::Texture_Data Menu_Scene::textures_data[] =
-            {
-                    { ID(play_button_id),          "menu/comenzarbtn.png"},
-                    { ID(background_id),           "menu/background.png"},
-                    { ID(instructions_button_id),  "menu/objetivobtn.png"},
-                    { ID(logo_button_id),          "menu/logo.png"},
-                    { ID(objetivo_text_id),          "menu/instruccionesinfo.png"}
-
-            };
-
-    // Para determinar el número de items en el array textures_data, se divide el tamaño en bytes
-    // del array completo entre el tamaño en bytes de un item:
-
-    unsigned Menu_Scene::textures_count = sizeof(textures_data) / sizeof(Texture_Data);
-
     Menu_Scene::Menu_Scene()
     {
         state         = LOADING;
@@ -76,8 +58,10 @@ namespace project_template
                     if(!showing_instructions)
                     {
 
-                        if      (play_button_pointer->contains(touch_location)) play();
-                        else if (instructions_button_pointer->contains(touch_location)) show_instructions(true);
+                        basics::Entity_Store::Handle touched = hit_grid.hit(camera.to_world(touch_location));
+
+                        if      (touched == play_button_pointer->get_handle()) play();
+                        else if (touched == instructions_button_pointer->get_handle()) show_instructions(true);
 
                     }
 
@@ -158,7 +142,7 @@ namespace project_template
 
     void Menu_Scene::load_textures ()
     {
-        if (textures.size () < textures_count)          // Si quedan texturas por cargar...
+        if (textures.size () < menu_textures_count)     // Si quedan texturas por cargar...
         {
             // Las texturas se cargan y se suben al contexto gráfico, por lo que es necesario disponer
             // de uno:
@@ -174,7 +158,7 @@ namespace project_template
                 }
 
 //Se cargan las tecturas
-                Texture_Data   & texture_data = textures_data[textures.size ()];
+                const Menu_Texture_Data & texture_data = menu_textures_data[textures.size ()];
                 Texture_Handle & texture      = textures[texture_data.id] = Texture_2D::create (texture_data.id, context, texture_data.path);
 
 
@@ -213,36 +197,30 @@ namespace project_template
     {
 
 
-        // Se crean los objetos no dinámicos de la escena
-        GameObject_Handle play_button_object(new GameObject (textures[ID(play_button_id)]. get(), real_aspect_ratio, 2));
-        GameObject_Handle instructions_button_object(new GameObject (textures[ID(instructions_button_id)]. get(), real_aspect_ratio, 2));
-        GameObject_Handle logo_object(new GameObject (textures[ID(logo_button_id)].get(), real_aspect_ratio, 0.5));
-        GameObject_Handle background(new GameObject (textures[ID(background_id)].get(), 2));
-        GameObject_Handle instruccionesInfo(new GameObject (textures[ID(objetivo_text_id)].get(), real_aspect_ratio, 1.25f));
-
-        //Posicionamos los objetos
-        logo_object-> set_position({(canvas_width * 0.5f), (canvas_height - (logo_object  -> get_height() * 0.5f))});
-        play_button_object-> set_position({(canvas_width * 0.5f), (canvas_height * 0.5f)});
-        instructions_button_object-> set_position({(canvas_width * 0.5f), ((play_button_object -> get_bottom_y()) - 10 - (instructions_button_object -> get_height() * 0.5f))});
-        background-> set_position({(canvas_width * 0.5f), (canvas_height * 0.5f)});
-        background->set_sullScreen();
-        instruccionesInfo-> set_position({(canvas_width * 0.5f), (canvas_height * 0.5f)});
+        // Se crean y colocan los objetos de la escena (la disposición se comparte con el benchmark de render)
+        Menu_Objects menu = create_menu_objects(entities, textures, canvas_width, canvas_height, real_aspect_ratio);
 
 		//Gamoebject que se van a usar
-        objects.push_back(background);
-        objects.push_back(play_button_object);
-        objects.push_back(logo_object);
-        objects.push_back(instructions_button_object);
-        objects.push_back(instruccionesInfo);
+        objects.push_back(menu.background);
+        objects.push_back(menu.play_button);
+        objects.push_back(menu.logo);
+        objects.push_back(menu.instructions_button);
+        objects.push_back(menu.instructions_text);
 
         //Inizialiamos los punteros
-        play_button_pointer         = play_button_object .get();
-        instructions_button_pointer = instructions_button_object.get();
-        logo_pointer                = logo_object.get();
-        instructions_text_pointer = instruccionesInfo.get();
+        play_button_pointer         = menu.play_button.get();
+        instructions_button_pointer = menu.instructions_button.get();
+        logo_pointer                = menu.logo.get();
+        instructions_text_pointer   = menu.instructions_text.get();
 
-        //Ocultamos las instrucciones
-        instructions_text_pointer->hide();
+        //La camara empieza mostrando todo el canvas
+        camera.set_viewport({ float(canvas_width), float(canvas_height) });
+        camera.set_position({ canvas_width * 0.5f, canvas_height * 0.5f });
+
+        //Registramos los botones en el indice espacial
+        hit_grid.resize({ 0.f, 0.f }, { float(canvas_width), float(canvas_height) });
+        hit_grid.add(entities, play_button_pointer->get_handle());
+        hit_grid.add(entities, instructions_button_pointer->get_handle());
 
 
     }
@@ -252,10 +230,8 @@ namespace project_template
     {
         // Se actualiza el estado de todos los gameobjects:
 
-        for (auto & obj : objects)
-        {
-            obj->update (time);
-        }
+        entities.move (time);
+        hit_grid.synchronize (entities);
 
 
     }
@@ -265,10 +241,8 @@ namespace project_template
 
     void Menu_Scene::render_playfield (Canvas & canvas)
     {
-        for (auto & obj : objects)
-        {
-            obj->render (canvas);
-        }
+        camera.apply (canvas);
+        entities.render (canvas, camera.get_visible_bounds ());
     }
 
 
@@ -15,13 +15,16 @@
 #include <list>
 #include <memory>
 
+#include <basics/Camera>
 #include <basics/Canvas>
 #include <basics/Id>
 #include <basics/Scene>
+#include <basics/Spatial_Grid>
 #include <basics/Texture_2D>
 #include <basics/Timer>
 
 #include "GameObject.hpp"
+#include "Menu_Layout.hpp"
 
 namespace project_template {
 
@@ -33,7 +36,7 @@ namespace project_template {
     class Menu_Scene : public basics::Scene {
 
         // Estos typedefs pueden ayudar a hacer el código más compacto y claro:
-        typedef std::shared_ptr<GameObject> GameObject_Handle;
+        typedef basics::Pooled< GameObject > GameObject_Handle;
         typedef std::vector<GameObject_Handle> GameObject_List;
         typedef std::shared_ptr<Texture_2D> Texture_Handle;
         typedef std::map<Id, Texture_Handle> Texture_Map;
@@ -46,17 +49,6 @@ namespace project_template {
             ERROR
         };
 
-        //Estructura que almacena informacion de la textura y de la ruta a buscar (Las imagenes)
-        static struct Texture_Data {
-            Id id;
-            const char* path;
-        };
-        //Array que almacena la informacion de las texturas
-        static Texture_Data textures_data[];
-
-        //Numero de texturas en el array de texture_data
-        static unsigned textures_count;
-
     private:
 
         //EStado de la escena
@@ -74,8 +66,14 @@ namespace project_template {
 
         //Punteros a las texturas creadas
         Texture_Map textures;
+        //Almacen con los datos de todos los gameobjects de la escena (debe declararse antes que la lista)
+        basics::Entity_Store entities;
         //Lista de gameobjects que se utilizan en la escena
         GameObject_List objects;
+        //Indice espacial de los botones para saber cual se toca
+        basics::Spatial_Grid hit_grid;
+        //Camara con la que se ve la escena (solo se dibuja lo que queda dentro de su vista)
+        basics::Camera camera;
 
         Timer timer;
 
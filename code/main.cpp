@@ -11,6 +11,7 @@
 #include <basics/Director>
 #include <basics/enable>
 #include <basics/Graphics_Resource_Cache>
+#include <basics/Texture_2D>
 #include <basics/opengles/Context>
 #include <basics/Window>
 #include "Intro_Scene.hpp"
@@ -27,6 +28,11 @@ int main ()
 
     enable< basics::OpenGL_ES2 > ();
 
+    // El logo de la intro se empieza a decodificar en otro hilo mientras se crean la ventana y el
+    // contexto de OpenGL ES, así la primera imagen sale antes:
+
+    Texture_2D::prefetch ("menu/logo.png");
+
     // Se crea una Game_Scene y se inicia mediante el Director:
 
     director.run_scene (shared_ptr< Scene >(new Intro_Scene));
@@ -34,8 +34,6 @@
             __android_log_write (android_log_priorities[level], tag ? tag : "*", cstring);
         }
 
-        Log log;
-
     }
 
 #endif
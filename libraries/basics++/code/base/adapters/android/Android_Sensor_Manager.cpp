@@ -42,7 +42,7 @@
                 log.d ("SENSORS FOUND:");
                 for (int i = 0; i < total; ++i)
                 {
-                    log.d (std::string("    ") + ASensor_getName (sensor_list[i]));
+                    log.d ("    ", ASensor_getName (sensor_list[i]));
                 }
             }
             ////////////////////////////////////////////////////////////////////////////////////////
@@ -20,6 +20,7 @@
     #include "Native_Activity.hpp"
 
     #include <basics/Log>
+    #include <basics/Startup_Timeline>
     using namespace basics;
 
     using namespace std;
@@ -79,6 +80,8 @@
 
         void Native_Activity::main_thread_function ()
         {
+            startup_timeline.mark ("main thread started");
+
             main ();
 
             lock_guard< mutex > lock(state.mutex);
@@ -95,6 +98,8 @@
             input_thread.looper = ALooper_prepare (ALOOPER_PREPARE_ALLOW_NON_CALLBACKS);
             input_thread.ready  = true;
 
+            startup_timeline.mark ("input thread ready");
+
             // And then notifies the onCreate() callback that the input thread is up and ready:
 
             input_thread.barrier.notify_all ();
@@ -124,6 +129,8 @@
             sensor_thread.ready   = sensor_queue != nullptr;
             sensor_thread.started = true;
 
+            startup_timeline.mark ("sensor thread ready");
+
             // And then notifies the onCreate() callback that the sensor thread is up and ready:
 
             sensor_thread.barrier.notify_all ();
@@ -179,6 +186,8 @@
 
         void Native_Activity::on_create (void * saved_activity_state, size_t saved_state_size)
         {
+            startup_timeline.mark ("activity created");
+
             lock_guard< mutex > lock(state.mutex);
 
             // Initialize the Android configuration object:
@@ -226,6 +235,8 @@
                 unique_lock< mutex > sync (input_thread.mutex);
                 input_thread.barrier.wait (sync);
             }
+
+            startup_timeline.mark ("activity threads started");
         }
 
         // -----------------------------------------------------------------------------------------
@@ -314,6 +325,8 @@
 
         void Native_Activity::on_window_created (ANativeWindow * native_window)
         {
+            startup_timeline.mark ("native window created");
+
             lock_guard< mutex > lock(state.mutex);
 
             if (!window)
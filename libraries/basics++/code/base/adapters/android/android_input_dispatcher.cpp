@@ -16,58 +16,124 @@
 
     #include <basics/Director>
     #include <basics/Id>
+    #include <basics/Touch_Packet>
     #include <android/input.h>
 
     namespace basics { namespace internal
     {
 
+        // The primary pointer is the finger that started the gesture (ACTION_DOWN). Its index
+        // can change when other fingers lift, so it's identified by its pointer id. It's only
+        // accessed from the input thread:
+
+        static int32_t primary_pointer_id = -1;
+
+        static uint8_t get_primary_flag (AInputEvent * android_event, size_t pointer_index)
+        {
+            return AMotionEvent_getPointerId (android_event, pointer_index) == primary_pointer_id ? Touch_Packet::PRIMARY : 0;
+        }
+
+        static void add_pointer_sample (Touch_Packet & touch_packet, AInputEvent * android_event, size_t pointer_index, Touch_Packet::Phase phase)
+        {
+            touch_packet.add
+            (
+                AMotionEvent_getPointerId (android_event, pointer_index),
+                phase,
+                AMotionEvent_getX         (android_event, pointer_index),
+                AMotionEvent_getY         (android_event, pointer_index),
+                AMotionEvent_getEventTime (android_event),
+                get_primary_flag          (android_event, pointer_index)
+            );
+        }
+
         int handle_motion_event (AInputEvent * android_event)
         {
             switch (AInputEvent_getSource (android_event))
             {
                 case AINPUT_SOURCE_TOUCHSCREEN:
                 {
-                    float x = AMotionEvent_getX (android_event, 0);
-                    float y = AMotionEvent_getY (android_event, 0);
+                    // All the pointers and the historical samples batched by the system between two
+                    // move events are gathered into a single packet that is handed to the director:
+
+                    Touch_Packet touch_packet;
 
-                    switch (AKeyEvent_getAction (android_event))
+                    int32_t action        = AMotionEvent_getAction (android_event);
+                    size_t  action_index  = size_t(action & AMOTION_EVENT_ACTION_POINTER_INDEX_MASK) >> AMOTION_EVENT_ACTION_POINTER_INDEX_SHIFT;
+                    size_t  pointer_count = AMotionEvent_getPointerCount (android_event);
+
+                    switch (action & AMOTION_EVENT_ACTION_MASK)
                     {
                         case AMOTION_EVENT_ACTION_DOWN:
                         {
-                            Event event(ID(touch-started));
-
-                            event[ID(x)] = x;
-                            event[ID(y)] = y;
+                            primary_pointer_id = AMotionEvent_getPointerId (android_event, action_index);
 
-                            director.handle (event);
+                            add_pointer_sample (touch_packet, android_event, action_index, Touch_Packet::STARTED);
+                            break;
+                        }
 
+                        case AMOTION_EVENT_ACTION_POINTER_DOWN:
+                        {
+                            add_pointer_sample (touch_packet, android_event, action_index, Touch_Packet::STARTED);
                             break;
                         }
 
                         case AMOTION_EVENT_ACTION_MOVE:
                         {
-                            Event event(ID(touch-moved));
+                            size_t history_size = AMotionEvent_getHistorySize (android_event);
 
-                            event[ID(x)] = x;
-                            event[ID(y)] = y;
+                            for (size_t history_index = 0; history_index < history_size; ++history_index)
+                            {
+                                int64_t timestamp = AMotionEvent_getHistoricalEventTime (android_event, history_index);
+
+                                for (size_t pointer_index = 0; pointer_index < pointer_count; ++pointer_index)
+                                {
+                                    touch_packet.add
+                                    (
+                                        AMotionEvent_getPointerId      (android_event, pointer_index),
+                                        Touch_Packet::MOVED,
+                                        AMotionEvent_getHistoricalX    (android_event, pointer_index, history_index),
+                                        AMotionEvent_getHistoricalY    (android_event, pointer_index, history_index),
+                                        timestamp,
+                                        Touch_Packet::HISTORICAL | get_primary_flag (android_event, pointer_index)
+                                    );
+                                }
+                            }
 
-                            director.handle (event);
+                            for (size_t pointer_index = 0; pointer_index < pointer_count; ++pointer_index)
+                            {
+                                add_pointer_sample (touch_packet, android_event, pointer_index, Touch_Packet::MOVED);
+                            }
 
                             break;
                         }
 
                         case AMOTION_EVENT_ACTION_UP:
                         {
-                            Event event(ID(touch-ended));
+                            add_pointer_sample (touch_packet, android_event, action_index, Touch_Packet::ENDED);
+
+                            primary_pointer_id = -1;
+                            break;
+                        }
 
-                            event[ID(x)] = x;
-                            event[ID(y)] = y;
+                        case AMOTION_EVENT_ACTION_POINTER_UP:
+                        {
+                            add_pointer_sample (touch_packet, android_event, action_index, Touch_Packet::ENDED);
+                            break;
+                        }
 
-                            director.handle (event);
+                        case AMOTION_EVENT_ACTION_CANCEL:
+                        {
+                            for (size_t pointer_index = 0; pointer_index < pointer_count; ++pointer_index)
+                            {
+                                add_pointer_sample (touch_packet, android_event, pointer_index, Touch_Packet::CANCELLED);
+                            }
 
+                            primary_pointer_id = -1;
                             break;
                         }
                     }
+
+                    if (!touch_packet.empty ()) director.handle (touch_packet);
                 }
             }
 
@@ -0,0 +1,220 @@
+/*
+ * ASSET
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802231015
+ */
+
+#include <basics/macros>
+
+#if defined(BASICS_LINUX_OS)
+
+    #include <cstdio>
+    #include <cstdlib>
+    #include <basics/Asset>
+
+    // En Linux los assets son archivos normales. Se buscan en la lista de carpetas separadas por
+    // ':' de la variable de entorno BASICS_ASSET_PATH o, si no está definida, en la que se indique
+    // al compilar con BASICS_LINUX_ASSET_PATH. Si no hay ninguna se buscan en la carpeta actual.
+
+    namespace basics
+    {
+
+        namespace
+        {
+
+            class File_Asset final : public Asset
+            {
+
+                std::FILE * file;
+                size_t      file_size;
+                bool        failed;
+                bool        at_end;
+
+            public:
+
+                File_Asset(const std::string & path) : file(nullptr), file_size(0), at_end(false)
+                {
+                    file   = open_file (path);
+                    failed = file == nullptr;
+
+                    if (file && std::fseek (file, 0, SEEK_END) == 0)
+                    {
+                        long end = std::ftell (file);
+
+                        if (end >= 0) file_size = size_t(end);
+
+                        std::fseek (file, 0, SEEK_SET);
+                    }
+                }
+
+               ~File_Asset()
+                {
+                    if (file) std::fclose (file);
+                }
+
+            public:
+
+                bool good () const override
+                {
+                    return not failed;
+                }
+
+                bool fail () const override
+                {
+                    return failed;
+                }
+
+                bool eof () const override
+                {
+                    return at_end;
+                }
+
+                size_t size () const override
+                {
+                    return good () ? file_size : 0;
+                }
+
+                bool seek (ptrdiff_t offset, Anchor anchor) override
+                {
+                    if (good ())
+                    {
+                        if (std::fseek (file, long(offset), anchor == BEGINNING ? SEEK_SET : anchor == END ? SEEK_END : SEEK_CUR) == 0)
+                        {
+                            at_end = false;
+
+                            return true;
+                        }
+                    }
+
+                    return false;
+                }
+
+                size_t tell () const override
+                {
+                    return good () ? size_t(std::ftell (file)) : 0;
+                }
+
+                byte read () override
+                {
+                    byte data = 0;
+
+                    if (good ())
+                    {
+                        read (&data, 1);
+                    }
+
+                    return data;
+                }
+
+                bool read_all (std::vector< byte > & buffer) override
+                {
+                    if (good () && seek (0, BEGINNING))
+                    {
+                        buffer.resize (file_size);
+
+                        return read (buffer.data (), file_size);
+                    }
+
+                    return false;
+                }
+
+                bool read_all (std::string & buffer) override
+                {
+                    if (good () && seek (0, BEGINNING))
+                    {
+                        buffer.resize (file_size);
+
+                        return read ((uint8_t *)&buffer[0], file_size);
+                    }
+
+                    return false;
+                }
+
+            private:
+
+                bool read (uint8_t * buffer, size_t size)
+                {
+                    if (size > 0)
+                    {
+                        size_t result = std::fread (buffer, 1, size, file);
+
+                        if (result == size) return true;
+
+                        if (std::feof (file)) at_end = true; else failed = true;
+
+                        return false;
+                    }
+
+                    return true;
+                }
+
+                static std::FILE * open_file (const std::string & path)
+                {
+                    const char * roots = std::getenv ("BASICS_ASSET_PATH");
+
+                    #if defined(BASICS_LINUX_ASSET_PATH)
+                        if (!roots) roots = BASICS_LINUX_ASSET_PATH;
+                    #endif
+
+                    if (!roots || !*roots || (!path.empty () && path[0] == '/'))
+                    {
+                        return std::fopen (path.c_str (), "rb");
+                    }
+
+                    // Se prueba cada carpeta de la lista en orden:
+
+                    for (const char * root = roots; ; )
+                    {
+                        const char * separator = root;
+
+                        while (*separator && *separator != ':') ++separator;
+
+                        std::string full_path(root, separator);
+
+                        if (!full_path.empty () && full_path.back () != '/') full_path += '/';
+
+                        std::FILE * file = std::fopen ((full_path + path).c_str (), "rb");
+
+                        if (file) return file;
+
+                        if (*separator == 0) return nullptr;
+
+                        root = separator + 1;
+                    }
+                }
+
+            };
+
+        }
+
+        std::shared_ptr< Asset > Asset::open (const std::string & path)
+        {
+            std::shared_ptr< Asset > asset(new File_Asset(path));
+
+            if (!asset->good ())
+            {
+                 asset.reset ();
+            }
+
+            return asset;
+        }
+
+        bool Asset::exists (const std::string & path)
+        {
+            return File_Asset(path).good ();
+        }
+
+        size_t Asset::size (const std::string & path)
+        {
+            return File_Asset(path).size ();
+        }
+
+    }
+
+#endif
@@ -0,0 +1,31 @@
+/*
+ * LOG
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802181730
+ */
+
+#include <cstdio>
+#include <basics/Log>
+#include <basics/macros>
+
+#if defined(BASICS_LINUX_OS)
+
+    namespace basics
+    {
+
+        void Log::dump (Level level, const char * tag, const char * cstring)
+        {
+            static const char level_letters[] = { 'V', 'D', 'I', 'W', 'E', 'F' };
+
+            std::fprintf (level >= WARNING ? stderr : stdout, "%c/%s: %s\n", level_letters[level], tag ? tag : "*", cstring);
+        }
+
+    }
+
+#endif
@@ -19,6 +19,7 @@
     #include <vector>
     #include <rapidxml.hpp>
     #include <basics/Id>
+    #include <basics/Memory_Tracker>
     #include <basics/Point>
     #include <basics/Size>
     #include <basics/Texture_2D>
@@ -40,6 +41,14 @@
                 float   top;
                 float   width;
                 float   height;
+
+                // Coordenadas de textura normalizadas (entre 0 y 1). Se calculan al añadir el slice
+                // para no tener que dividir por el tamaño de la textura cada vez que se dibuja:
+
+                float   u_left;
+                float   u_right;
+                float   v_bottom;
+                float   v_top;
             };
 
         private:
@@ -58,6 +67,8 @@
             Atlas(const std::string    & path, Graphics_Context::Accessor & context);
             Atlas(const Texture_Handle & texture);
 
+           ~Atlas();
+
         public:
 
             bool good () const
@@ -78,11 +89,13 @@
             }
 
             /**
-             * Añade un nuevo slice al atlas.
+             * Añade un nuevo slice al atlas. El atlas debe tener ya su textura, ya que con su tamaño
+             * se calculan las coordenadas normalizadas del slice.
              * @param id Identificador del nuevo slice. No debe existir algún slice con el mismo id.
              * @param position Coordenadas del vértice inferior izquierdo del slice sobre la textura.
              * @param size Tamaño del slice dentro de la textura.
-             * @return Puntero al slice si no existía otro con el mismo id o nullptr en caso contrario.
+             * @return Puntero al slice si no existía otro con el mismo id y el atlas tiene textura o
+             *         nullptr en caso contrario.
              */
             Slice * add_slice (Id id, const Point2f & position, const Size2f & size);
 
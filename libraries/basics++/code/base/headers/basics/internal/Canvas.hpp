@@ -13,6 +13,7 @@
 #ifndef BASICS_CANVAS_HEADER
 #define BASICS_CANVAS_HEADER
 
+    #include <cstdint>
     #include <basics/Atlas>
     #include <basics/Graphics_Context>
     #include <basics/Point>
@@ -114,6 +115,38 @@
             virtual void fill_rectangle  (const Point2f & where, const Size2f & size, const Atlas::Slice * slice,   int handling = CENTER) { }
             virtual void draw_text       (const Point2f & where, const Text_Layout & text_layout, int handling = TOP | LEFT);
 
+            /**
+             * Rellena count rectángulos con el color y la opacidad actuales. Cada uno se define por
+             * su vértice inferior izquierdo (lefts[i], bottoms[i]) y su tamaño (widths[i], heights[i]).
+             * Las implementaciones que lo permiten lo dibujan todo con una única llamada.
+             */
+            virtual void fill_rectangles
+            (
+                const float        * lefts,
+                const float        * bottoms,
+                const float        * widths,
+                const float        * heights,
+                size_t               count
+            );
+
+            /**
+             * Dibuja count cuadrados centrados en (xs[i], ys[i]) con lado sizes[i], todos con el
+             * mismo slice. Cada color se guarda empaquetado en 32 bits con los componentes R, G, B y
+             * A en ese orden en memoria (0xAABBGGRR leído como entero little endian) y se multiplica
+             * por el color de la textura. colors puede ser nullptr (blanco opaco).
+             * Las implementaciones que lo permiten lo dibujan todo con una única llamada; por
+             * defecto se dibuja cada cuadrado por separado y se ignoran los colores.
+             */
+            virtual void fill_rectangles
+            (
+                const Atlas::Slice * slice,
+                const float        * xs,
+                const float        * ys,
+                const float        * sizes,
+                const uint32_t     * colors,
+                size_t               count
+            );
+
         };
 
     }
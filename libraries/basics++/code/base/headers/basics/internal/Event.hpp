@@ -13,9 +13,10 @@
 #ifndef BASICS_EVENT_HEADER
 #define BASICS_EVENT_HEADER
 
-    #include <map>
+    #include <cstdint>
     #include <basics/fnv>
     #include <basics/Id>
+    #include <basics/Tiny_Map>
     #include <basics/Var>
 
     namespace basics
@@ -25,17 +26,30 @@
         {
         public:
 
-            typedef std::map< Id, Var > Property_List;      // REEMPLAZAR POR UN MAPA "LIGERO"
+            /// Número máximo de propiedades que puede tener un evento. Las propiedades se guardan
+            /// dentro del propio evento para que crearlo, copiarlo o encolarlo no reserve memoria.
+            static constexpr size_t max_property_count = 4;
+
+            typedef Tiny_Map< Id, Var, max_property_count > Property_List;
+
+            /// Prioridades habituales. Event_Queue entrega antes los eventos de mayor prioridad.
+            enum Priority
+            {
+                LOW_PRIORITY    = -1,               ///< Flujos masivos que se pueden retrasar (movimientos, sensores)
+                NORMAL_PRIORITY =  0,
+                HIGH_PRIORITY   =  1,               ///< Eventos de control (pausa, volver atrás...)
+            };
 
         public:
 
             Id            id;
             int           priority;
+            int64_t       timestamp;                ///< Instante en que se originó (ns del reloj monótono) o 0 si se desconoce
             Property_List properties;
 
         public:
 
-            Event(Id id = 0) : id(id), priority(0)
+            Event(Id id = 0, int priority = NORMAL_PRIORITY) : id(id), priority(priority), timestamp(0)
             {
             }
 
@@ -13,68 +13,465 @@
 #ifndef BASICS_EVENT_QUEUE_HEADER
 #define BASICS_EVENT_QUEUE_HEADER
 
-    #include <queue>
-    #include <mutex>
+    #include <atomic>
+    #include <cstdint>
+    #include <memory>
+    #include <utility>
+    #include <basics/assert>
     #include <basics/Event>
+    #include <basics/Latency_Histogram>
+    #include <basics/Memory_Tracker>
+    #include <basics/Non_Copyable>
+    #include <basics/Timer>
 
     namespace basics
     {
 
-        class Event_Queue
+        /**
+         * Cola de eventos acotada y sin bloqueos. Varios hilos pueden encolar eventos a la vez
+         * (por ejemplo, el hilo de entrada y el hilo de la UI), pero solo un hilo debe extraerlos.
+         * Todas las posiciones se reservan al construir la cola, por lo que encolar o extraer un
+         * evento nunca reserva memoria.
+         * Los eventos se reparten en varias bandas según su prioridad (Event::priority). Siempre se
+         * extraen antes los eventos de la banda más prioritaria y, dentro de cada banda, en el mismo
+         * orden en que se encolaron.
+         * Cuando una banda se llena, un nuevo evento puede descartar el evento más antiguo si este
+         * es "coalescible" (por defecto los touch-moved, ya que el siguiente movimiento los
+         * reemplaza). Si no es posible, se descarta el nuevo evento y se contabiliza.
+         */
+        class Event_Queue : Non_Copyable
         {
+        public:
+
+            enum Overflow_Policy
+            {
+                DROP_NEWEST,                    ///< Se descarta el evento que no cabe
+                DROP_OLDEST_COALESCIBLE,        ///< Se descarta el evento más antiguo si es coalescible
+            };
+
+            static constexpr size_t default_capacity = 256;
+
+            /// Número de bandas de prioridad. La banda 0 corresponde a Event::LOW_PRIORITY y la
+            /// última a Event::HIGH_PRIORITY o superior.
+            static constexpr size_t band_count = 3;
+
+            /**
+             * Métricas de una banda. Solo se deben consultar desde el hilo consumidor.
+             */
+            struct Band_Statistics
+            {
+                size_t            depth;                ///< Número aproximado de eventos pendientes
+                size_t            max_depth;            ///< Máximo número de eventos pendientes observado al extraer
+                size_t            polled_count;         ///< Número de eventos extraídos
+                size_t            dropped_count;        ///< Número de eventos descartados por falta de sitio
+                size_t            coalesced_count;      ///< Número de eventos coalescibles descartados
+                Latency_Histogram wait_time;            ///< Tiempo que pasan los eventos en la cola (ns)
+            };
+
+        private:
+
+            // Los contadores de escritura y lectura se separan en distintas líneas de caché para
+            // que productores y consumidor no se invaliden mutuamente:
+
+            static constexpr size_t cache_line_size = 64;
+
+            struct Slot
+            {
+                std::atomic< size_t  > sequence;
+                std::atomic< Id      > event_id;
+                int64_t                enqueue_time;
+                Event                  event;
+            };
+
+            /**
+             * Buffer circular de una banda.
+             */
+            struct Ring
+            {
+                std::unique_ptr< Slot[] > slots;
+                size_t                    capacity;
+                size_t                    mask;
+
+                byte                      padding_0[cache_line_size];
+                std::atomic< size_t >     enqueue_position;
+                byte                      padding_1[cache_line_size - sizeof(std::atomic< size_t >)];
+                std::atomic< size_t >     dequeue_position;
+                byte                      padding_2[cache_line_size - sizeof(std::atomic< size_t >)];
+
+                std::atomic< size_t >     dropped_count;
+                std::atomic< size_t >     coalesced_count;
+
+                // Métricas que solo actualiza el hilo consumidor:
 
-            std::queue< Event > queue;
-            std::mutex          mutex;
+                size_t                    max_depth;
+                size_t                    polled_count;
+                Latency_Histogram         wait_time;
+
+                Ring() : capacity(0), mask(0)
+                {
+                }
+
+                size_t size () const
+                {
+                    size_t enqueued = enqueue_position.load (std::memory_order_relaxed);
+                    size_t dequeued = dequeue_position.load (std::memory_order_relaxed);
+
+                    return enqueued > dequeued ? enqueued - dequeued : 0;
+                }
+            };
+
+            Ring                      rings[band_count];
+            Overflow_Policy           overflow_policy;
+            Id                        coalescible_event_id;
+
+            // Estado privado del hilo consumidor usado por peek():
+
+            Event                     peeked_event;
+            bool                      has_peeked_event;
 
         public:
 
-            void clear ()
+            /**
+             * @param capacity Número de posiciones reservadas en cada banda. Debe ser una potencia de 2.
+             * @param overflow_policy Qué hacer cuando se intenta encolar un evento con la banda llena.
+             * @param coalescible_event_id Id de los eventos que se pueden descartar cuando la banda se llena.
+             */
+            Event_Queue
+            (
+                size_t          capacity             = default_capacity,
+                Overflow_Policy overflow_policy      = DROP_OLDEST_COALESCIBLE,
+                Id              coalescible_event_id = ID(touch-moved)
+            )
+            :
+                overflow_policy     (overflow_policy),
+                coalescible_event_id(coalescible_event_id),
+                has_peeked_event    (false)
+            {
+                assert(capacity > 1 && (capacity & (capacity - 1)) == 0);
+
+                for (Ring & ring : rings)
+                {
+                    ring.slots.reset (new Slot[capacity]);
+
+                    ring.capacity     = capacity;
+                    ring.mask         = capacity - 1;
+                    ring.max_depth    = 0;
+                    ring.polled_count = 0;
+
+                    ring.enqueue_position.store (0, std::memory_order_relaxed);
+                    ring.dequeue_position.store (0, std::memory_order_relaxed);
+                    ring.dropped_count   .store (0, std::memory_order_relaxed);
+                    ring.coalesced_count .store (0, std::memory_order_relaxed);
+
+                    for (size_t index = 0; index < capacity; ++index)
+                    {
+                        ring.slots[index].sequence.store (index, std::memory_order_relaxed);
+                        ring.slots[index].event_id.store (0,     std::memory_order_relaxed);
+                    }
+                }
+
+                memory_tracker.add (Memory_Tracker::EVENTS, get_memory_size ());
+            }
+
+           ~Event_Queue()
             {
-                std::queue< Event >().swap (queue);
+                memory_tracker.remove (Memory_Tracker::EVENTS, get_memory_size ());
             }
 
-            void push (const Event & event)
+        public:
+
+            /**
+             * Descarta todos los eventos pendientes. Solo debe llamarse desde el hilo consumidor o
+             * cuando este todavía no se ha iniciado.
+             */
+            void clear ()
             {
-                std::lock_guard< std::mutex > lock(mutex);
+                Event event;
 
-                queue.push (event);
+                while (poll (event));
             }
 
-            void push (Event && event)
+            bool push (const Event & event)
             {
-                std::lock_guard< std::mutex > lock(mutex);
+                return enqueue (rings[band_of (event)], event);
+            }
 
-                queue.push (event);
+            bool push (Event && event)
+            {
+                Ring & ring = rings[band_of (event)];
+
+                return enqueue (ring, std::move (event));
             }
 
+            /**
+             * Extrae el evento más antiguo de la banda más prioritaria que no esté vacía. Solo la
+             * puede llamar el hilo consumidor.
+             */
             bool poll (Event & event)
             {
-                std::lock_guard< std::mutex > lock(mutex);
-
-                if (queue.size () > 0)
+                if (has_peeked_event)
                 {
-                    event = queue.front ();
-
-                    queue.pop ();
+                    event            = std::move (peeked_event);
+                    has_peeked_event = false;
 
                     return true;
                 }
 
+                for (size_t band = band_count; band-- > 0; )
+                {
+                    if (dequeue (rings[band], event)) return true;
+                }
+
                 return false;
             }
 
+            /**
+             * Extrae en un solo paso hasta max_count eventos pendientes y los guarda en el array
+             * events (normalmente un buffer local del fotograma). Solo la puede llamar el hilo
+             * consumidor.
+             * @return Número de eventos extraídos.
+             */
+            size_t poll (Event * events, size_t max_count)
+            {
+                size_t count = 0;
+
+                while (count < max_count && poll (events[count])) ++count;
+
+                return count;
+            }
+
+            /**
+             * Copia el evento que se extraería a continuación sin extraerlo. Solo la puede llamar
+             * el hilo consumidor.
+             */
             bool peek (Event & event)
             {
-                std::lock_guard< std::mutex > lock(mutex);
+                if (!has_peeked_event)
+                {
+                    has_peeked_event = poll (peeked_event);
+                }
+
+                if (has_peeked_event)
+                {
+                    event = peeked_event;
+                }
+
+                return has_peeked_event;
+            }
+
+        public:
+
+            /**
+             * Retorna la banda en la que se encola un evento según su prioridad.
+             */
+            static size_t band_of (const Event & event)
+            {
+                int band = event.priority - Event::LOW_PRIORITY;
+
+                return band < 0 ? 0 : band >= int(band_count) ? band_count - 1 : size_t(band);
+            }
+
+            /**
+             * Retorna el número aproximado de eventos pendientes.
+             */
+            size_t size () const
+            {
+                size_t total = 0;
+
+                for (const Ring & ring : rings) total += ring.size ();
+
+                return total;
+            }
+
+            size_t get_capacity () const
+            {
+                return rings[0].capacity * band_count;
+            }
+
+            /**
+             * Bytes que ocupan los buffers de todas las bandas.
+             */
+            int64_t get_memory_size () const
+            {
+                return int64_t(get_capacity () * sizeof(Slot));
+            }
+
+            /**
+             * Retorna el número de eventos que se han descartado porque su banda estaba llena.
+             */
+            size_t get_dropped_count () const
+            {
+                size_t total = 0;
+
+                for (const Ring & ring : rings) total += ring.dropped_count.load (std::memory_order_relaxed);
+
+                return total;
+            }
+
+            /**
+             * Retorna el número de eventos coalescibles que se han descartado para hacer sitio a
+             * eventos más recientes.
+             */
+            size_t get_coalesced_count () const
+            {
+                size_t total = 0;
+
+                for (const Ring & ring : rings) total += ring.coalesced_count.load (std::memory_order_relaxed);
+
+                return total;
+            }
+
+            Band_Statistics get_band_statistics (size_t band) const
+            {
+                assert(band < band_count);
+
+                const Ring & ring = rings[band];
+
+                return
+                {
+                    ring.size (),
+                    ring.max_depth,
+                    ring.polled_count,
+                    ring.dropped_count  .load (std::memory_order_relaxed),
+                    ring.coalesced_count.load (std::memory_order_relaxed),
+                    ring.wait_time
+                };
+            }
+
+        private:
+
+            template< typename EVENT >
+            bool enqueue (Ring & ring, EVENT && event)
+            {
+                size_t position = ring.enqueue_position.load (std::memory_order_relaxed);
+
+                for (;;)
+                {
+                    Slot   & slot       = ring.slots[position & ring.mask];
+                    size_t   sequence   = slot.sequence.load (std::memory_order_acquire);
+                    intptr_t difference = intptr_t(sequence) - intptr_t(position);
+
+                    if (difference == 0)
+                    {
+                        // La posición está libre. Se intenta reservar antes que otro productor:
+
+                        if (ring.enqueue_position.compare_exchange_weak (position, position + 1, std::memory_order_relaxed))
+                        {
+                            slot.event        = std::forward< EVENT > (event);
+                            slot.enqueue_time = Timer::get_monotonic_nanoseconds ();
+
+                            // Los eventos que no indican cuándo se originaron se marcan al encolarlos:
+
+                            if (slot.event.timestamp == 0) slot.event.timestamp = slot.enqueue_time;
+
+                            slot.event_id.store (slot.event.id, std::memory_order_relaxed);
+                            slot.sequence.store (position + 1,  std::memory_order_release);
+
+                            return true;
+                        }
+                    }
+                    else
+                    if (difference < 0)
+                    {
+                        // La posición todavía no se ha liberado. Si el consumidor solo está terminando
+                        // de leerla se reintenta. Si la banda está llena se aplica la política:
+
+                        if (position - ring.dequeue_position.load (std::memory_order_acquire) >= ring.capacity)
+                        {
+                            if (!make_room (ring))
+                            {
+                                ring.dropped_count.fetch_add (1, std::memory_order_relaxed);
+
+                                return false;
+                            }
+                        }
+
+                        position = ring.enqueue_position.load (std::memory_order_relaxed);
+                    }
+                    else
+                    {
+                        position = ring.enqueue_position.load (std::memory_order_relaxed);
+                    }
+                }
+            }
+
+            bool dequeue (Ring & ring, Event & event)
+            {
+                size_t position = ring.dequeue_position.load (std::memory_order_relaxed);
+
+                for (;;)
+                {
+                    Slot   & slot       = ring.slots[position & ring.mask];
+                    size_t   sequence   = slot.sequence.load (std::memory_order_acquire);
+                    intptr_t difference = intptr_t(sequence) - intptr_t(position + 1);
+
+                    if (difference == 0)
+                    {
+                        // Los productores también pueden avanzar dequeue_position al descartar el
+                        // evento más antiguo, por lo que la posición se reserva con CAS:
+
+                        if (ring.dequeue_position.compare_exchange_weak (position, position + 1, std::memory_order_relaxed))
+                        {
+                            size_t depth = ring.enqueue_position.load (std::memory_order_relaxed) - position;
+
+                            event = std::move (slot.event);
+
+                            ring.wait_time.record (Timer::get_monotonic_nanoseconds () - slot.enqueue_time);
+
+                            slot.sequence.store (position + ring.capacity, std::memory_order_release);
+
+                            if (depth > ring.max_depth) ring.max_depth = depth;
+
+                            ring.polled_count++;
+
+                            return true;
+                        }
+                    }
+                    else
+                    if (difference < 0)
+                    {
+                        return false;
+                    }
+                    else
+                    {
+                        position = ring.dequeue_position.load (std::memory_order_relaxed);
+                    }
+                }
+            }
+
+            /**
+             * Intenta liberar una posición descartando el evento más antiguo si es coalescible.
+             * @return true si conviene reintentar encolar o false si se debe descartar el nuevo evento.
+             */
+            bool make_room (Ring & ring)
+            {
+                if (overflow_policy != DROP_OLDEST_COALESCIBLE) return false;
 
-                if (queue.size () > 0)
+                size_t position = ring.dequeue_position.load (std::memory_order_relaxed);
+                Slot & slot     = ring.slots[position & ring.mask];
+
+                if (slot.sequence.load (std::memory_order_acquire) != position + 1)
                 {
-                    event = queue.front ();
+                    // El consumidor está leyendo el evento más antiguo, por lo que enseguida habrá sitio:
 
                     return true;
                 }
 
-                return false;
+                if (slot.event_id.load (std::memory_order_relaxed) != coalescible_event_id)
+                {
+                    return false;
+                }
+
+                if (ring.dequeue_position.compare_exchange_strong (position, position + 1, std::memory_order_relaxed))
+                {
+                    // El evento descartado se sobrescribirá cuando algún productor reutilice la posición:
+
+                    slot.sequence.store (position + ring.capacity, std::memory_order_release);
+
+                    ring.coalesced_count.fetch_add (1, std::memory_order_relaxed);
+                }
+
+                return true;
             }
 
         };
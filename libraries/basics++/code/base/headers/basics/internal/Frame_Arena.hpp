@@ -0,0 +1,248 @@
+/*
+ *  FRAME ARENA
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C1802201130
+ */
+
+#ifndef BASICS_FRAME_ARENA_HEADER
+#define BASICS_FRAME_ARENA_HEADER
+
+    #include <cstddef>
+    #include <cstdint>
+    #include <memory>
+    #include <string>
+    #include <vector>
+    #include <basics/Non_Copyable>
+
+    // En las versiones de depuración se rellena con basura la memoria liberada y se comprueba que
+    // no se libere en un fotograma memoria reservada en otro:
+
+    #if !defined(NDEBUG) && !defined(BASICS_FRAME_ARENA_DEBUG)
+        #define BASICS_FRAME_ARENA_DEBUG
+    #endif
+
+    namespace basics
+    {
+
+        /**
+         * Memoria para datos que solo viven durante un fotograma (cadenas y listas temporales que
+         * se crean al dibujar, etc.). Reservar solo avanza un puntero y liberar no hace nada salvo
+         * que se libere lo último que se reservó. Director vacía la arena al terminar cada
+         * fotograma, por lo que nada de lo que se reserve en ella puede guardarse para el siguiente.
+         * No se debe usar desde otros hilos.
+         */
+        class Frame_Arena final : Non_Copyable
+        {
+        public:
+
+            static constexpr size_t default_chunk_size = 64 * 1024;
+            static constexpr size_t default_alignment  = alignof(std::max_align_t);
+
+            #if defined(BASICS_FRAME_ARENA_DEBUG)
+                static constexpr uint8_t poison_byte = 0xDD;
+            #endif
+
+        private:
+
+            struct Chunk
+            {
+                std::unique_ptr< uint8_t[] > memory;
+                size_t                       size;
+            };
+
+            #if defined(BASICS_FRAME_ARENA_DEBUG)
+
+                /**
+                 * Cabecera que precede a cada bloque en depuración para detectar los punteros que
+                 * escapan del fotograma en el que se reservaron.
+                 */
+                struct Header
+                {
+                    uint32_t magic;
+                    uint32_t frame;
+                    size_t   size;
+                };
+
+                static constexpr uint32_t header_magic = 0xF4A3E0A1;
+                static constexpr size_t   header_size  = (sizeof(Header) + default_alignment - 1) & ~(default_alignment - 1);
+
+            #endif
+
+            std::vector< Chunk > chunks;
+            size_t               chunk_size;
+            size_t               current_chunk;         ///< Índice del bloque en el que se reserva.
+            size_t               top;                   ///< Bytes usados del bloque actual.
+            size_t               filled;                ///< Bytes usados de los bloques anteriores al actual.
+            size_t               used_peak;             ///< Máximo de bytes reservados en un fotograma.
+            size_t               capacity;              ///< Suma de los tamaños de los bloques.
+            uint32_t             frame;
+            uint32_t             escaped_count;
+
+        public:
+
+            Frame_Arena(size_t chunk_size = default_chunk_size);
+           ~Frame_Arena();
+
+        public:
+
+            /**
+             * Reserva memoria alineada que se libera sola al llamar a reset().
+             * @param alignment Debe ser potencia de 2.
+             */
+            void * allocate (size_t size, size_t alignment = default_alignment);
+
+            /**
+             * Solo recupera la memoria si es lo último que se reservó (por ejemplo, un vector que
+             * crece justo después de reservarse). En otro caso no hace nada.
+             */
+            void deallocate (void * memory, size_t size);
+
+            /**
+             * Deja la arena vacía para el siguiente fotograma. Los bloques se conservan, pero si en
+             * el fotograma se necesitó más de uno se sustituyen por uno solo con el tamaño total.
+             */
+            void reset ();
+
+            bool owns (const void * memory) const;
+
+        public:
+
+            size_t get_used () const
+            {
+                return filled + top;
+            }
+
+            size_t get_used_peak () const
+            {
+                return used_peak;
+            }
+
+            size_t get_capacity () const
+            {
+                return capacity;
+            }
+
+            uint32_t get_frame () const
+            {
+                return frame;
+            }
+
+            /**
+             * Número de bloques que se liberaron en un fotograma distinto de aquel en el que se
+             * reservaron. Solo se cuentan en depuración.
+             */
+            uint32_t get_escaped_count () const
+            {
+                return escaped_count;
+            }
+
+        private:
+
+            uint8_t * carve     (size_t size, size_t alignment);
+            void      add_chunk (size_t size);
+
+        };
+
+        extern Frame_Arena frame_arena;
+
+        // -----------------------------------------------------------------------------------------
+
+        /**
+         * Allocator para los contenedores de la biblioteca estándar que reserva en una Frame_Arena
+         * (por defecto, en frame_arena). Si se construye con nullptr reserva con new, lo que permite
+         * que un mismo tipo de contenedor sirva para datos temporales y para datos duraderos.
+         */
+        template< typename TYPE >
+        class Frame_Allocator
+        {
+        public:
+
+            typedef TYPE value_type;
+
+            template< typename OTHER_TYPE >
+            struct rebind
+            {
+                typedef Frame_Allocator< OTHER_TYPE > other;
+            };
+
+        private:
+
+            template< typename OTHER_TYPE > friend class Frame_Allocator;
+
+            Frame_Arena * arena;
+
+        public:
+
+            Frame_Allocator() : arena(&frame_arena)
+            {
+            }
+
+            Frame_Allocator(Frame_Arena * arena) : arena(arena)
+            {
+            }
+
+            template< typename OTHER_TYPE >
+            Frame_Allocator(const Frame_Allocator< OTHER_TYPE > & other) : arena(other.arena)
+            {
+            }
+
+            Frame_Arena * get_arena () const
+            {
+                return arena;
+            }
+
+            TYPE * allocate (size_t count)
+            {
+                return arena
+                    ? static_cast< TYPE * >(arena->allocate (count * sizeof(TYPE), alignof(TYPE)))
+                    : std::allocator< TYPE >().allocate (count);
+            }
+
+            void deallocate (TYPE * memory, size_t count)
+            {
+                if (arena) arena->deallocate (memory, count * sizeof(TYPE)); else std::allocator< TYPE >().deallocate (memory, count);
+            }
+
+            template< typename OTHER_TYPE >
+            bool operator == (const Frame_Allocator< OTHER_TYPE > & other) const
+            {
+                return arena == other.arena;
+            }
+
+            template< typename OTHER_TYPE >
+            bool operator != (const Frame_Allocator< OTHER_TYPE > & other) const
+            {
+                return arena != other.arena;
+            }
+
+        };
+
+        /**
+         * Contenedores que reservan en frame_arena:
+         *
+         *     frame::wstring text(L"puntos: ");
+         *     frame::vector< Point2f > points;
+         */
+        namespace frame
+        {
+
+            template< typename TYPE >
+            using vector  = std::vector< TYPE, Frame_Allocator< TYPE > >;
+
+            template< typename CHARACTER >
+            using basic_string = std::basic_string< CHARACTER, std::char_traits< CHARACTER >, Frame_Allocator< CHARACTER > >;
+
+            typedef basic_string< char    > string;
+            typedef basic_string< wchar_t > wstring;
+
+        }
+
+    }
+
+#endif
@@ -0,0 +1,161 @@
+/*
+ *  INPUT LOG
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C1802221210
+ */
+
+#ifndef BASICS_INPUT_LOG_HEADER
+#define BASICS_INPUT_LOG_HEADER
+
+    #include <atomic>
+    #include <cstdint>
+    #include <cstdio>
+    #include <mutex>
+    #include <string>
+    #include <vector>
+    #include <basics/Event>
+    #include <basics/Non_Copyable>
+    #include <basics/Touch_Packet>
+
+    namespace basics
+    {
+
+        /**
+         * Entrada que consume un fotograma junto con el tiempo que se pasa a Scene::update(). Es la
+         * unidad que se graba y se reproduce.
+         */
+        struct Input_Frame
+        {
+            uint32_t             index;
+            float                time;
+            std::vector< Event > application_events;    ///< Eventos de Application (RESUME, SUSPEND...)
+            std::vector< Event > events;                ///< Eventos de la escena, en coordenadas de la superficie
+            Touch_Packet         touches;               ///< Muestras táctiles, en coordenadas de la superficie
+
+            void clear ()
+            {
+                application_events.clear ();
+                events            .clear ();
+                touches           .clear ();
+            }
+        };
+
+        // -----------------------------------------------------------------------------------------
+
+        /**
+         * Graba en un archivo binario compacto la entrada que Director entrega en cada fotograma
+         * (eventos de la aplicación, eventos de la escena y muestras táctiles) y el tiempo con el
+         * que actualiza la escena. Se graba al consumir la entrada y no al recibirla, de modo que
+         * cada bloque del archivo contiene exactamente lo que se entregó en ese fotograma.
+         *
+         * El formato usa el orden de bytes de la máquina que graba.
+         */
+        class Input_Recorder final : Non_Copyable
+        {
+        private:
+
+            std::atomic< bool > recording;
+            std::mutex          mutex;
+            FILE              * file;
+            Input_Frame         frame;              ///< Entrada del fotograma en curso.
+            std::vector< char > buffer;
+
+        public:
+
+            Input_Recorder() : recording(false), file(nullptr)
+            {
+                frame.index = 0;
+                frame.time  = 0.f;
+            }
+
+           ~Input_Recorder()
+            {
+                stop ();
+            }
+
+        public:
+
+            bool start (const std::string & path);
+            void stop  ();
+
+            bool is_recording () const
+            {
+                return recording.load (std::memory_order_relaxed);
+            }
+
+        public:
+
+            void record_application_event (const Event & event)
+            {
+                if (is_recording ()) add (frame.application_events, event);
+            }
+
+            void record_event (const Event & event)
+            {
+                if (is_recording ()) add (frame.events, event);
+            }
+
+            void record_touches (const Touch_Packet & touches)
+            {
+                if (is_recording ()) add (touches);
+            }
+
+            /**
+             * Escribe la entrada grabada desde la llamada anterior como un fotograma que se
+             * actualizó con el tiempo indicado.
+             */
+            void end_frame (float time);
+
+        private:
+
+            void add (std::vector< Event > & list, const Event & event);
+            void add (const Touch_Packet & touches);
+
+        };
+
+        extern Input_Recorder input_recorder;
+
+        // -----------------------------------------------------------------------------------------
+
+        /**
+         * Lee fotograma a fotograma un archivo grabado con Input_Recorder.
+         */
+        class Input_Replayer final : Non_Copyable
+        {
+        private:
+
+            FILE              * file;
+            std::vector< char > buffer;
+
+        public:
+
+            Input_Replayer(const std::string & path);
+           ~Input_Replayer();
+
+        public:
+
+            /**
+             * @return false si no se pudo abrir el archivo o no es un registro de entrada válido.
+             */
+            bool good () const
+            {
+                return file != nullptr;
+            }
+
+            /**
+             * Lee el siguiente fotograma.
+             * @return false al llegar al final o si el archivo está dañado.
+             */
+            bool read_frame (Input_Frame & frame);
+
+        };
+
+    }
+
+#endif
@@ -0,0 +1,131 @@
+/*
+ * LATENCY HISTOGRAM
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802111940
+ */
+
+#ifndef BASICS_LATENCY_HISTOGRAM_HEADER
+#define BASICS_LATENCY_HISTOGRAM_HEADER
+
+    #include <cstdint>
+    #include <basics/types>
+
+    namespace basics
+    {
+
+        /**
+         * Histograma de latencias con intervalos de tamaño fijo. Registrar una medida tiene coste
+         * constante y no reserva memoria, por lo que se puede usar en cada fotograma.
+         * Las latencias se miden en nanosegundos. Las que superan el rango del histograma se
+         * acumulan en el último intervalo.
+         */
+        class Latency_Histogram
+        {
+        public:
+
+            static constexpr size_t  bucket_count = 256;
+            static constexpr int64_t bucket_width = 250000;                 ///< 0.25 ms
+
+        private:
+
+            uint32_t buckets[bucket_count];
+            uint64_t sample_count;
+            int64_t  total;
+            int64_t  maximum;
+
+        public:
+
+            Latency_Histogram()
+            {
+                clear ();
+            }
+
+        public:
+
+            void clear ()
+            {
+                for (auto & bucket : buckets) bucket = 0;
+
+                sample_count = 0;
+                total        = 0;
+                maximum      = 0;
+            }
+
+            void record (int64_t latency)
+            {
+                if (latency < 0) latency = 0;
+
+                size_t index = size_t(latency / bucket_width);
+
+                if (index >= bucket_count) index = bucket_count - 1;
+
+                ++buckets[index];
+                ++sample_count;
+
+                total += latency;
+
+                if (latency > maximum) maximum = latency;
+            }
+
+        public:
+
+            uint64_t get_sample_count () const
+            {
+                return sample_count;
+            }
+
+            int64_t get_maximum () const
+            {
+                return maximum;
+            }
+
+            int64_t get_mean () const
+            {
+                return sample_count > 0 ? total / int64_t(sample_count) : 0;
+            }
+
+            /**
+             * Retorna una estimación del percentil indicado (entre 0 y 100) tomando el límite superior
+             * del intervalo en el que cae.
+             */
+            int64_t get_percentile (float percentile) const
+            {
+                if (sample_count == 0) return 0;
+
+                uint64_t target = uint64_t(double(sample_count) * double(percentile) / 100.0 + 0.5);
+
+                if (target < 1) target = 1;
+
+                uint64_t accumulated = 0;
+
+                for (size_t index = 0; index < bucket_count; ++index)
+                {
+                    accumulated += buckets[index];
+
+                    if (accumulated >= target)
+                    {
+                        int64_t upper_bound = int64_t(index + 1) * bucket_width;
+
+                        return upper_bound < maximum ? upper_bound : maximum;
+                    }
+                }
+
+                return maximum;
+            }
+
+            const uint32_t * get_buckets () const
+            {
+                return buckets;
+            }
+
+        };
+
+    }
+
+#endif
@@ -17,18 +17,49 @@
 // Concurrencia.
 // Formateo de tipos de datos básicos.
 // Desactivación dinámica o estática de diferentes niveles de log.
+//
+// Uso:
+//
+//     log.d ("sensores encontrados: ", count);
+//     log.w ("textura ", path, " de ", width, 'x', height, " no es potencia de 2");
+//
+// Los argumentos se copian sin formatear en un buffer del hilo que escribe y un hilo aparte los
+// formatea y los envía a la salida del sistema y a los canales añadidos. Escribir un mensaje no
+// reserva memoria ni hace llamadas al sistema. Si el buffer del hilo está lleno el mensaje se
+// descarta y se cuenta.
+//
+// Los niveles inferiores a BASICS_LOG_MINIMUM_LEVEL (0 = VERBOSE ... 5 = FATAL) no generan código.
+// Por defecto se compilan todos salvo en release (NDEBUG), donde se eliminan VERBOSE y DEBUG.
 
 #ifndef BASICS_LOG_HEADER
 #define BASICS_LOG_HEADER
 
+    #include <atomic>
+    #include <condition_variable>
+    #include <cstdint>
+    #include <cstdio>
+    #include <cstring>
+    #include <memory>
+    #include <mutex>
     #include <string>
+    #include <thread>
+    #include <type_traits>
+    #include <vector>
+
+    #if !defined(BASICS_LOG_MINIMUM_LEVEL)
+        #if defined(NDEBUG)
+            #define BASICS_LOG_MINIMUM_LEVEL 2
+        #else
+            #define BASICS_LOG_MINIMUM_LEVEL 0
+        #endif
+    #endif
 
     namespace basics
     {
 
         class Log final
         {
-        private:
+        public:
 
             enum Level
             {
@@ -44,14 +75,242 @@
 
         public:
 
-          /*template< typename >
+            /**
+             * Destino adicional de los mensajes ya formateados. Solo se llama desde el hilo que
+             * vuelca los mensajes (o desde Log::flush()), nunca desde varios a la vez.
+             */
             class Channel
             {
             public:
 
-                void dump (Level level, const char * tag, const char * chars);
+                virtual ~Channel() = default;
+
+                virtual void dump  (Level level, const char * tag, const char * chars) = 0;
+                virtual void flush () { }
+
+            };
+
+            /**
+             * Escribe los mensajes en un stream de C ya abierto (por ejemplo, stdout).
+             */
+            class Stream_Channel : public Channel
+            {
+            protected:
+
+                FILE * stream;
+
+            public:
+
+                Stream_Channel(FILE * stream) : stream(stream)
+                {
+                }
+
+                void dump  (Level level, const char * tag, const char * chars) override;
+                void flush () override;
+
+            };
+
+            /**
+             * Escribe los mensajes en un archivo que se crea (o se vacía) al construir el canal.
+             */
+            class File_Channel final : public Stream_Channel
+            {
+            public:
+
+                File_Channel(const std::string & path) : Stream_Channel(std::fopen (path.c_str (), "w"))
+                {
+                }
+
+               ~File_Channel()
+                {
+                    if (stream) std::fclose (stream);
+                }
+
+                bool good () const
+                {
+                    return stream != nullptr;
+                }
 
-            };*/
+            };
+
+        // -----------------------------------------------------------------------------------------
+
+        private:
+
+            static constexpr size_t record_size   = 256;        ///< Bytes por mensaje, incluida la cabecera.
+            static constexpr size_t ring_capacity = 256;        ///< Mensajes pendientes por hilo.
+
+            enum Argument_Type : uint8_t
+            {
+                STRING,
+                SIGNED,
+                UNSIGNED,
+                REAL,
+                BOOLEAN,
+                CHARACTER,
+                POINTER,
+            };
+
+            /**
+             * Mensaje sin formatear: cada argumento se guarda como su tipo seguido de su valor. Las
+             * cadenas se copian (precedidas de su longitud) porque se formatean más tarde.
+             */
+            struct Record
+            {
+                uint8_t  level;
+                bool     truncated;
+                uint16_t size;
+                char     data[record_size - 4];
+            };
+
+            /**
+             * Buffer circular de un hilo. Solo escribe en él su hilo y solo lee el que vuelca los
+             * mensajes, por lo que basta con dos índices atómicos.
+             * Cuando el hilo termina marca el buffer como liberado y, una vez vaciado, pasa a la
+             * lista de buffers libres para que lo reutilice el siguiente hilo que escriba.
+             */
+            struct Ring
+            {
+                std::unique_ptr< Record[] > records;
+                std::atomic< uint32_t >     head;               ///< Siguiente mensaje que escribe el hilo propietario.
+                std::atomic< uint32_t >     tail;               ///< Siguiente mensaje que se vuelca.
+                std::atomic< bool >         released;           ///< Su hilo ha terminado y ya no escribe.
+
+                Ring() : records(new Record[ring_capacity]), head(0), tail(0), released(false)
+                {
+                }
+            };
+
+            /**
+             * Objeto thread_local que marca el buffer de su hilo como liberado al terminar el hilo.
+             */
+            struct Ring_Owner
+            {
+                Ring * ring = nullptr;
+
+               ~Ring_Owner()
+                {
+                    if (ring) ring->released.store (true, std::memory_order_release);
+
+                    ring = nullptr;
+                }
+            };
+
+            class Record_Writer
+            {
+            private:
+
+                Record & record;
+
+            public:
+
+                Record_Writer(Record & record) : record(record)
+                {
+                    record.truncated = false;
+                    record.size      = 0;
+                }
+
+            public:
+
+                void write (const char * chars)
+                {
+                    if (chars) write_string (chars, std::strlen (chars)); else write_string ("(null)", 6);
+                }
+
+                void write (const std::string & string)
+                {
+                    write_string (string.data (), string.size ());
+                }
+
+                void write (bool value)
+                {
+                    write_value (BOOLEAN, &value, sizeof(value));
+                }
+
+                void write (char value)
+                {
+                    write_value (CHARACTER, &value, sizeof(value));
+                }
+
+                template< typename TYPE >
+                typename std::enable_if< std::is_enum< TYPE >::value || (std::is_integral< TYPE >::value && std::is_signed< TYPE >::value) >::type
+                write (TYPE value)
+                {
+                    int64_t converted = int64_t(value);
+
+                    write_value (SIGNED, &converted, sizeof(converted));
+                }
+
+                template< typename TYPE >
+                typename std::enable_if< std::is_integral< TYPE >::value && std::is_unsigned< TYPE >::value >::type
+                write (TYPE value)
+                {
+                    uint64_t converted = uint64_t(value);
+
+                    write_value (UNSIGNED, &converted, sizeof(converted));
+                }
+
+                template< typename TYPE >
+                typename std::enable_if< std::is_floating_point< TYPE >::value >::type
+                write (TYPE value)
+                {
+                    double converted = double(value);
+
+                    write_value (REAL, &converted, sizeof(converted));
+                }
+
+                template< typename TYPE >
+                void write (const TYPE * pointer)
+                {
+                    const void * address = pointer;
+
+                    write_value (POINTER, &address, sizeof(address));
+                }
+
+            private:
+
+                void write_value (Argument_Type type, const void * value, size_t size)
+                {
+                    if (record.size + 1 + size > sizeof(record.data))
+                    {
+                        record.truncated = true;
+                        return;
+                    }
+
+                    record.data[record.size] = char(type);
+
+                    std::memcpy (record.data + record.size + 1, value, size);
+
+                    record.size += uint16_t(1 + size);
+                }
+
+                void write_string (const char * chars, size_t length)
+                {
+                    size_t available = sizeof(record.data) - record.size;
+
+                    if (available < 4)
+                    {
+                        record.truncated = true;
+                        return;
+                    }
+
+                    if (length > available - 3)
+                    {
+                        length = available - 3;
+                        record.truncated = true;
+                    }
+
+                    uint16_t stored_length = uint16_t(length);
+
+                    record.data[record.size] = char(STRING);
+
+                    std::memcpy (record.data + record.size + 1, &stored_length, sizeof(stored_length));
+                    std::memcpy (record.data + record.size + 3, chars, length);
+
+                    record.size += uint16_t(3 + length);
+                }
+
+            };
 
         // -----------------------------------------------------------------------------------------
 
@@ -64,7 +323,6 @@
                 Log &  log;
                 Level  level;
                 bool   is_open;
-              //Buffer buffer;                  // DEBE HABER UN BUFFER POR LEVEL
 
             public:
 
@@ -85,33 +343,18 @@
                     is_open = false;
                 }
 
-                // SOBRECARGAR EL OPERADOR << PARA DIFERENTES TIPOS DE DATOS, IR ACUMULANDO
-                // EN UN BUFFER EL RESULTADO (LLAMANDO A CIERTO MÉTODO) Y TERMINAR CON ENDL.
-
-                // PERMITIR QUE EL OPERADOR () ACEPTE UN NÚMERO VARIABLE DE PARÁMETROS DE TIPOS
-                // DISTINTOS SEPARADOS POR COMAS. TRAS EL ÚLTIMO PARÁMETRO SE ENVÍA A LOG.DUMP.
-
-                Pass_Gate & operator () (const char * message)
+                /**
+                 * Acepta cualquier número de cadenas, números, booleanos, caracteres y punteros,
+                 * que se escriben seguidos formando un único mensaje.
+                 */
+                template< typename ...ARGUMENTS >
+                Pass_Gate & operator () (const ARGUMENTS & ...arguments)
                 {
-                    if (is_open) accept (message);
+                    if (is_open) log.write (level, arguments...);
 
                     return *this;
                 }
 
-                Pass_Gate & operator () (const std::string & message)
-                {
-                    if (is_open) accept (message.c_str ());
-
-                    return *this;
-                }
-
-                // PODRÍA SER CONVENIENTE QUE ESTE MÉTODO NO SEA INLINE PARA QUE EL CÓDIGO MÁQUINA
-                // SEA MÁS COMPACTO Y PARA QUE TENGA MÁS POSIBILIDADES DE RESIDIR EN EL L1 DE CÓDIGO.
-                void accept (const char * message)
-                {
-                    log.dump (level, nullptr, message);
-                }
-
             };
 
         // -----------------------------------------------------------------------------------------
@@ -133,31 +376,46 @@
                 void open  () { }
                 void close () { }
 
-                Null_Gate & operator () (const char        * ) { return *this; }
-                Null_Gate & operator () (const std::string & ) { return *this; }
+                template< typename ...ARGUMENTS >
+                Null_Gate & operator () (const ARGUMENTS & ...) { return *this; }
 
             };
 
+            template< Level LEVEL >
+            using Gate = typename std::conditional< (LEVEL >= BASICS_LOG_MINIMUM_LEVEL), Pass_Gate, Null_Gate >::type;
+
         // -----------------------------------------------------------------------------------------
 
         public:
 
-            // MEDIANTE PREPROCESADO USAR PASS_GATE O NULL_GATE SEGÚN SE QUIERAN ACTIVAR
-            // O DESACTIVAR EN TIEMPO DE COMPILACIÓN. EN MODO RELASE, DESACTIVAR DEBUG Y
-            // VERBOSE POR DEFECTO.
-
-            Pass_Gate v;                        ///< Log gate for verbose messages.
-            Pass_Gate d;                        ///< Log gate for debug messages.
-            Pass_Gate i;                        ///< Log gate for information messages.
-            Pass_Gate w;                        ///< Log gate for warnings.
-            Pass_Gate e;                        ///< Log gate for error messages.
-            Pass_Gate f;                        ///< Log gate for fatal error messages.
+            Gate< VERBOSE > v;                  ///< Log gate for verbose messages.
+            Gate< DEBUG   > d;                  ///< Log gate for debug messages.
+            Gate< INFO    > i;                  ///< Log gate for information messages.
+            Gate< WARNING > w;                  ///< Log gate for warnings.
+            Gate< ERROR   > e;                  ///< Log gate for error messages.
+            Gate< FATAL   > f;                  ///< Log gate for fatal error messages.
 
         // -----------------------------------------------------------------------------------------
 
         private:
 
-            //std::list< Channel? > channels;
+            std::vector< std::unique_ptr< Ring > >    rings;        ///< Los buffers sobreviven a sus hilos.
+            std::vector< Ring * >                     free_rings;   ///< Buffers vaciados de hilos terminados.
+            std::mutex                                rings_mutex;
+
+            std::vector< std::shared_ptr< Channel > > channels;
+            bool                                      system_output;
+            std::mutex                                output_mutex; ///< Solo un hilo vuelca los mensajes a la vez.
+            std::vector< Ring * >                     pending_rings;
+            std::string                               line;
+
+            std::atomic< uint64_t >                   dropped_count;
+            uint64_t                                  reported_drops;
+
+            std::thread                               flusher;
+            std::mutex                                flusher_mutex;
+            std::condition_variable                   flusher_condition;
+            std::atomic< bool >                       stopping;
 
         public:
 
@@ -168,14 +426,86 @@
                 i(*this, INFO   ),
                 w(*this, WARNING),
                 e(*this, ERROR  ),
-                f(*this, FATAL  )
+                f(*this, FATAL  ),
+                system_output (true),
+                dropped_count (0),
+                reported_drops(0),
+                stopping      (false)
             {
             }
 
-        // -----------------------------------------------------------------------------------------
+           ~Log();
+
+        public:
+
+            /**
+             * Añade un canal al que se envían los mensajes además de la salida del sistema.
+             */
+            void add_channel (const std::shared_ptr< Channel > & channel);
+
+            void remove_channels ();
+
+            /**
+             * Activa o desactiva la salida del sistema (logcat en Android, stdout en Linux).
+             */
+            void set_system_output (bool status);
+
+            /**
+             * Vuelca todos los mensajes pendientes antes de retornar. Los mensajes FATAL se vuelcan
+             * así automáticamente.
+             */
+            void flush ();
+
+            /**
+             * Número de mensajes descartados porque el buffer de su hilo estaba lleno.
+             */
+            uint64_t get_dropped_count () const
+            {
+                return dropped_count.load (std::memory_order_relaxed);
+            }
+
+            /**
+             * Número de buffers de hilo creados. Los de los hilos que han terminado se reutilizan,
+             * por lo que no crece con cada hilo nuevo sino con los que escriben a la vez.
+             */
+            size_t get_ring_count ()
+            {
+                std::lock_guard< std::mutex > lock(rings_mutex);
+
+                return rings.size ();
+            }
 
         private:
 
+            template< typename ...ARGUMENTS >
+            void write (Level level, const ARGUMENTS & ...arguments)
+            {
+                Ring   & ring   = get_thread_ring ();
+                Record * record = reserve (ring, level);
+
+                if (record)
+                {
+                    Record_Writer writer(*record);
+
+                    int expansion[] = { 0, (writer.write (arguments), 0)... };
+
+                    (void)expansion;
+
+                    commit (ring, level);
+                }
+            }
+
+            Ring   & get_thread_ring ();
+            Record * reserve (Ring & ring, Level level);
+            void     commit  (Ring & ring, Level level);
+
+            void run_flusher ();
+            void drain       ();
+            void format      (const Record & record, std::string & output);
+
+            /**
+             * Salida del sistema. La implementa cada plataforma.
+             */
             void dump (Level level, const char * tag, const char * cstring);
 
         };
@@ -0,0 +1,233 @@
+/*
+ *  MEMORY TRACKER
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C1802191015
+ */
+
+#ifndef BASICS_MEMORY_TRACKER_HEADER
+#define BASICS_MEMORY_TRACKER_HEADER
+
+    #include <atomic>
+    #include <cstdint>
+    #include <memory>
+    #include <basics/Non_Copyable>
+
+    namespace basics
+    {
+
+        /**
+         * Cuenta los bytes que ocupa cada subsistema y el máximo que han llegado a ocupar. Los
+         * propios subsistemas avisan al reservar y liberar (texturas, fuentes, colas de eventos,
+         * escenas...), por lo que no se mide toda la memoria del proceso sino la que se puede
+         * atribuir a cada uno. Se puede usar desde cualquier hilo.
+         */
+        class Memory_Tracker final : Non_Copyable
+        {
+        public:
+
+            enum Category
+            {
+                TEXTURES_CPU,                   ///< Copias en memoria de los píxeles de las texturas.
+                TEXTURES_GPU,                   ///< Estimación de lo que ocupan las texturas en la GPU.
+                FONTS,                          ///< Tablas de caracteres de las fuentes y slices de los atlas.
+                EVENTS,                         ///< Buffers de las colas de eventos.
+                SCENES,                         ///< Objetos de las escenas.
+                POOLS,                          ///< Bloques de los pools de objetos (usados o libres).
+                FRAME,                          ///< Datos temporales de cada fotograma.
+                CATEGORY_COUNT
+            };
+
+            struct Snapshot
+            {
+                int64_t  current    [CATEGORY_COUNT];
+                int64_t  peak       [CATEGORY_COUNT];
+                uint64_t allocations[CATEGORY_COUNT];     ///< Número de reservas desde el inicio.
+                int64_t  total;
+                int64_t  total_peak;
+            };
+
+        private:
+
+            std::atomic< int64_t  > current    [CATEGORY_COUNT];
+            std::atomic< int64_t  > peak       [CATEGORY_COUNT];
+            std::atomic< uint64_t > allocations[CATEGORY_COUNT];
+            std::atomic< int64_t  > total;
+            std::atomic< int64_t  > total_peak;
+            int64_t                 budget;
+
+        public:
+
+            /**
+             * Es constexpr para que memory_tracker se inicialice a cero en tiempo de compilación,
+             * antes de que se construya cualquier otra variable global que ya pueda anotar memoria
+             * (como la cola de eventos del Director). Su destructor también es trivial.
+             */
+            constexpr Memory_Tracker()
+            :
+                current    {},
+                peak       {},
+                allocations{},
+                total      (0),
+                total_peak (0),
+                budget     (0)
+            {
+            }
+
+        public:
+
+            void add (Category category, int64_t bytes)
+            {
+                raise (current[category], peak[category], bytes);
+                raise (total, total_peak, bytes);
+
+                allocations[category].fetch_add (1, std::memory_order_relaxed);
+            }
+
+            void remove (Category category, int64_t bytes)
+            {
+                current[category].fetch_sub (bytes, std::memory_order_relaxed);
+                total            .fetch_sub (bytes, std::memory_order_relaxed);
+            }
+
+            int64_t get_current (Category category) const
+            {
+                return current[category].load (std::memory_order_relaxed);
+            }
+
+            int64_t get_peak (Category category) const
+            {
+                return peak[category].load (std::memory_order_relaxed);
+            }
+
+            int64_t get_total () const
+            {
+                return total.load (std::memory_order_relaxed);
+            }
+
+            int64_t get_total_peak () const
+            {
+                return total_peak.load (std::memory_order_relaxed);
+            }
+
+            /**
+             * Los máximos pasan a ser los valores actuales (por ejemplo, al cambiar de escena).
+             */
+            void reset_peaks ();
+
+            Snapshot get_snapshot () const;
+
+        public:
+
+            /**
+             * Límite de bytes del total (0 si no hay límite). El HUD de rendimiento lo muestra
+             * junto al total.
+             */
+            void set_budget (int64_t bytes)
+            {
+                budget = bytes;
+            }
+
+            int64_t get_budget () const
+            {
+                return budget;
+            }
+
+            bool is_over_budget () const
+            {
+                return budget > 0 && get_total () > budget;
+            }
+
+        public:
+
+            /**
+             * Escribe en el log las categorías que ocupan más que en la instantánea base. Se
+             * ignoran las categorías indicadas en la máscara (un bit por categoría).
+             * @return Total de bytes de más.
+             */
+            int64_t report_leaks (const Snapshot & baseline, const char * context, unsigned ignored_categories = 0) const;
+
+            static const char * get_name (Category category);
+
+        private:
+
+            static void raise (std::atomic< int64_t > & value, std::atomic< int64_t > & maximum, int64_t bytes)
+            {
+                int64_t updated = value  .fetch_add (bytes, std::memory_order_relaxed) + bytes;
+                int64_t highest = maximum.load      (std::memory_order_relaxed);
+
+                while (updated > highest && !maximum.compare_exchange_weak (highest, updated, std::memory_order_relaxed));
+            }
+
+        };
+
+        extern Memory_Tracker memory_tracker;
+
+        // -----------------------------------------------------------------------------------------
+
+        /**
+         * Allocator para los contenedores de la biblioteca estándar que anota en una categoría
+         * del Memory_Tracker la memoria que reservan:
+         *
+         *     std::vector< Vertex, Tracking_Allocator< Vertex, Memory_Tracker::FRAME > > vertices;
+         */
+        template< typename TYPE, Memory_Tracker::Category CATEGORY >
+        class Tracking_Allocator
+        {
+        public:
+
+            typedef TYPE value_type;
+
+            template< typename OTHER_TYPE >
+            struct rebind
+            {
+                typedef Tracking_Allocator< OTHER_TYPE, CATEGORY > other;
+            };
+
+        public:
+
+            Tracking_Allocator() = default;
+
+            template< typename OTHER_TYPE >
+            Tracking_Allocator(const Tracking_Allocator< OTHER_TYPE, CATEGORY > & )
+            {
+            }
+
+            TYPE * allocate (size_t count)
+            {
+                TYPE * memory = std::allocator< TYPE >().allocate (count);
+
+                memory_tracker.add (CATEGORY, int64_t(count * sizeof(TYPE)));
+
+                return memory;
+            }
+
+            void deallocate (TYPE * memory, size_t count)
+            {
+                memory_tracker.remove (CATEGORY, int64_t(count * sizeof(TYPE)));
+
+                std::allocator< TYPE >().deallocate (memory, count);
+            }
+
+            template< typename OTHER_TYPE >
+            bool operator == (const Tracking_Allocator< OTHER_TYPE, CATEGORY > & ) const
+            {
+                return true;
+            }
+
+            template< typename OTHER_TYPE >
+            bool operator != (const Tracking_Allocator< OTHER_TYPE, CATEGORY > & ) const
+            {
+                return false;
+            }
+
+        };
+
+    }
+
+#endif
@@ -0,0 +1,320 @@
+/*
+ *  OBJECT POOL
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C1802211040
+ */
+
+#ifndef BASICS_OBJECT_POOL_HEADER
+#define BASICS_OBJECT_POOL_HEADER
+
+    #include <cstddef>
+    #include <cstdint>
+    #include <memory>
+    #include <mutex>
+    #include <new>
+    #include <utility>
+    #include <vector>
+    #include <basics/Non_Copyable>
+
+    namespace basics
+    {
+
+        /**
+         * Parte común de los pools, que no depende del tipo de objeto. Reserva los huecos en
+         * bloques contiguos (slabs) y encadena los libres en una lista, de modo que reservar y
+         * liberar solo sacan o meten un hueco en ella. Los bloques no se devuelven al sistema hasta
+         * que se llama a trim() sin objetos vivos o se destruye el pool. Se puede usar desde
+         * cualquier hilo: cada hilo tiene su propia lista de huecos libres de cada pool, que solo
+         * bloquea el mutex del pool cuando se vacía o se llena para pasar huecos en grupo. Un hilo
+         * tiene listas para thread_cache_count pools a la vez; si usa más, los demás reservan y
+         * liberan directamente en la lista compartida.
+         */
+        class Object_Pool_Base : Non_Copyable
+        {
+        public:
+
+            /**
+             * Las reservas y liberaciones de cada hilo se suman al pasar huecos entre el hilo y el
+             * pool, por lo que live, peak y los contadores pueden ir algo por detrás.
+             */
+            struct Statistics
+            {
+                size_t   object_size;               ///< Bytes de cada hueco.
+                size_t   live;                      ///< Objetos en uso.
+                size_t   peak;                      ///< Máximo de objetos en uso a la vez.
+                size_t   capacity;                  ///< Huecos reservados (en uso o libres).
+                size_t   slabs;
+                uint64_t allocations;
+                uint64_t deallocations;
+            };
+
+        private:
+
+            struct Free_Slot
+            {
+                Free_Slot * next;
+            };
+
+            /**
+             * Huecos libres de un pool que tiene un hilo para reservar y liberar sin bloquear.
+             */
+            struct Thread_Cache
+            {
+                uint64_t    pool_serial;            ///< 0 si no es de ningún pool.
+                Free_Slot * slots;
+                size_t      count;
+                uint64_t    allocations;            ///< Aún no sumadas a las estadísticas del pool.
+                uint64_t    deallocations;
+            };
+
+            struct Thread_Cache_Closer;
+
+            static constexpr size_t      thread_cache_count = 16;   ///< Pools con caché a la vez en cada hilo.
+            static constexpr size_t      thread_cache_batch = 32;   ///< Huecos que se pasan de una vez.
+
+            const size_t                 slot_size;
+            const size_t                 slots_per_slab;
+            std::vector< void * >        slabs;
+            Free_Slot                  * free_list;
+            size_t                       free_count;        ///< Huecos en free_list (sin contar los de los hilos).
+            Statistics                   statistics;
+            mutable std::mutex           mutex;
+
+            uint64_t                     serial;            ///< Identifica al pool en las cachés de los hilos.
+            Object_Pool_Base           * next_pool;         ///< Siguiente pool en la lista de todos los pools.
+
+            static Object_Pool_Base    * first_pool;
+            static uint64_t              last_serial;
+            static std::mutex            pools_mutex;
+
+            static thread_local Thread_Cache        thread_caches[thread_cache_count];
+            static thread_local bool                thread_caches_closed;
+            static thread_local Thread_Cache_Closer thread_cache_closer;
+
+        protected:
+
+            Object_Pool_Base(size_t object_size, size_t object_alignment, size_t slots_per_slab);
+
+        public:
+
+            virtual ~Object_Pool_Base();
+
+        public:
+
+            /**
+             * Reserva de antemano huecos para que haya al menos el número indicado.
+             */
+            void reserve (size_t capacity);
+
+            /**
+             * Libera todos los bloques si no queda ningún objeto vivo.
+             * @return true si se liberaron.
+             */
+            bool trim ();
+
+            Statistics get_statistics () const;
+
+        public:
+
+            /**
+             * Estadísticas de todos los pools que existen, incluidos los de Pool_Allocator.
+             */
+            static std::vector< Statistics > get_all_statistics ();
+
+            /**
+             * Escribe en el log las estadísticas de todos los pools.
+             */
+            static void log_statistics ();
+
+        protected:
+
+            void * allocate_slot   ();
+            void   deallocate_slot (void * slot);
+
+            /**
+             * Número de huecos por bloque para que cada bloque ocupe unos 4 KB.
+             */
+            static constexpr size_t get_default_slots_per_slab (size_t object_size)
+            {
+                return object_size * 16 >= 4096 ? 16 : 4096 / object_size;
+            }
+
+        private:
+
+            void add_slab ();
+
+            void update_live ();
+
+            Thread_Cache * get_thread_cache ();
+
+            void fill_thread_cache   (Thread_Cache & cache);
+            void drain_thread_cache  (Thread_Cache & cache, size_t count);
+            void return_thread_cache ();
+
+            static Thread_Cache * reclaim_thread_cache ();
+
+            static void close_thread_cache (Thread_Cache & cache);
+
+        };
+
+        // -----------------------------------------------------------------------------------------
+
+        /**
+         * Pool de objetos de un tipo. Los objetos que se crean seguidos quedan contiguos en memoria.
+         *
+         *     Object_Pool< Particle > pool;
+         *     Particle * particle = pool.create (position, speed);
+         *     ...
+         *     pool.destroy (particle);
+         */
+        template< typename TYPE >
+        class Object_Pool final : public Object_Pool_Base
+        {
+        public:
+
+            /**
+             * Pool compartido por todos los que reservan objetos de este tipo con Pool_Allocator.
+             * No se destruye nunca para que se puedan liberar objetos mientras se destruyen las
+             * variables globales.
+             */
+            static Object_Pool & get_instance ()
+            {
+                static Object_Pool * instance = new Object_Pool;
+
+                return *instance;
+            }
+
+        public:
+
+            Object_Pool(size_t slots_per_slab = get_default_slots_per_slab (sizeof(TYPE)))
+            :
+                Object_Pool_Base(sizeof(TYPE), alignof(TYPE), slots_per_slab)
+            {
+            }
+
+        public:
+
+            TYPE * allocate ()
+            {
+                return static_cast< TYPE * >(allocate_slot ());
+            }
+
+            void deallocate (TYPE * object)
+            {
+                deallocate_slot (object);
+            }
+
+            template< typename ...ARGUMENTS >
+            TYPE * create (ARGUMENTS && ...arguments)
+            {
+                TYPE * object = allocate ();
+
+                try
+                {
+                    return new (object) TYPE(std::forward< ARGUMENTS >(arguments)...);
+                }
+                catch (...)
+                {
+                    deallocate (object);
+                    throw;
+                }
+            }
+
+            void destroy (TYPE * object)
+            {
+                if (object)
+                {
+                    object->~TYPE ();
+
+                    deallocate (object);
+                }
+            }
+
+        };
+
+        // -----------------------------------------------------------------------------------------
+
+        /**
+         * Allocator que reserva cada objeto suelto en el Object_Pool compartido de su tipo. Las
+         * reservas de varios objetos (vectores, etc.) se hacen con new. Sirve para
+         * std::allocate_shared, que lo adapta al tipo del bloque de control, por lo que el objeto y
+         * su contador de referencias quedan juntos en un solo hueco del pool.
+         */
+        template< typename TYPE >
+        class Pool_Allocator
+        {
+        public:
+
+            typedef TYPE value_type;
+
+            template< typename OTHER_TYPE >
+            struct rebind
+            {
+                typedef Pool_Allocator< OTHER_TYPE > other;
+            };
+
+        public:
+
+            Pool_Allocator() = default;
+
+            template< typename OTHER_TYPE >
+            Pool_Allocator(const Pool_Allocator< OTHER_TYPE > & )
+            {
+            }
+
+            TYPE * allocate (size_t count)
+            {
+                return count == 1
+                    ? Object_Pool< TYPE >::get_instance ().allocate ()
+                    : std::allocator< TYPE >().allocate (count);
+            }
+
+            void deallocate (TYPE * memory, size_t count)
+            {
+                if (count == 1)
+                {
+                    Object_Pool< TYPE >::get_instance ().deallocate (memory);
+                }
+                else
+                    std::allocator< TYPE >().deallocate (memory, count);
+            }
+
+            template< typename OTHER_TYPE >
+            bool operator == (const Pool_Allocator< OTHER_TYPE > & ) const
+            {
+                return true;
+            }
+
+            template< typename OTHER_TYPE >
+            bool operator != (const Pool_Allocator< OTHER_TYPE > & ) const
+            {
+                return false;
+            }
+
+        };
+
+        // -----------------------------------------------------------------------------------------
+
+        /**
+         * Handle de un objeto creado en un pool con make_pooled(). Es un std::shared_ptr normal, por
+         * lo que se puede convertir a un handle de una clase base (Texture_2D, Graphics_Resource...)
+         * y pasar a cualquier función que espere un shared_ptr.
+         */
+        template< typename TYPE >
+        using Pooled = std::shared_ptr< TYPE >;
+
+        template< typename TYPE, typename ...ARGUMENTS >
+        inline Pooled< TYPE > make_pooled (ARGUMENTS && ...arguments)
+        {
+            return std::allocate_shared< TYPE > (Pool_Allocator< TYPE >(), std::forward< ARGUMENTS >(arguments)...);
+        }
+
+    }
+
+#endif
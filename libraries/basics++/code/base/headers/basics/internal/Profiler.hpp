@@ -0,0 +1,294 @@
+/*
+ *  PROFILER
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C1802171215
+ */
+
+// Uso:
+//
+//     void My_Scene::update (float time)
+//     {
+//         BASICS_PROFILE_ZONE("My_Scene::update");
+//         ...
+//     }
+//
+// Las zonas solo se registran cuando se compila con BASICS_PROFILER_ENABLED definido (por ejemplo,
+// con -DBASICS_PROFILER_ENABLED en los flags del compilador). En otro caso las macros declaran
+// objetos vacíos que no generan código.
+
+#ifndef BASICS_PROFILER_HEADER
+#define BASICS_PROFILER_HEADER
+
+    #include <cstdint>
+    #include <atomic>
+    #include <memory>
+    #include <mutex>
+    #include <ostream>
+    #include <string>
+    #include <thread>
+    #include <vector>
+    #include <basics/Latency_Histogram>
+    #include <basics/Non_Copyable>
+
+    namespace basics
+    {
+
+        /**
+         * Mide cuánto tardan distintas fases de cada fotograma (zonas) y la duración de los propios
+         * fotogramas.
+         * Cada hilo escribe los inicios y finales de sus zonas en un buffer circular propio, por lo
+         * que registrar una zona no necesita locks ni reserva memoria. Las zonas se pueden anidar.
+         * El contenido de los buffers se puede exportar en el formato JSON de Chrome Tracing, que
+         * también abren chrome://tracing y Perfetto (ui.perfetto.dev).
+         * Las duraciones de los fotogramas se acumulan en un histograma del que se pueden obtener
+         * percentiles y el número de fotogramas que superan el umbral de jank.
+         */
+        class Profiler final : Non_Copyable
+        {
+        public:
+
+            enum Record_Type : uint8_t
+            {
+                BEGIN,
+                END,
+                FRAME,
+                COUNTER,
+            };
+
+            struct Record
+            {
+                const char * name;              ///< Debe apuntar a una cadena estática.
+                int64_t      timestamp;         ///< Nanosegundos del reloj monótono.
+                int64_t      value;             ///< Solo en los registros COUNTER.
+                Record_Type  type;
+                uint8_t      depth;
+            };
+
+            static constexpr size_t ring_capacity = 16384;     ///< Debe ser potencia de 2.
+
+        private:
+
+            /**
+             * Solo escribe en el buffer su hilo. Los demás campos los cambian reset() y la
+             * reutilización del buffer con rings_mutex tomado, sin tocar head.
+             */
+            struct Ring
+            {
+                Record                  records[ring_capacity];
+                std::atomic< uint64_t > head;                   ///< Número total de registros escritos.
+                uint64_t                start;                  ///< Primer registro que se exporta.
+                uint32_t                thread_number;
+                uint8_t                 depth;
+
+                Ring(uint32_t thread_number) : head(0), start(0), thread_number(thread_number), depth(0)
+                {
+                }
+            };
+
+            /**
+             * Objeto thread_local que devuelve el buffer de su hilo a la lista de buffers libres
+             * cuando el hilo termina.
+             */
+            struct Ring_Owner
+            {
+                Ring * ring = nullptr;
+
+               ~Ring_Owner();
+            };
+
+        // -----------------------------------------------------------------------------------------
+
+        private:
+
+            class Pass_Zone final
+            {
+
+                const char * name;
+
+            public:
+
+                Pass_Zone(const char * name) : name(name)
+                {
+                    Profiler::begin_zone (name);
+                }
+
+               ~Pass_Zone()
+                {
+                    Profiler::end_zone (name);
+                }
+
+            };
+
+            // Igual que Log::Null_Gate: misma interfaz que Pass_Zone, sin herencia y con métodos
+            // vacíos para que el compilador no genere código.
+
+            class Null_Zone final
+            {
+            public:
+
+                Null_Zone(const char * )
+                {
+                }
+
+            };
+
+        public:
+
+            #if defined(BASICS_PROFILER_ENABLED)
+                typedef Pass_Zone Zone;
+            #else
+                typedef Null_Zone Zone;
+            #endif
+
+        // -----------------------------------------------------------------------------------------
+
+        private:
+
+            std::vector< std::unique_ptr< Ring > > rings;       ///< Los buffers sobreviven a sus hilos.
+            std::vector< Ring * >                  free_rings;  ///< Buffers de hilos terminados.
+            std::mutex                             rings_mutex;
+            uint32_t                               thread_count;
+
+            Latency_Histogram frame_times;
+            std::thread::id   frame_thread;
+            int64_t           last_frame_timestamp;
+            int64_t           jank_threshold;
+            uint64_t          jank_count;
+
+        public:
+
+            Profiler();
+
+        public:
+
+            /**
+             * Registra el inicio o el final de una zona en el buffer del hilo que lo llama. Se
+             * suelen usar a través de BASICS_PROFILE_ZONE.
+             */
+            static void begin_zone (const char * name);
+            static void end_zone   (const char * name);
+
+            /**
+             * Marca el final de un fotograma y el comienzo del siguiente. Se debe llamar una vez
+             * por fotograma desde el mismo hilo (lo hace Director).
+             */
+            void mark_frame ();
+
+            /**
+             * Registra el valor de un contador (por ejemplo, la memoria en uso de un subsistema).
+             * En Chrome Tracing cada nombre se muestra como una gráfica. Se suele usar a través de
+             * BASICS_PROFILE_COUNTER.
+             */
+            static void record_counter (const char * name, int64_t value);
+
+        public:
+
+            /**
+             * Los fotogramas que duran más que el umbral (en segundos) cuentan como jank. Por
+             * defecto es 1.5 veces la duración de un fotograma a 60 Hz.
+             */
+            void set_jank_threshold (float seconds);
+
+            uint64_t get_frame_count () const
+            {
+                return frame_times.get_sample_count ();
+            }
+
+            uint64_t get_jank_count () const
+            {
+                return jank_count;
+            }
+
+            /**
+             * Duración en segundos del percentil indicado (entre 0 y 100) de los fotogramas medidos.
+             */
+            float get_frame_time_percentile (float percentile) const
+            {
+                return float(frame_times.get_percentile (percentile)) * 1e-9f;
+            }
+
+            float get_mean_frame_time () const
+            {
+                return float(frame_times.get_mean ()) * 1e-9f;
+            }
+
+            float get_maximum_frame_time () const
+            {
+                return float(frame_times.get_maximum ()) * 1e-9f;
+            }
+
+            const Latency_Histogram & get_frame_times () const
+            {
+                return frame_times;
+            }
+
+            /**
+             * Número de buffers de hilo creados (de unos 512 KB cada uno). El buffer de un hilo que
+             * termina pasa al siguiente hilo que empieza a registrar zonas, que descarta lo que
+             * quedase en él.
+             */
+            size_t get_ring_count ()
+            {
+                std::lock_guard< std::mutex > lock(rings_mutex);
+
+                return rings.size ();
+            }
+
+            /**
+             * Descarta las estadísticas de los fotogramas y el contenido de todos los buffers.
+             * Los otros hilos pueden seguir registrando zonas mientras tanto, ya que sus buffers no
+             * se vacían sino que se exporta solo lo que registren después. Las estadísticas de los
+             * fotogramas no están protegidas, por lo que se debe llamar desde el hilo que llama a
+             * mark_frame().
+             */
+            void reset ();
+
+        public:
+
+            /**
+             * Escribe el contenido de los buffers de todos los hilos en formato JSON de Chrome
+             * Tracing. Conviene hacerlo cuando los hilos no están registrando zonas porque los
+             * registros más antiguos de un buffer pueden estar sobrescribiéndose.
+             */
+            void write_chrome_trace (std::ostream & output);
+
+            bool save_chrome_trace  (const std::string & path);
+
+        private:
+
+            static Ring & get_thread_ring ();
+
+            static void push (Ring & ring, const char * name, Record_Type type, uint8_t depth, int64_t timestamp, int64_t value = 0);
+
+        };
+
+        // -----------------------------------------------------------------------------------------
+
+        extern Profiler profiler;
+
+    }
+
+    #define BASICS_PROFILER_CONCATENATE_(A, B) A ## B
+    #define BASICS_PROFILER_CONCATENATE(A, B)  BASICS_PROFILER_CONCATENATE_(A, B)
+
+    /**
+     * Mide el tiempo que transcurre desde la línea en la que se pone hasta el final del ámbito.
+     */
+    #define BASICS_PROFILE_ZONE(NAME) \
+        ::basics::Profiler::Zone BASICS_PROFILER_CONCATENATE(basics_profile_zone_, __LINE__)(NAME)
+
+    #if defined(BASICS_PROFILER_ENABLED)
+        #define BASICS_PROFILE_FRAME() ::basics::profiler.mark_frame ()
+        #define BASICS_PROFILE_COUNTER(NAME, VALUE) ::basics::Profiler::record_counter (NAME, VALUE)
+    #else
+        #define BASICS_PROFILE_FRAME() ((void)0)
+        #define BASICS_PROFILE_COUNTER(NAME, VALUE) ((void)0)
+    #endif
+
+#endif
@@ -56,6 +56,8 @@
 
             Raster_Font(const std::string & path, Graphics_Context::Accessor & context);
 
+           ~Raster_Font();
+
         public:
 
             const Metrics & get_metrics () const
@@ -80,6 +82,8 @@
             bool parse_chars  (rapidxml::xml_node<> *  chars_tag);
             bool parse_char   (rapidxml::xml_node<> *   char_tag);
 
+            int64_t get_character_map_size () const;
+
         };
 
     }
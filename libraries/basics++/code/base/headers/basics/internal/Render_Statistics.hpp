@@ -0,0 +1,44 @@
+/*
+ *  RENDER STATISTICS
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C1802181020
+ */
+
+#ifndef BASICS_RENDER_STATISTICS_HEADER
+#define BASICS_RENDER_STATISTICS_HEADER
+
+    #include <cstdint>
+
+    namespace basics
+    {
+
+        /**
+         * Contadores del trabajo que los renderers envían a la GPU. Los contadores por fotograma
+         * los pone a cero Director antes de que la escena dibuje. Solo se deben modificar desde el
+         * hilo que renderiza.
+         */
+        struct Render_Statistics
+        {
+            uint32_t draw_calls;                ///< Llamadas de dibujado en el fotograma.
+            uint32_t texture_binds;             ///< Texturas enlazadas en el fotograma.
+            uint32_t state_changes;             ///< Cambios de shader y de estado del pipeline en el fotograma.
+
+            void begin_frame ()
+            {
+                draw_calls    = 0;
+                texture_binds = 0;
+                state_changes = 0;
+            }
+        };
+
+        extern Render_Statistics render_statistics;
+
+    }
+
+#endif
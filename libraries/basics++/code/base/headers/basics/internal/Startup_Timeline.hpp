@@ -0,0 +1,149 @@
+/*
+ *  STARTUP TIMELINE
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C1802231230
+ */
+
+// Uso:
+//
+//     startup_timeline.mark ("shaders compiled");
+//
+// Los hitos se registran desde cualquier hilo hasta que el Director presenta el primer fotograma.
+// En ese momento se cierra la línea de tiempo, se escribe en el log y, si se ha indicado una ruta
+// con set_export_path(), se guarda en formato JSON de Chrome Tracing.
+
+#ifndef BASICS_STARTUP_TIMELINE_HEADER
+#define BASICS_STARTUP_TIMELINE_HEADER
+
+    #include <atomic>
+    #include <cstdint>
+    #include <mutex>
+    #include <ostream>
+    #include <string>
+    #include <vector>
+    #include <basics/Non_Copyable>
+
+    namespace basics
+    {
+
+        /**
+         * Registra los hitos del arranque en frío (creación de la actividad y de sus hilos,
+         * inicialización de EGL, compilación de shaders, decodificación de texturas...) con
+         * marcas de tiempo del reloj monótono, desde que se lanzó el proceso hasta que se
+         * presenta el primer fotograma.
+         * El origen es el instante en el que el sistema creó el proceso cuando se puede saber
+         * (Android y Linux). En otro caso es el instante en el que se cargó la biblioteca.
+         */
+        class Startup_Timeline final : Non_Copyable
+        {
+        public:
+
+            struct Milestone
+            {
+                std::string name;
+                int64_t     timestamp;          ///< Nanosegundos del reloj monótono (Timer::get_monotonic_nanoseconds()).
+                uint32_t    thread_number;      ///< 1 para el primer hilo que marca un hito, 2 para el siguiente... (0 en el lanzamiento del proceso).
+            };
+
+            static constexpr size_t max_milestones = 128;
+
+        private:
+
+            mutable std::mutex       mutex;
+            std::vector< Milestone > milestones;
+            int64_t                  origin;            ///< Lanzamiento del proceso o carga de la biblioteca.
+            bool                     origin_is_process;
+            std::atomic< bool >      open;
+            std::string              export_path;
+
+        public:
+
+            Startup_Timeline();
+
+        public:
+
+            /**
+             * Añade un hito con el instante actual. Se ignora una vez cerrada la línea de tiempo o
+             * cuando ya hay max_milestones hitos.
+             */
+            void mark (const std::string & name);
+
+            /**
+             * Permite evitar construir el nombre de un hito cuando ya no se va a registrar.
+             */
+            bool is_open () const
+            {
+                return open.load (std::memory_order_relaxed);
+            }
+
+            /**
+             * Cierra la línea de tiempo, la escribe en el log y la guarda si hay una ruta de
+             * exportación. Solo tiene efecto la primera vez. El Director lo llama tras presentar
+             * el primer fotograma.
+             */
+            void finish ();
+
+            /**
+             * Ruta del archivo en el que finish() guarda la línea de tiempo (vacía para no
+             * guardarla). En Android debe estar en una carpeta en la que la aplicación pueda
+             * escribir.
+             */
+            void set_export_path (const std::string & path)
+            {
+                std::lock_guard< std::mutex > lock(mutex);
+
+                export_path = path;
+            }
+
+        public:
+
+            int64_t get_origin () const
+            {
+                return origin;
+            }
+
+            /**
+             * Indica si el origen es el lanzamiento del proceso o solo la carga de la biblioteca.
+             */
+            bool is_origin_process_start () const
+            {
+                return origin_is_process;
+            }
+
+            std::vector< Milestone > get_milestones () const;
+
+            /**
+             * Segundos transcurridos desde el origen hasta el último hito registrado.
+             */
+            float get_elapsed_seconds () const;
+
+        public:
+
+            /**
+             * Escribe los hitos como eventos instantáneos en formato JSON de Chrome Tracing. Las
+             * marcas de tiempo son las mismas que las del Profiler, por lo que ambos archivos se
+             * pueden abrir juntos en Perfetto.
+             */
+            void write_chrome_trace (std::ostream & output) const;
+
+            bool save_chrome_trace  (const std::string & path) const;
+
+        private:
+
+            static uint32_t get_thread_number ();
+
+            static int64_t  get_process_age ();
+
+        };
+
+        extern Startup_Timeline startup_timeline;
+
+    }
+
+#endif
@@ -15,6 +15,7 @@
 
     #include <string>
     #include <vector>
+    #include <basics/Frame_Arena>
     #include <basics/Raster_Font>
     #include <basics/Point>
     #include <basics/Size>
@@ -39,7 +40,9 @@
                 }
             };
 
-            typedef std::vector< Glyph > Glyph_List;
+            /// Los glifos se reservan en la arena que se indique al construir el layout o con new
+            /// si no se indica ninguna.
+            typedef std::vector< Glyph, Frame_Allocator< Glyph > > Glyph_List;
 
         private:
 
@@ -49,7 +52,19 @@
 
         public:
 
-            Text_Layout(const Raster_Font & font, const std::wstring & text);
+            /**
+             * Si se da una arena (normalmente &frame_arena), los glifos se reservan en ella y el
+             * layout no debe sobrevivir al fotograma en el que se crea.
+             */
+            Text_Layout(const Raster_Font & font, const wchar_t * text, Frame_Arena * arena = nullptr);
+
+            template< typename TRAITS, typename ALLOCATOR >
+            Text_Layout(const Raster_Font & font, const std::basic_string< wchar_t, TRAITS, ALLOCATOR > & text, Frame_Arena * arena = nullptr)
+            :
+                glyphs(Frame_Allocator< Glyph >(arena))
+            {
+                layout (font, text.data (), text.size ());
+            }
 
         public:
 
@@ -68,6 +83,10 @@
                 return height;
             }
 
+        private:
+
+            void layout (const Raster_Font & font, const wchar_t * text, size_t length);
+
         };
 
     }
@@ -57,6 +57,17 @@
             static std::shared_ptr< Texture_2D > create (Id id, Graphics_Context::Accessor & context, Color_Buffer< Rgba8888 > & color_buffer, const Options & options = {});
             static std::shared_ptr< Texture_2D > create (Id id, Graphics_Context::Accessor & context, const std::string & asset_path, const Options & options = {});
 
+            /**
+             * Empieza a leer y decodificar en otro hilo la imagen de un asset para que la siguiente
+             * llamada a create() con la misma ruta solo tenga que subirla a la GPU (esperando a que
+             * termine la decodificación si hace falta). Sirve para solapar la decodificación con
+             * otros pasos del arranque, como la inicialización de EGL o la compilación de shaders,
+             * que tienen que hacerse en el hilo del contexto gráfico.
+             * La imagen decodificada se guarda hasta que se usa, por lo que solo conviene hacerlo
+             * con texturas que se vayan a crear pronto.
+             */
+            static void prefetch (const std::string & asset_path);
+
         protected:
 
             float width;
@@ -14,6 +14,7 @@
 #define BASICS_TIMER_HEADER
 
     #include <chrono>
+    #include <cstdint>
 
     namespace basics
     {
@@ -69,6 +70,19 @@
                 .count ();
             }
 
+            /**
+             * Retorna el instante actual del reloj monótono en nanosegundos. Es el mismo reloj que usa
+             * Android en las marcas de tiempo de los eventos de entrada, por lo que se pueden restar.
+             */
+            static int64_t get_monotonic_nanoseconds ()
+            {
+                return duration_cast< std::chrono::nanoseconds >
+                (
+                    std::chrono::steady_clock::now ().time_since_epoch ()
+                )
+                .count ();
+            }
+
         /*
             /**
              * Para el cronómetro guardando el valor por el que va
@@ -13,26 +13,47 @@
 #ifndef BASICS_TINY_MAP_HEADER
 #define BASICS_TINY_MAP_HEADER
 
+    #include <new>
+    #include <type_traits>
+    #include <utility>
     #include <basics/types>
     #include <basics/assert>
 
     namespace basics
     {
 
+        /**
+         * Escribe en el log que se ha superado la capacidad de un Tiny_Map y aborta.
+         */
+        [[noreturn]] void tiny_map_overflow (size_t capacity);
+
+        /**
+         * Mapa de capacidad fija que guarda sus elementos dentro del propio objeto (sin reservar
+         * memoria dinámica) en un array contiguo. Las búsquedas son lineales, lo cual resulta más
+         * rápido que un árbol o una tabla hash cuando el número de elementos es muy pequeño.
+         * Los elementos conservan el orden de inserción.
+         * @tparam KEY Tipo de las claves. Debe poder compararse con ==.
+         * @tparam VALUE Tipo de los valores. Debe ser construible por defecto.
+         * @tparam CAPACITY Número máximo de elementos.
+         */
         template< typename KEY, typename VALUE, size_t CAPACITY >
         class Tiny_Map
         {
+            static_assert(CAPACITY > 0, "basics::Tiny_Map error: CAPACITY can't be 0.");
+
+        public:
+
             typedef KEY   Key;
             typedef VALUE Value;
 
-            static constexpr size_t capacity = CAPACITY;
-
             struct Item
             {
                 Key   key;
-                Value value,
+                Value value;
             };
 
+        private:
+
             template< class ITEM >
             class Iterator_Template
             {
@@ -41,19 +62,20 @@
 
             public:
 
-                Iterator()            : item(nullptr) { }
-                Iterator(Item * item) : item(item   ) { }
-
-                      Value & operator  * ()       { return  item->value; }
-                const Value & operator  * () const { return  item->value; }
+                Iterator_Template()            : item(nullptr) { }
+                Iterator_Template(ITEM * item) : item(item   ) { }
 
-                      Value * operator -> ()       { return &item->value; }
-                const Value * operator -> () const { return &item->value; }
+                ITEM & operator  * () const { return *item; }
+                ITEM * operator -> () const { return  item; }
 
-                operator bool () const
+                Iterator_Template & operator ++ ()
                 {
-                    return item != nullptr;
+                    return ++item, *this;
                 }
+
+                bool operator == (const Iterator_Template & other) const { return this->item == other.item; }
+                bool operator != (const Iterator_Template & other) const { return this->item != other.item; }
+
             };
 
         public:
@@ -63,65 +85,185 @@
 
         private:
 
-            Item   items[capacity];
-            size_t count;
+            // Los items se guardan en memoria sin construir para que crear o copiar un mapa vacío o
+            // con pocos elementos no tenga que construir los CAPACITY valores:
+
+            typedef typename std::aligned_storage< sizeof(Item), alignof(Item) >::type Item_Storage;
+
+            Item_Storage items[CAPACITY];
+            size_t       item_count;
 
         public:
 
-            size_t size () const
+            Tiny_Map() : item_count(0)
+            {
+            }
+
+            Tiny_Map(const Tiny_Map & other) : item_count(0)
+            {
+                for (const Item & item : other) new (slot (item_count++)) Item(item);
+            }
+
+            Tiny_Map(Tiny_Map && other) : item_count(0)
             {
-                return count;
+                for (Item & item : other) new (slot (item_count++)) Item(std::move (item));
             }
 
-            size_t capacity () const
+           ~Tiny_Map()
             {
-                return capacity;
+                clear ();
+            }
+
+            Tiny_Map & operator = (const Tiny_Map & other)
+            {
+                if (this != &other)
+                {
+                    clear ();
+
+                    for (const Item & item : other) new (slot (item_count++)) Item(item);
+                }
+
+                return *this;
+            }
+
+            Tiny_Map & operator = (Tiny_Map && other)
+            {
+                if (this != &other)
+                {
+                    clear ();
+
+                    for (Item & item : other) new (slot (item_count++)) Item(std::move (item));
+                }
+
+                return *this;
             }
 
         public:
 
-            Iterator begin ()
+            static constexpr size_t capacity ()
             {
-                return Iterator(items[0]);
+                return CAPACITY;
             }
 
-            Const_Iterator cbegin () const
+            size_t size () const
             {
-                return Const_Iterator(items[0]);
+                return item_count;
             }
 
-            Iterator end ()
+            bool empty () const
             {
-                return Iterator(items[count]);
+                return item_count == 0;
             }
 
-            Const_Iterator cend () const
+            bool full () const
             {
-                return Const_Iterator(items[count]);
+                return item_count == CAPACITY;
             }
 
         public:
 
+            Iterator       begin  ()       { return       Iterator(slot (0)); }
+            Const_Iterator begin  () const { return Const_Iterator(slot (0)); }
+            Const_Iterator cbegin () const { return Const_Iterator(slot (0)); }
+
+            Iterator       end    ()       { return       Iterator(slot (item_count)); }
+            Const_Iterator end    () const { return Const_Iterator(slot (item_count)); }
+            Const_Iterator cend   () const { return Const_Iterator(slot (item_count)); }
+
+        public:
+
+            Iterator find (const Key & key)
+            {
+                for (size_t index = 0; index < item_count; ++index)
+                {
+                    if (slot (index)->key == key) return Iterator(slot (index));
+                }
+
+                return end ();
+            }
+
+            Const_Iterator find (const Key & key) const
+            {
+                for (size_t index = 0; index < item_count; ++index)
+                {
+                    if (slot (index)->key == key) return Const_Iterator(slot (index));
+                }
+
+                return end ();
+            }
+
+            size_t count (const Key & key) const
+            {
+                return find (key) != end () ? 1 : 0;
+            }
+
+            /**
+             * Retorna una referencia al valor asociado a la clave, añadiendo un valor construido por
+             * defecto si la clave no existía.
+             * Añadir una clave cuando el mapa está lleno termina el programa (en todas las builds)
+             * tras escribir el error en el log.
+             */
             Value & operator [] (const Key & key)
             {
-                for (size_t  index = 0; index < count; ++index)
+                for (size_t index = 0; index < item_count; ++index)
                 {
-                    if (item[index].key == key) return item[index].value;
+                    if (slot (index)->key == key) return slot (index)->value;
                 }
 
-                assert(count < capacity);
+                if (item_count == CAPACITY) tiny_map_overflow (CAPACITY);
 
-                return item[count].key = key, item[count++];
+                return (new (slot (item_count++)) Item{ key, Value() })->value;
             }
 
+            /**
+             * Retorna una referencia al valor asociado a una clave que debe existir.
+             */
             const Value & operator [] (const Key & key) const
             {
-                for (auto & item : items)
+                Const_Iterator item = find (key);
+
+                assert(item != end ());
+
+                return item->value;
+            }
+
+            bool erase (const Key & key)
+            {
+                for (size_t index = 0; index < item_count; ++index)
                 {
-                    if (item.key == key) return item.value;
+                    if (slot (index)->key == key)
+                    {
+                        // Se desplazan los elementos siguientes para conservar el orden de inserción:
+
+                        for (++index; index < item_count; ++index)
+                        {
+                            *slot (index - 1) = std::move (*slot (index));
+                        }
+
+                        slot (--item_count)->~Item ();
+
+                        return true;
+                    }
                 }
 
-                return *reinterpret_cast< Value * >(nullptr);
+                return false;
+            }
+
+            void clear ()
+            {
+                while (item_count > 0) slot (--item_count)->~Item ();
+            }
+
+        private:
+
+            Item * slot (size_t index)
+            {
+                return reinterpret_cast< Item * >(&items[index]);
+            }
+
+            const Item * slot (size_t index) const
+            {
+                return reinterpret_cast< const Item * >(&items[index]);
             }
 
         };
@@ -0,0 +1,269 @@
+/*
+ * TOUCH PACKET
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802101830
+ */
+
+#ifndef BASICS_TOUCH_PACKET_HEADER
+#define BASICS_TOUCH_PACKET_HEADER
+
+    #include <cstdint>
+    #include <basics/Event>
+    #include <basics/Id>
+    #include <basics/types>
+
+    namespace basics
+    {
+
+        /**
+         * Agrupa todas las muestras táctiles recibidas durante un fotograma (de todos los dedos,
+         * incluyendo las muestras históricas que el sistema acumula entre dos eventos de movimiento).
+         * Los datos se guardan como estructura de arrays para que se puedan recorrer o transformar
+         * en bloque sin reservar memoria. Las muestras se mantienen en orden cronológico.
+         * No depende de la plataforma, por lo que se puede rellenar con entrada sintética.
+         */
+        class Touch_Packet
+        {
+        public:
+
+            enum Phase : uint8_t
+            {
+                STARTED,
+                MOVED,
+                ENDED,
+                CANCELLED,
+            };
+
+            enum Flag : uint8_t
+            {
+                HISTORICAL = 1 << 0,            ///< Muestra intermedia anterior a la muestra actual del mismo evento
+                PRIMARY    = 1 << 1,            ///< Muestra del dedo que inició el gesto (el único que se reportaba antes)
+            };
+
+            static constexpr size_t capacity = 128;
+
+        private:
+
+            int32_t pointer_ids[capacity];
+            uint8_t phases     [capacity];
+            uint8_t flags      [capacity];
+            float   xs         [capacity];
+            float   ys         [capacity];
+            int64_t timestamps [capacity];      ///< Nanosegundos de un reloj monótono
+
+            size_t  count;
+            size_t  coalesced_count;
+            size_t  dropped_count;
+
+        public:
+
+            Touch_Packet() : count(0), coalesced_count(0), dropped_count(0)
+            {
+            }
+
+            Touch_Packet(const Touch_Packet & other) : Touch_Packet()
+            {
+                append (other);
+            }
+
+            Touch_Packet & operator = (const Touch_Packet & other)
+            {
+                if (this != &other)
+                {
+                    clear  ();
+                    append (other);
+                }
+
+                return *this;
+            }
+
+        public:
+
+            size_t size () const
+            {
+                return count;
+            }
+
+            bool empty () const
+            {
+                return count == 0;
+            }
+
+            /**
+             * Número de movimientos intermedios que se han fusionado porque el paquete estaba lleno.
+             */
+            size_t get_coalesced_count () const
+            {
+                return coalesced_count;
+            }
+
+            /**
+             * Número de muestras que se han descartado porque el paquete estaba lleno.
+             */
+            size_t get_dropped_count () const
+            {
+                return dropped_count;
+            }
+
+            const int32_t * get_pointer_ids () const { return pointer_ids; }
+            const uint8_t * get_phases      () const { return phases;      }
+            const uint8_t * get_flags       () const { return flags;       }
+            const float   * get_xs          () const { return xs;          }
+            const float   * get_ys          () const { return ys;          }
+            const int64_t * get_timestamps  () const { return timestamps;  }
+
+            int32_t get_pointer_id (size_t index) const { return pointer_ids[index]; }
+            Phase   get_phase      (size_t index) const { return Phase(phases[index]); }
+            float   get_x          (size_t index) const { return xs[index]; }
+            float   get_y          (size_t index) const { return ys[index]; }
+            int64_t get_timestamp  (size_t index) const { return timestamps[index]; }
+
+            bool is_historical (size_t index) const { return (flags[index] & HISTORICAL) != 0; }
+            bool is_primary    (size_t index) const { return (flags[index] & PRIMARY   ) != 0; }
+
+        public:
+
+            void clear ()
+            {
+                count = coalesced_count = dropped_count = 0;
+            }
+
+            /**
+             * Añade una muestra al final del paquete. Si está lleno, un movimiento sustituye al
+             * último movimiento del mismo dedo y un inicio o final de toque desplaza al movimiento
+             * más antiguo, ya que perderlos dejaría al dedo en un estado incoherente.
+             * @return false si la muestra no se ha podido guardar.
+             */
+            bool add (int32_t pointer_id, Phase phase, float x, float y, int64_t timestamp, uint8_t sample_flags = 0)
+            {
+                if (count == capacity)
+                {
+                    if (phase == MOVED)
+                    {
+                        for (size_t index = count; index-- > 0; )
+                        {
+                            if (pointer_ids[index] == pointer_id)
+                            {
+                                if (phases[index] != MOVED) break;
+
+                                xs        [index]  = x;
+                                ys        [index]  = y;
+                                timestamps[index]  = timestamp;
+                                flags     [index]  = sample_flags;
+
+                                return ++coalesced_count, true;
+                            }
+                        }
+                    }
+                    else
+                    {
+                        for (size_t index = 0; index < count; ++index)
+                        {
+                            if (phases[index] == MOVED)
+                            {
+                                remove (index);
+
+                                ++coalesced_count;
+
+                                break;
+                            }
+                        }
+                    }
+
+                    if (count == capacity)
+                    {
+                        return ++dropped_count, false;
+                    }
+                }
+
+                pointer_ids[count] = pointer_id;
+                phases     [count] = uint8_t(phase);
+                flags      [count] = sample_flags;
+                xs         [count] = x;
+                ys         [count] = y;
+                timestamps [count] = timestamp;
+
+                ++count;
+
+                return true;
+            }
+
+            /**
+             * Añade al final todas las muestras de otro paquete.
+             */
+            void append (const Touch_Packet & other)
+            {
+                for (size_t index = 0; index < other.count; ++index)
+                {
+                    add
+                    (
+                        other.pointer_ids[index],
+                        Phase(other.phases[index]),
+                        other.xs         [index],
+                        other.ys         [index],
+                        other.timestamps [index],
+                        other.flags      [index]
+                    );
+                }
+
+                coalesced_count += other.coalesced_count;
+                dropped_count   += other.dropped_count;
+            }
+
+            /**
+             * Convierte en bloque las coordenadas de todas las muestras desde el espacio de la
+             * superficie de la ventana (con el origen arriba) al espacio de la escena (con el origen
+             * abajo).
+             */
+            void rescale (float h_ratio, float v_ratio, float surface_height)
+            {
+                for (size_t index = 0; index < count; ++index)
+                {
+                    xs[index] = xs[index] * h_ratio;
+                    ys[index] = (surface_height - ys[index]) * v_ratio;
+                }
+            }
+
+            /**
+             * Crea el evento touch-started, touch-moved o touch-ended equivalente a una muestra.
+             */
+            Event make_event (size_t index) const
+            {
+                static const Id event_ids[] = { ID(touch-started), ID(touch-moved), ID(touch-ended), ID(touch-ended) };
+
+                Event event(event_ids[phases[index]], phases[index] == MOVED ? Event::LOW_PRIORITY : Event::NORMAL_PRIORITY);
+
+                event.timestamp = timestamps[index];
+
+                event[ID(x)] = xs[index];
+                event[ID(y)] = ys[index];
+
+                return event;
+            }
+
+        private:
+
+            void remove (size_t index)
+            {
+                for (--count; index < count; ++index)
+                {
+                    pointer_ids[index] = pointer_ids[index + 1];
+                    phases     [index] = phases     [index + 1];
+                    flags      [index] = flags      [index + 1];
+                    xs         [index] = xs         [index + 1];
+                    ys         [index] = ys         [index + 1];
+                    timestamps [index] = timestamps [index + 1];
+                }
+            }
+
+        };
+
+    }
+
+#endif
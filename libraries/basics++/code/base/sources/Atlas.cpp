@@ -23,6 +23,17 @@ using namespace rapidxml;
 namespace basics
 {
 
+    namespace
+    {
+
+        // Cada slice ocupa un nodo de std::map: el par id-slice más los enlaces del árbol.
+
+        const size_t slice_node_size = sizeof(std::pair< const Id, Atlas::Slice >) + 4 * sizeof(void *);
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
     Atlas::Atlas(const string & path, Graphics_Context::Accessor & context)
     {
         shared_ptr< Asset > slices_file = Asset::open (path);
@@ -48,18 +59,49 @@ namespace basics
 
     // ---------------------------------------------------------------------------------------------
 
+    Atlas::~Atlas()
+    {
+        memory_tracker.remove (Memory_Tracker::FONTS, int64_t(slices.size () * slice_node_size));
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
     Atlas::Slice * Atlas::add_slice (Id id, const Point2f & position, const Size2f & size)
     {
+        // Las coordenadas normalizadas dependen del tamaño de la textura, por lo que sin ella el
+        // slice se dibujaría con coordenadas en píxeles:
+
+        assert(texture && texture->get_width () > 0.f && texture->get_height () > 0.f);
+
+        if (!texture || texture->get_width () <= 0.f || texture->get_height () <= 0.f)
+        {
+            log.e ("atlas: can't add a slice to an atlas without a texture");
+
+            return nullptr;
+        }
+
         if (slices.count (id) == 0)
         {
+            float left   = position.coordinates.x ();
+            float bottom = position.coordinates.y ();
+            float right  = left   + size.width;
+            float top    = bottom + size.height;
+
+            float horizontal_ratio = 1.f / texture->get_width  ();
+            float   vertical_ratio = 1.f / texture->get_height ();
+
+            memory_tracker.add (Memory_Tracker::FONTS, int64_t(slice_node_size));
+
             return &
             (
                 slices[id] =
                 {
                     this,
-                    position.coordinates.x (), position.coordinates.x () + size.width,
-                    position.coordinates.y (), position.coordinates.y () + size.height,
-                    size.width,                size.height
+                    left,   right,
+                    bottom, top,
+                    size.width, size.height,
+                    left   * horizontal_ratio, right * horizontal_ratio,
+                    bottom *   vertical_ratio, top   *   vertical_ratio
                 }
             );
         };
@@ -69,4 +69,35 @@ namespace basics
         }
     }
 
+    void Canvas::fill_rectangles
+    (
+        const float        * lefts,
+        const float        * bottoms,
+        const float        * widths,
+        const float        * heights,
+        size_t               count
+    )
+    {
+        for (size_t index = 0; index < count; ++index)
+        {
+            fill_rectangle ({ lefts[index], bottoms[index] }, { widths[index], heights[index] });
+        }
+    }
+
+    void Canvas::fill_rectangles
+    (
+        const Atlas::Slice * slice,
+        const float        * xs,
+        const float        * ys,
+        const float        * sizes,
+        const uint32_t     * ,
+        size_t               count
+    )
+    {
+        for (size_t index = 0; index < count; ++index)
+        {
+            fill_rectangle ({ xs[index], ys[index] }, { sizes[index], sizes[index] }, slice, CENTER);
+        }
+    }
+
 }
@@ -0,0 +1,214 @@
+/*
+ * FRAME ARENA
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802201130
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <basics/Frame_Arena>
+#include <basics/Log>
+#include <basics/Memory_Tracker>
+
+namespace basics
+{
+
+    Frame_Arena frame_arena;
+
+    constexpr size_t Frame_Arena::default_chunk_size;
+    constexpr size_t Frame_Arena::default_alignment;
+
+    // ---------------------------------------------------------------------------------------------
+
+    Frame_Arena::Frame_Arena(size_t chunk_size)
+    :
+        chunk_size   (chunk_size),
+        current_chunk(0),
+        top          (0),
+        filled       (0),
+        used_peak    (0),
+        capacity     (0),
+        frame        (0),
+        escaped_count(0)
+    {
+        // El primer bloque se reserva al usarla por primera vez, por lo que una arena que no se
+        // llega a usar no ocupa memoria:
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Frame_Arena::~Frame_Arena()
+    {
+        memory_tracker.remove (Memory_Tracker::FRAME, int64_t(capacity));
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void * Frame_Arena::allocate (size_t size, size_t alignment)
+    {
+        assert(alignment && (alignment & (alignment - 1)) == 0);
+
+        uint8_t * memory = chunks.empty () ? nullptr : carve (size, alignment);
+
+        if (!memory)
+        {
+            // Se pasa a un bloque nuevo en el que quepa con seguridad lo que se pide:
+
+            filled += top;
+
+            #if defined(BASICS_FRAME_ARENA_DEBUG)
+                add_chunk (std::max(chunk_size, size + alignment + header_size));
+            #else
+                add_chunk (std::max(chunk_size, size + alignment));
+            #endif
+
+            current_chunk = chunks.size () - 1;
+            top           = 0;
+            memory        = carve (size, alignment);
+        }
+
+        return memory;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Frame_Arena::deallocate (void * memory, size_t size)
+    {
+        if (!memory) return;
+
+        #if defined(BASICS_FRAME_ARENA_DEBUG)
+
+            // Si no pertenece a ningún bloque, el bloque en el que se reservó ya se liberó al
+            // agrupar los bloques en reset(), por lo que tampoco es de este fotograma:
+
+            const Header * header = owns (memory) ? reinterpret_cast< const Header * >(static_cast< uint8_t * >(memory) - header_size) : nullptr;
+
+            if (!header || header->magic != header_magic || header->frame != frame || header->size != size)
+            {
+                if (++escaped_count == 1)
+                {
+                    log.e ("frame arena: ", size, " bytes at ", memory, " released in frame ", frame, " were not allocated in it");
+                }
+
+                return;
+            }
+
+            std::memset (memory, poison_byte, size);
+
+        #endif
+
+        uint8_t * base = chunks[current_chunk].memory.get ();
+
+        if (static_cast< uint8_t * >(memory) + size == base + top)
+        {
+            #if defined(BASICS_FRAME_ARENA_DEBUG)
+                std::memset (static_cast< uint8_t * >(memory) - header_size, poison_byte, header_size);
+
+                top = size_t(static_cast< uint8_t * >(memory) - header_size - base);
+            #else
+                top = size_t(static_cast< uint8_t * >(memory) - base);
+            #endif
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Frame_Arena::reset ()
+    {
+        used_peak = std::max(used_peak, get_used ());
+
+        if (chunks.size () > 1)
+        {
+            // Si el fotograma no cupo en un bloque, se sustituyen todos por uno que lo contenga para
+            // que en los siguientes fotogramas las reservas sean contiguas:
+
+            size_t total = capacity;
+
+            memory_tracker.remove (Memory_Tracker::FRAME, int64_t(capacity));
+
+            chunks.clear ();
+            capacity = 0;
+
+            add_chunk (total);
+        }
+        else
+        {
+            #if defined(BASICS_FRAME_ARENA_DEBUG)
+                if (!chunks.empty ()) std::memset (chunks[0].memory.get (), poison_byte, top);
+            #endif
+        }
+
+        current_chunk = 0;
+        top           = 0;
+        filled        = 0;
+
+        ++frame;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Frame_Arena::owns (const void * memory) const
+    {
+        const uint8_t * address = static_cast< const uint8_t * >(memory);
+
+        for (auto & chunk : chunks)
+        {
+            if (address >= chunk.memory.get () && address < chunk.memory.get () + chunk.size) return true;
+        }
+
+        return false;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    uint8_t * Frame_Arena::carve (size_t size, size_t alignment)
+    {
+        Chunk   & chunk = chunks[current_chunk];
+        uintptr_t base  = uintptr_t(chunk.memory.get ());
+
+        #if defined(BASICS_FRAME_ARENA_DEBUG)
+            alignment = std::max(alignment, default_alignment);
+
+            uintptr_t start = (base + top + header_size + alignment - 1) & ~uintptr_t(alignment - 1);
+        #else
+            uintptr_t start = (base + top + alignment - 1) & ~uintptr_t(alignment - 1);
+        #endif
+
+        if (start + size > base + chunk.size) return nullptr;
+
+        top = size_t(start + size - base);
+
+        #if defined(BASICS_FRAME_ARENA_DEBUG)
+            Header * header = reinterpret_cast< Header * >(start - header_size);
+
+            header->magic = header_magic;
+            header->frame = frame;
+            header->size  = size;
+        #endif
+
+        return reinterpret_cast< uint8_t * >(start);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Frame_Arena::add_chunk (size_t size)
+    {
+        chunks.push_back (Chunk{ std::unique_ptr< uint8_t[] >(new uint8_t[size]), size });
+
+        #if defined(BASICS_FRAME_ARENA_DEBUG)
+            std::memset (chunks.back ().memory.get (), poison_byte, size);
+        #endif
+
+        capacity += size;
+
+        memory_tracker.add (Memory_Tracker::FRAME, int64_t(size));
+    }
+
+}
@@ -0,0 +1,362 @@
+/*
+ * INPUT LOG
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802221210
+ */
+
+#include <cstring>
+#include <basics/Input_Log>
+#include <basics/Log>
+
+namespace basics
+{
+
+    Input_Recorder input_recorder;
+
+    // ---------------------------------------------------------------------------------------------
+
+    namespace
+    {
+
+        // El archivo empieza con una firma y una versión. Después va un bloque por fotograma,
+        // precedido de su tamaño en bytes:
+        //
+        //   uint32 índice, float tiempo, uint16 eventos de aplicación, uint16 eventos,
+        //   uint16 muestras táctiles, eventos de aplicación, eventos, muestras táctiles
+        //
+        // Evento:          uint32 id, int32 prioridad, int64 timestamp, uint8 número de
+        //                  propiedades y por cada una uint32 clave, uint8 tipo y 4 bytes de valor.
+        // Muestra táctil:  int32 dedo, uint8 fase, uint8 flags, float x, float y, int64 timestamp.
+
+        const char     signature[4] = { 'B', 'I', 'N', 'P' };
+        const uint32_t version      = 1;
+
+        enum Property_Type : uint8_t
+        {
+            VOID_PROPERTY,
+            BOOL_PROPERTY,
+            FLOAT_PROPERTY,
+        };
+
+        template< typename TYPE >
+        void put (std::vector< char > & buffer, const TYPE & value)
+        {
+            const char * bytes = reinterpret_cast< const char * >(&value);
+
+            buffer.insert (buffer.end (), bytes, bytes + sizeof(TYPE));
+        }
+
+        template< typename TYPE >
+        bool get (const char *& cursor, const char * end, TYPE & value)
+        {
+            if (size_t(end - cursor) < sizeof(TYPE)) return false;
+
+            std::memcpy (&value, cursor, sizeof(TYPE));
+
+            cursor += sizeof(TYPE);
+
+            return true;
+        }
+
+        void put_event (std::vector< char > & buffer, const Event & event)
+        {
+            put (buffer, uint32_t(event.id       ));
+            put (buffer,  int32_t(event.priority ));
+            put (buffer,  int64_t(event.timestamp));
+            put (buffer,  uint8_t(event.properties.size ()));
+
+            for (auto & property : event.properties)
+            {
+                Var & value = const_cast< Var & >(property.value);
+
+                put (buffer, uint32_t(property.key));
+
+                if (value.is< var::Bool > ())
+                {
+                    put (buffer, uint8_t(BOOL_PROPERTY));
+                    put (buffer, uint32_t(bool(*value.as< var::Bool > ()) ? 1 : 0));
+                }
+                else if (value.is< var::Float > ())
+                {
+                    put (buffer, uint8_t(FLOAT_PROPERTY));
+                    put (buffer, float(*value.as< var::Float > ()));
+                }
+                else
+                {
+                    put (buffer, uint8_t(VOID_PROPERTY));
+                    put (buffer, uint32_t(0));
+                }
+            }
+        }
+
+        bool get_event (const char *& cursor, const char * end, Event & event)
+        {
+            uint32_t id;
+            int32_t  priority;
+            int64_t  timestamp;
+            uint8_t  property_count;
+
+            if (!get (cursor, end, id) || !get (cursor, end, priority) || !get (cursor, end, timestamp) || !get (cursor, end, property_count))
+            {
+                return false;
+            }
+
+            event           = Event(Id(id), int(priority));
+            event.timestamp = timestamp;
+
+            for (unsigned index = 0; index < property_count; ++index)
+            {
+                uint32_t key;
+                uint8_t  type;
+                char     value[4];
+
+                if (!get (cursor, end, key) || !get (cursor, end, type) || !get (cursor, end, value))
+                {
+                    return false;
+                }
+
+                switch (type)
+                {
+                    case BOOL_PROPERTY:
+                    {
+                        uint32_t boolean;
+
+                        std::memcpy (&boolean, value, sizeof(boolean));
+
+                        event[Id(key)] = boolean != 0;
+                        break;
+                    }
+
+                    case FLOAT_PROPERTY:
+                    {
+                        float real;
+
+                        std::memcpy (&real, value, sizeof(real));
+
+                        event[Id(key)] = real;
+                        break;
+                    }
+
+                    default:
+                    {
+                        event[Id(key)];
+                        break;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Input_Recorder::start (const std::string & path)
+    {
+        stop ();
+
+        std::lock_guard< std::mutex > lock(mutex);
+
+        file = std::fopen (path.c_str (), "wb");
+
+        if (!file)
+        {
+            log.e ("input recorder: can't create ", path);
+
+            return false;
+        }
+
+        std::fwrite (signature, sizeof(signature), 1, file);
+        std::fwrite (&version,  sizeof(version  ), 1, file);
+
+        frame.clear ();
+        frame.index = 0;
+
+        recording = true;
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Input_Recorder::stop ()
+    {
+        std::lock_guard< std::mutex > lock(mutex);
+
+        recording = false;
+
+        if (file)
+        {
+            std::fclose (file);
+
+            file = nullptr;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Input_Recorder::end_frame (float time)
+    {
+        if (!is_recording ()) return;
+
+        std::lock_guard< std::mutex > lock(mutex);
+
+        if (!file) return;
+
+        buffer.clear ();
+
+        put (buffer, uint32_t(0));                  // Tamaño del bloque, se completa al final
+        put (buffer, frame.index);
+        put (buffer, time);
+        put (buffer, uint16_t(frame.application_events.size ()));
+        put (buffer, uint16_t(frame.events            .size ()));
+        put (buffer, uint16_t(frame.touches           .size ()));
+
+        for (auto & event : frame.application_events) put_event (buffer, event);
+        for (auto & event : frame.events            ) put_event (buffer, event);
+
+        for (size_t index = 0, count = frame.touches.size (); index < count; ++index)
+        {
+            put (buffer, int32_t(frame.touches.get_pointer_id (index)));
+            put (buffer, uint8_t(frame.touches.get_phase      (index)));
+            put (buffer, uint8_t(frame.touches.get_flags () [index]));
+            put (buffer, frame.touches.get_x         (index));
+            put (buffer, frame.touches.get_y         (index));
+            put (buffer, frame.touches.get_timestamp (index));
+        }
+
+        uint32_t block_size = uint32_t(buffer.size () - sizeof(uint32_t));
+
+        std::memcpy (buffer.data (), &block_size, sizeof(block_size));
+
+        std::fwrite (buffer.data (), buffer.size (), 1, file);
+
+        frame.clear ();
+        frame.index++;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Input_Recorder::add (std::vector< Event > & list, const Event & event)
+    {
+        std::lock_guard< std::mutex > lock(mutex);
+
+        // Un fotograma guarda como mucho 65535 eventos de cada clase:
+
+        if (list.size () < 0xFFFF) list.push_back (event);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Input_Recorder::add (const Touch_Packet & touches)
+    {
+        std::lock_guard< std::mutex > lock(mutex);
+
+        frame.touches.append (touches);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Input_Replayer::Input_Replayer(const std::string & path)
+    {
+        file = std::fopen (path.c_str (), "rb");
+
+        if (file)
+        {
+            char     file_signature[sizeof(signature)];
+            uint32_t file_version;
+
+            if
+            (
+                std::fread (file_signature, sizeof(file_signature), 1, file) != 1 ||
+                std::fread (&file_version,  sizeof(file_version  ), 1, file) != 1 ||
+                std::memcmp (file_signature, signature, sizeof(signature)) != 0   ||
+                file_version != version
+            )
+            {
+                log.e ("input replayer: ", path, " is not an input log");
+
+                std::fclose (file);
+
+                file = nullptr;
+            }
+        }
+        else
+            log.e ("input replayer: can't open ", path);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Input_Replayer::~Input_Replayer()
+    {
+        if (file) std::fclose (file);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Input_Replayer::read_frame (Input_Frame & frame)
+    {
+        frame.clear ();
+
+        uint32_t block_size;
+
+        if (!file || std::fread (&block_size, sizeof(block_size), 1, file) != 1) return false;
+
+        buffer.resize (block_size);
+
+        if (block_size > 0 && std::fread (buffer.data (), block_size, 1, file) != 1) return false;
+
+        const char * cursor = buffer.data ();
+        const char * end    = cursor + buffer.size ();
+
+        uint16_t application_event_count;
+        uint16_t event_count;
+        uint16_t touch_count;
+
+        if
+        (
+            !get (cursor, end, frame.index) || !get (cursor, end, frame.time) ||
+            !get (cursor, end, application_event_count) || !get (cursor, end, event_count) || !get (cursor, end, touch_count)
+        )
+        {
+            return false;
+        }
+
+        frame.application_events.resize (application_event_count);
+        frame.events            .resize (event_count);
+
+        for (auto & event : frame.application_events) if (!get_event (cursor, end, event)) return false;
+        for (auto & event : frame.events            ) if (!get_event (cursor, end, event)) return false;
+
+        for (unsigned index = 0; index < touch_count; ++index)
+        {
+            int32_t pointer_id;
+            uint8_t phase;
+            uint8_t flags;
+            float   x;
+            float   y;
+            int64_t timestamp;
+
+            if
+            (
+                !get (cursor, end, pointer_id) || !get (cursor, end, phase) || !get (cursor, end, flags) ||
+                !get (cursor, end, x) || !get (cursor, end, y) || !get (cursor, end, timestamp)
+            )
+            {
+                return false;
+            }
+
+            frame.touches.add (pointer_id, Touch_Packet::Phase(phase), x, y, timestamp, flags);
+        }
+
+        return true;
+    }
+
+}
@@ -0,0 +1,366 @@
+/*
+ * LOG
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1712172039
+ */
+
+#include <chrono>
+#include <basics/Log>
+
+namespace basics
+{
+
+    Log log;
+
+    constexpr size_t Log::record_size;
+    constexpr size_t Log::ring_capacity;
+
+    // ---------------------------------------------------------------------------------------------
+
+    namespace
+    {
+
+        const char level_letters[] = { 'V', 'D', 'I', 'W', 'E', 'F' };
+
+        const auto flush_period = std::chrono::milliseconds(10);
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Log::Stream_Channel::dump (Level level, const char * tag, const char * chars)
+    {
+        if (stream) std::fprintf (stream, "%c/%s: %s\n", level_letters[level], tag ? tag : "*", chars);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Log::Stream_Channel::flush ()
+    {
+        if (stream) std::fflush (stream);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Log::~Log()
+    {
+        if (flusher.joinable ())
+        {
+            {
+                std::lock_guard< std::mutex > lock(flusher_mutex);
+
+                stopping = true;
+            }
+
+            flusher_condition.notify_one ();
+            flusher.join ();
+        }
+
+        drain ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Log::add_channel (const std::shared_ptr< Channel > & channel)
+    {
+        std::lock_guard< std::mutex > lock(output_mutex);
+
+        channels.push_back (channel);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Log::remove_channels ()
+    {
+        std::lock_guard< std::mutex > lock(output_mutex);
+
+        channels.clear ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Log::set_system_output (bool status)
+    {
+        std::lock_guard< std::mutex > lock(output_mutex);
+
+        system_output = status;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Log::flush ()
+    {
+        drain ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Log::Ring & Log::get_thread_ring ()
+    {
+        // Cada hilo toma su buffer la primera vez que escribe, reutilizando el de algún hilo que
+        // haya terminado si lo hay. Solo en ese momento se toma el lock. El hilo que vuelca los
+        // mensajes se arranca con el primer mensaje y no al construir el log global, ya que al
+        // construir los objetos estáticos todavía no conviene crear hilos:
+
+        thread_local Ring_Owner owner;
+
+        if (!owner.ring)
+        {
+            std::lock_guard< std::mutex > lock(rings_mutex);
+
+            if (free_rings.empty ())
+            {
+                rings.emplace_back (new Ring);
+
+                owner.ring = rings.back ().get ();
+            }
+            else
+            {
+                owner.ring = free_rings.back ();
+
+                free_rings.pop_back ();
+            }
+
+            if (!flusher.joinable ()) flusher = std::thread(&Log::run_flusher, this);
+        }
+
+        return *owner.ring;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Log::Record * Log::reserve (Ring & ring, Level level)
+    {
+        uint32_t head = ring.head.load (std::memory_order_relaxed);
+
+        if (head - ring.tail.load (std::memory_order_acquire) >= ring_capacity)
+        {
+            dropped_count.fetch_add (1, std::memory_order_relaxed);
+
+            return nullptr;
+        }
+
+        Record & record = ring.records[head % ring_capacity];
+
+        record.level = uint8_t(level);
+
+        return &record;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Log::commit (Ring & ring, Level level)
+    {
+        ring.head.store (ring.head.load (std::memory_order_relaxed) + 1, std::memory_order_release);
+
+        // Un error fatal suele preceder al cierre de la aplicación:
+
+        if (level == FATAL) drain ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Log::run_flusher ()
+    {
+        std::unique_lock< std::mutex > lock(flusher_mutex);
+
+        while (!stopping)
+        {
+            flusher_condition.wait_for (lock, flush_period);
+
+            lock.unlock ();
+
+            drain ();
+
+            lock.lock ();
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Log::drain ()
+    {
+        std::lock_guard< std::mutex > lock(output_mutex);
+
+        {
+            std::lock_guard< std::mutex > lock(rings_mutex);
+
+            pending_rings.clear ();
+
+            for (auto & ring : rings) pending_rings.push_back (ring.get ());
+        }
+
+        bool written  = false;
+        auto released = pending_rings.begin ();
+
+        for (Ring * ring : pending_rings)
+        {
+            // Si el hilo ya había terminado antes de leer head, no quedarán mensajes tras vaciarlo:
+
+            bool     is_released = ring->released.load (std::memory_order_acquire);
+            uint32_t tail        = ring->tail.load (std::memory_order_relaxed);
+            uint32_t head        = ring->head.load (std::memory_order_acquire);
+
+            for ( ; tail != head; ++tail)
+            {
+                const Record & record = ring->records[tail % ring_capacity];
+
+                format (record, line);
+
+                if (system_output) dump (Level(record.level), nullptr, line.c_str ());
+
+                for (auto & channel : channels) channel->dump (Level(record.level), nullptr, line.c_str ());
+
+                ring->tail.store (tail + 1, std::memory_order_release);
+
+                written = true;
+            }
+
+            if (is_released)
+            {
+                ring->released.store (false, std::memory_order_relaxed);
+
+                *released++ = ring;
+            }
+        }
+
+        // Los buffers de los hilos terminados ya están vacíos y pueden pasar a otros hilos:
+
+        if (released != pending_rings.begin ())
+        {
+            std::lock_guard< std::mutex > lock(rings_mutex);
+
+            free_rings.insert (free_rings.end (), pending_rings.begin (), released);
+        }
+
+        uint64_t dropped = dropped_count.load (std::memory_order_relaxed);
+
+        if (dropped != reported_drops)
+        {
+            line  = std::to_string (dropped - reported_drops);
+            line += " log messages dropped";
+
+            if (system_output) dump (WARNING, nullptr, line.c_str ());
+
+            for (auto & channel : channels) channel->dump (WARNING, nullptr, line.c_str ());
+
+            reported_drops = dropped;
+            written        = true;
+        }
+
+        if (written)
+        {
+            for (auto & channel : channels) channel->flush ();
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Log::format (const Record & record, std::string & output)
+    {
+        output.clear ();
+
+        char buffer[32];
+
+        for (size_t offset = 0; offset < record.size; )
+        {
+            const char * value = record.data + offset + 1;
+
+            switch (Argument_Type(record.data[offset]))
+            {
+                case STRING:
+                {
+                    uint16_t length;
+
+                    std::memcpy (&length, value, sizeof(length));
+
+                    output.append (value + sizeof(length), length);
+
+                    offset += 1 + sizeof(length) + length;
+                    continue;
+                }
+
+                case SIGNED:
+                {
+                    int64_t number;
+
+                    std::memcpy (&number, value, sizeof(number));
+                    std::snprintf (buffer, sizeof(buffer), "%lld", (long long)number);
+
+                    offset += 1 + sizeof(number);
+                    break;
+                }
+
+                case UNSIGNED:
+                {
+                    uint64_t number;
+
+                    std::memcpy (&number, value, sizeof(number));
+                    std::snprintf (buffer, sizeof(buffer), "%llu", (unsigned long long)number);
+
+                    offset += 1 + sizeof(number);
+                    break;
+                }
+
+                case REAL:
+                {
+                    double number;
+
+                    std::memcpy (&number, value, sizeof(number));
+                    std::snprintf (buffer, sizeof(buffer), "%g", number);
+
+                    offset += 1 + sizeof(number);
+                    break;
+                }
+
+                case BOOLEAN:
+                {
+                    bool boolean;
+
+                    std::memcpy (&boolean, value, sizeof(boolean));
+                    std::snprintf (buffer, sizeof(buffer), "%s", boolean ? "true" : "false");
+
+                    offset += 1 + sizeof(boolean);
+                    break;
+                }
+
+                case CHARACTER:
+                {
+                    buffer[0] = *value;
+                    buffer[1] = 0;
+
+                    offset += 1 + sizeof(char);
+                    break;
+                }
+
+                case POINTER:
+                {
+                    const void * pointer;
+
+                    std::memcpy (&pointer, value, sizeof(pointer));
+                    std::snprintf (buffer, sizeof(buffer), "%p", pointer);
+
+                    offset += 1 + sizeof(pointer);
+                    break;
+                }
+
+                default:
+                {
+                    offset = record.size;
+                    continue;
+                }
+            }
+
+            output += buffer;
+        }
+
+        if (record.truncated) output += "...";
+    }
+
+}
@@ -0,0 +1,93 @@
+/*
+ * MEMORY TRACKER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802191015
+ */
+
+#include <basics/Log>
+#include <basics/Memory_Tracker>
+
+namespace basics
+{
+
+    Memory_Tracker memory_tracker;
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Memory_Tracker::reset_peaks ()
+    {
+        for (unsigned category = 0; category < CATEGORY_COUNT; ++category)
+        {
+            peak[category].store (current[category].load (std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+
+        total_peak.store (total.load (std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Memory_Tracker::Snapshot Memory_Tracker::get_snapshot () const
+    {
+        Snapshot snapshot;
+
+        for (unsigned category = 0; category < CATEGORY_COUNT; ++category)
+        {
+            snapshot.current    [category] = current    [category].load (std::memory_order_relaxed);
+            snapshot.peak       [category] = peak       [category].load (std::memory_order_relaxed);
+            snapshot.allocations[category] = allocations[category].load (std::memory_order_relaxed);
+        }
+
+        snapshot.total      = total     .load (std::memory_order_relaxed);
+        snapshot.total_peak = total_peak.load (std::memory_order_relaxed);
+
+        return snapshot;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    int64_t Memory_Tracker::report_leaks (const Snapshot & baseline, const char * context, unsigned ignored_categories) const
+    {
+        int64_t leaked = 0;
+
+        for (unsigned category = 0; category < CATEGORY_COUNT; ++category)
+        {
+            if (ignored_categories & (1u << category)) continue;
+
+            int64_t growth = current[category].load (std::memory_order_relaxed) - baseline.current[category];
+
+            if (growth > 0)
+            {
+                log.w (context, ": ", growth, " bytes of ", get_name (Category(category)), " still in use");
+
+                leaked += growth;
+            }
+        }
+
+        return leaked;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    const char * Memory_Tracker::get_name (Category category)
+    {
+        static const char * names[] =
+        {
+            "textures (cpu)",
+            "textures (gpu)",
+            "fonts",
+            "events",
+            "scenes",
+            "pools",
+            "frame",
+        };
+
+        return category < CATEGORY_COUNT ? names[category] : "unknown";
+    }
+
+}
@@ -0,0 +1,467 @@
+/*
+ * OBJECT POOL
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802211040
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <basics/Log>
+#include <basics/Memory_Tracker>
+#include <basics/Object_Pool>
+
+namespace basics
+{
+
+    Object_Pool_Base * Object_Pool_Base::first_pool  = nullptr;
+    uint64_t           Object_Pool_Base::last_serial = 0;
+    std::mutex         Object_Pool_Base::pools_mutex;
+
+    constexpr size_t Object_Pool_Base::thread_cache_count;
+    constexpr size_t Object_Pool_Base::thread_cache_batch;
+
+    // ---------------------------------------------------------------------------------------------
+
+    // Las cachés son trivialmente destructibles para que sigan siendo accesibles mientras se
+    // destruyen las variables globales. Es el closer, que se construye la primera vez que el hilo
+    // usa una caché, el que devuelve sus huecos a los pools al terminar el hilo:
+
+    struct Object_Pool_Base::Thread_Cache_Closer
+    {
+       ~Thread_Cache_Closer()
+        {
+            for (Thread_Cache & cache : thread_caches) close_thread_cache (cache);
+
+            thread_caches_closed = true;
+        }
+    };
+
+    thread_local Object_Pool_Base::Thread_Cache        Object_Pool_Base::thread_caches[thread_cache_count];
+    thread_local bool                                  Object_Pool_Base::thread_caches_closed = false;
+    thread_local Object_Pool_Base::Thread_Cache_Closer Object_Pool_Base::thread_cache_closer;
+
+    // ---------------------------------------------------------------------------------------------
+
+    namespace
+    {
+
+        size_t get_slot_size (size_t object_size, size_t object_alignment)
+        {
+            // Cada hueco debe poder guardar el enlace de la lista de libres y respetar la alineación
+            // del tipo (los bloques vienen alineados por new):
+
+            assert(object_alignment <= alignof(std::max_align_t));
+
+            size_t size = std::max(object_size, sizeof(void *));
+
+            return (size + object_alignment - 1) / object_alignment * object_alignment;
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Object_Pool_Base::Object_Pool_Base(size_t object_size, size_t object_alignment, size_t slots_per_slab)
+    :
+        slot_size     (get_slot_size (object_size, std::max(object_alignment, alignof(Free_Slot)))),
+        slots_per_slab(slots_per_slab > 0 ? slots_per_slab : 1),
+        free_list     (nullptr),
+        free_count    (0),
+        statistics    ()
+    {
+        statistics.object_size = slot_size;
+
+        std::lock_guard< std::mutex > lock(pools_mutex);
+
+        serial     = ++last_serial;
+        next_pool  = first_pool;
+        first_pool = this;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Object_Pool_Base::~Object_Pool_Base()
+    {
+        return_thread_cache ();
+
+        {
+            std::lock_guard< std::mutex > lock(pools_mutex);
+
+            for (Object_Pool_Base ** pool = &first_pool; *pool; pool = &(*pool)->next_pool)
+            {
+                if (*pool == this)
+                {
+                    *pool = next_pool;
+                    break;
+                }
+            }
+        }
+
+        // Los huecos que no han vuelto a la lista son objetos vivos o están en la caché de otro
+        // hilo, que los olvidará sin tocarlos al no encontrar el pool:
+
+        if (free_count < statistics.capacity)
+        {
+            log.w ("object pool of ", slot_size, "-byte objects destroyed with ", statistics.capacity - free_count, " slots in use");
+        }
+
+        for (void * slab : slabs) ::operator delete (slab);
+
+        memory_tracker.remove (Memory_Tracker::POOLS, int64_t(slabs.size () * slots_per_slab * slot_size));
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Object_Pool_Base::reserve (size_t capacity)
+    {
+        std::lock_guard< std::mutex > lock(mutex);
+
+        while (statistics.capacity < capacity) add_slab ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Object_Pool_Base::trim ()
+    {
+        return_thread_cache ();
+
+        std::lock_guard< std::mutex > lock(mutex);
+
+        if (free_count < statistics.capacity) return false;
+
+        for (void * slab : slabs) ::operator delete (slab);
+
+        memory_tracker.remove (Memory_Tracker::POOLS, int64_t(slabs.size () * slots_per_slab * slot_size));
+
+        slabs.clear ();
+
+        free_list           = nullptr;
+        free_count          = 0;
+        statistics.capacity = 0;
+        statistics.slabs    = 0;
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Object_Pool_Base::Statistics Object_Pool_Base::get_statistics () const
+    {
+        std::lock_guard< std::mutex > lock(mutex);
+
+        return statistics;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    std::vector< Object_Pool_Base::Statistics > Object_Pool_Base::get_all_statistics ()
+    {
+        std::vector< Statistics > all;
+
+        std::lock_guard< std::mutex > lock(pools_mutex);
+
+        for (Object_Pool_Base * pool = first_pool; pool; pool = pool->next_pool)
+        {
+            all.push_back (pool->get_statistics ());
+        }
+
+        return all;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Object_Pool_Base::log_statistics ()
+    {
+        for (auto & pool : get_all_statistics ())
+        {
+            log.i
+            (
+                "object pool of ", pool.object_size, "-byte objects: ",
+                pool.live, " alive (peak ", pool.peak, "), ",
+                pool.capacity, " slots in ", pool.slabs, " slabs, ",
+                pool.allocations, " allocations, ", pool.deallocations, " deallocations"
+            );
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void * Object_Pool_Base::allocate_slot ()
+    {
+        Thread_Cache * cache = get_thread_cache ();
+
+        if (cache)
+        {
+            if (!cache->slots) fill_thread_cache (*cache);
+
+            Free_Slot * slot = cache->slots;
+
+            cache->slots = slot->next;
+            cache->count--;
+            cache->allocations++;
+
+            return slot;
+        }
+
+        // El hilo ya ha terminado (se están destruyendo sus variables) o no le quedan cachés:
+
+        std::lock_guard< std::mutex > lock(mutex);
+
+        if (!free_list) add_slab ();
+
+        Free_Slot * slot = free_list;
+
+        free_list = slot->next;
+        free_count--;
+
+        statistics.allocations++;
+
+        update_live ();
+
+        return slot;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Object_Pool_Base::deallocate_slot (void * memory)
+    {
+        if (memory)
+        {
+            Free_Slot    * slot  = static_cast< Free_Slot * >(memory);
+            Thread_Cache * cache = get_thread_cache ();
+
+            if (cache)
+            {
+                // Un hilo que solo libera (porque los objetos se crearon en otro) no debe acumular
+                // huecos sin límite:
+
+                if (cache->count >= 2 * thread_cache_batch) drain_thread_cache (*cache, thread_cache_batch);
+
+                slot->next   = cache->slots;
+                cache->slots = slot;
+                cache->count++;
+                cache->deallocations++;
+
+                return;
+            }
+
+            std::lock_guard< std::mutex > lock(mutex);
+
+            slot->next = free_list;
+            free_list  = slot;
+            free_count++;
+
+            statistics.deallocations++;
+
+            update_live ();
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Object_Pool_Base::add_slab ()
+    {
+        uint8_t * slab = static_cast< uint8_t * >(::operator new (slots_per_slab * slot_size));
+
+        slabs.push_back (slab);
+
+        // Los huecos se encadenan en orden para que los objetos que se reservan seguidos queden
+        // contiguos:
+
+        for (size_t index = slots_per_slab; index-- > 0; )
+        {
+            Free_Slot * slot = reinterpret_cast< Free_Slot * >(slab + index * slot_size);
+
+            slot->next = free_list;
+            free_list  = slot;
+        }
+
+        free_count          += slots_per_slab;
+        statistics.capacity += slots_per_slab;
+        statistics.slabs    += 1;
+
+        memory_tracker.add (Memory_Tracker::POOLS, int64_t(slots_per_slab * slot_size));
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Object_Pool_Base::update_live ()
+    {
+        // Las liberaciones de un hilo se pueden sumar antes que las reservas de otro:
+
+        statistics.live = statistics.allocations > statistics.deallocations
+                        ? size_t(statistics.allocations - statistics.deallocations)
+                        : 0;
+
+        if (statistics.live > statistics.peak) statistics.peak = statistics.live;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Object_Pool_Base::Thread_Cache * Object_Pool_Base::get_thread_cache ()
+    {
+        if (thread_caches_closed) return nullptr;
+
+        // Cada pool ocupa la primera caché libre a partir de la que le corresponde por su número
+        // de serie, por lo que casi siempre se encuentra a la primera. Dos pools que comparten
+        // posición no se quitan la caché el uno al otro:
+
+        Thread_Cache * unused = nullptr;
+
+        for (size_t probe = 0; probe < thread_cache_count; ++probe)
+        {
+            Thread_Cache & cache = thread_caches[(serial + probe) % thread_cache_count];
+
+            if (cache.pool_serial == serial) return &cache;
+
+            if (cache.pool_serial == 0 && !unused) unused = &cache;
+        }
+
+        // Si el hilo ya usa tantos pools como cachés tiene, se intenta recuperar alguna de un pool
+        // destruido. Si no la hay, este pool usa la lista compartida:
+
+        if (!unused) unused = reclaim_thread_cache ();
+
+        if (unused)
+        {
+            static_cast< void >(&thread_cache_closer);
+
+            unused->pool_serial = serial;
+        }
+
+        return unused;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Object_Pool_Base::fill_thread_cache (Thread_Cache & cache)
+    {
+        std::lock_guard< std::mutex > lock(mutex);
+
+        for (size_t count = 0; count < thread_cache_batch; ++count)
+        {
+            if (!free_list) add_slab ();
+
+            Free_Slot * slot = free_list;
+
+            free_list    = slot->next;
+            slot->next   = cache.slots;
+            cache.slots  = slot;
+        }
+
+        free_count  -= thread_cache_batch;
+        cache.count += thread_cache_batch;
+
+        statistics.allocations   += cache.allocations;
+        statistics.deallocations += cache.deallocations;
+
+        cache.allocations   = 0;
+        cache.deallocations = 0;
+
+        update_live ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Object_Pool_Base::drain_thread_cache (Thread_Cache & cache, size_t count)
+    {
+        std::lock_guard< std::mutex > lock(mutex);
+
+        for (size_t index = 0; index < count; ++index)
+        {
+            Free_Slot * slot = cache.slots;
+
+            cache.slots = slot->next;
+            slot->next  = free_list;
+            free_list   = slot;
+        }
+
+        free_count  += count;
+        cache.count -= count;
+
+        statistics.allocations   += cache.allocations;
+        statistics.deallocations += cache.deallocations;
+
+        cache.allocations   = 0;
+        cache.deallocations = 0;
+
+        update_live ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Object_Pool_Base::return_thread_cache ()
+    {
+        if (!thread_caches_closed)
+        {
+            for (Thread_Cache & cache : thread_caches)
+            {
+                if (cache.pool_serial == serial)
+                {
+                    drain_thread_cache (cache, cache.count);
+
+                    cache = Thread_Cache();
+                    break;
+                }
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Object_Pool_Base::Thread_Cache * Object_Pool_Base::reclaim_thread_cache ()
+    {
+        // Los huecos de las cachés de pools destruidos ya no existen, por lo que se olvidan:
+
+        std::lock_guard< std::mutex > lock(pools_mutex);
+
+        Thread_Cache * reclaimed = nullptr;
+
+        for (Thread_Cache & cache : thread_caches)
+        {
+            Object_Pool_Base * pool = first_pool;
+
+            while (pool && pool->serial != cache.pool_serial) pool = pool->next_pool;
+
+            if (!pool)
+            {
+                cache = Thread_Cache();
+
+                if (!reclaimed) reclaimed = &cache;
+            }
+        }
+
+        return reclaimed;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Object_Pool_Base::close_thread_cache (Thread_Cache & cache)
+    {
+        if (cache.pool_serial)
+        {
+            // El pool se busca por su número de serie porque puede haberse destruido. En ese caso
+            // sus huecos ya no existen y simplemente se olvidan:
+
+            std::lock_guard< std::mutex > lock(pools_mutex);
+
+            for (Object_Pool_Base * pool = first_pool; pool; pool = pool->next_pool)
+            {
+                if (pool->serial == cache.pool_serial)
+                {
+                    pool->drain_thread_cache (cache, cache.count);
+                    break;
+                }
+            }
+
+            cache = Thread_Cache();
+        }
+    }
+
+}
@@ -0,0 +1,274 @@
+/*
+ * PROFILER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802171215
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <basics/assert>
+#include <basics/Profiler>
+#include <basics/Timer>
+
+namespace basics
+{
+
+    Profiler profiler;
+
+    constexpr size_t Profiler::ring_capacity;
+
+    // ---------------------------------------------------------------------------------------------
+
+    namespace
+    {
+
+        void write_json_string (std::ostream & output, const char * chars)
+        {
+            output << '"';
+
+            for ( ; chars && *chars; ++chars)
+            {
+                if (*chars == '"' || *chars == '\\') output << '\\';
+
+                output << *chars;
+            }
+
+            output << '"';
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Profiler::Profiler()
+    :
+        thread_count        (0),
+        last_frame_timestamp(0),
+        jank_count          (0)
+    {
+        set_jank_threshold (1.5f / 60.f);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Profiler::Ring & Profiler::get_thread_ring ()
+    {
+        // Cada hilo toma su buffer la primera vez que registra algo, reutilizando el de algún hilo
+        // que haya terminado si lo hay. Solo en ese momento se toma el lock:
+
+        thread_local Ring_Owner owner;
+
+        if (!owner.ring)
+        {
+            std::lock_guard< std::mutex > lock(profiler.rings_mutex);
+
+            uint32_t thread_number = ++profiler.thread_count;
+
+            if (profiler.free_rings.empty ())
+            {
+                profiler.rings.emplace_back (new Ring(thread_number));
+
+                owner.ring = profiler.rings.back ().get ();
+            }
+            else
+            {
+                owner.ring = profiler.free_rings.back ();
+
+                profiler.free_rings.pop_back ();
+
+                // Lo que registró el hilo anterior se descarta para no atribuirlo al nuevo:
+
+                owner.ring->start         = owner.ring->head.load (std::memory_order_relaxed);
+                owner.ring->thread_number = thread_number;
+                owner.ring->depth         = 0;
+            }
+        }
+
+        return *owner.ring;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Profiler::Ring_Owner::~Ring_Owner()
+    {
+        if (ring)
+        {
+            std::lock_guard< std::mutex > lock(profiler.rings_mutex);
+
+            profiler.free_rings.push_back (ring);
+
+            ring = nullptr;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Profiler::push (Ring & ring, const char * name, Record_Type type, uint8_t depth, int64_t timestamp, int64_t value)
+    {
+        uint64_t head = ring.head.load (std::memory_order_relaxed);
+
+        ring.records[head & (ring_capacity - 1)] = { name, timestamp, value, type, depth };
+
+        ring.head.store (head + 1, std::memory_order_release);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Profiler::begin_zone (const char * name)
+    {
+        Ring & ring = get_thread_ring ();
+
+        push (ring, name, BEGIN, ring.depth++, Timer::get_monotonic_nanoseconds ());
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Profiler::end_zone (const char * name)
+    {
+        Ring & ring = get_thread_ring ();
+
+        push (ring, name, END, --ring.depth, Timer::get_monotonic_nanoseconds ());
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Profiler::mark_frame ()
+    {
+        Ring  & ring = get_thread_ring ();
+        int64_t now  = Timer::get_monotonic_nanoseconds ();
+
+        push (ring, "frame", FRAME, ring.depth, now);
+
+        frame_thread = std::this_thread::get_id ();
+
+        if (last_frame_timestamp != 0)
+        {
+            int64_t frame_time = now - last_frame_timestamp;
+
+            frame_times.record (frame_time);
+
+            if (frame_time > jank_threshold) ++jank_count;
+        }
+
+        last_frame_timestamp = now;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Profiler::record_counter (const char * name, int64_t value)
+    {
+        Ring & ring = get_thread_ring ();
+
+        push (ring, name, COUNTER, ring.depth, Timer::get_monotonic_nanoseconds (), value);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Profiler::set_jank_threshold (float seconds)
+    {
+        jank_threshold = int64_t(double(seconds) * 1e9);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Profiler::reset ()
+    {
+        assert(frame_thread == std::thread::id() || frame_thread == std::this_thread::get_id ());
+
+        std::lock_guard< std::mutex > lock(rings_mutex);
+
+        // Solo el hilo propietario escribe en head, por lo que en lugar de vaciar los buffers se
+        // avanza el primer registro que se exporta:
+
+        for (auto & ring : rings)
+        {
+            ring->start = ring->head.load (std::memory_order_acquire);
+        }
+
+        frame_times.clear ();
+
+        last_frame_timestamp = 0;
+        jank_count           = 0;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Profiler::write_chrome_trace (std::ostream & output)
+    {
+        std::lock_guard< std::mutex > lock(rings_mutex);
+
+        output << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+        bool first = true;
+
+        output << std::fixed << std::setprecision (3);
+
+        for (auto & ring : rings)
+        {
+            uint64_t head  = ring->head.load (std::memory_order_acquire);
+            uint64_t start = std::max (ring->start, head > ring_capacity ? head - ring_capacity : 0);
+            unsigned open  = 0;
+
+            for (uint64_t index = start; index < head; ++index)
+            {
+                const Record & record = ring->records[index & (ring_capacity - 1)];
+
+                // Si el buffer ha dado la vuelta se descartan los finales cuyo inicio se ha perdido:
+
+                if (record.type == END)
+                {
+                    if (open == 0) continue;
+
+                    --open;
+                }
+                else
+                if (record.type == BEGIN)
+                {
+                    ++open;
+                }
+
+                if (!first) output << ',';
+
+                first = false;
+
+                output << "{\"name\":";
+
+                write_json_string (output, record.name);
+
+                switch (record.type)
+                {
+                    case BEGIN:   output << ",\"ph\":\"B\"";            break;
+                    case END:     output << ",\"ph\":\"E\"";            break;
+                    case FRAME:   output << ",\"ph\":\"i\",\"s\":\"g\""; break;
+                    case COUNTER: output << ",\"ph\":\"C\",\"args\":{\"value\":" << record.value << '}'; break;
+                }
+
+                output << ",\"ts\":"  << double(record.timestamp) * 1e-3
+                       << ",\"pid\":1,\"tid\":" << ring->thread_number << '}';
+            }
+        }
+
+        output << "]}\n";
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Profiler::save_chrome_trace (const std::string & path)
+    {
+        std::ofstream file(path, std::ios::out | std::ios::trunc);
+
+        if (!file) return false;
+
+        write_chrome_trace (file);
+
+        return bool(file);
+    }
+
+}
@@ -12,6 +12,7 @@
 
 #include <cstring>
 #include <rapidxml.hpp>
+#include <basics/Memory_Tracker>
 #include <basics/Raster_Font>
 
 using namespace std;
@@ -33,6 +34,28 @@ namespace basics
                 ready = parse (font_data, path, context);
             }
         }
+
+        memory_tracker.add (Memory_Tracker::FONTS, get_character_map_size ());
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Raster_Font::~Raster_Font()
+    {
+        memory_tracker.remove (Memory_Tracker::FONTS, get_character_map_size ());
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    int64_t Raster_Font::get_character_map_size () const
+    {
+        // Nodos (par código-carácter más el enlace al siguiente) y tabla de buckets:
+
+        return int64_t
+        (
+            character_map.size         () * (sizeof(Character_Map::value_type) + 2 * sizeof(void *)) +
+            character_map.bucket_count () * sizeof(void *)
+        );
     }
 
     // ---------------------------------------------------------------------------------------------
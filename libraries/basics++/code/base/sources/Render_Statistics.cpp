@@ -0,0 +1,20 @@
+/*
+ * RENDER STATISTICS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802181020
+ */
+
+#include <basics/Render_Statistics>
+
+namespace basics
+{
+
+    Render_Statistics render_statistics = { 0, 0, 0 };
+
+}
@@ -0,0 +1,274 @@
+/*
+ * STARTUP TIMELINE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802231230
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <basics/Log>
+#include <basics/macros>
+#include <basics/Startup_Timeline>
+#include <basics/Timer>
+
+#if defined(BASICS_ANDROID_OS) || defined(BASICS_LINUX_OS)
+    #include <time.h>
+    #include <unistd.h>
+#endif
+
+namespace basics
+{
+
+    Startup_Timeline startup_timeline;
+
+    constexpr size_t Startup_Timeline::max_milestones;
+
+    // ---------------------------------------------------------------------------------------------
+
+    namespace
+    {
+
+        void write_json_string (std::ostream & output, const std::string & text)
+        {
+            output << '"';
+
+            for (char character : text)
+            {
+                if (character == '"' || character == '\\') output << '\\';
+
+                output << character;
+            }
+
+            output << '"';
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Startup_Timeline::Startup_Timeline()
+    :
+        open(true)
+    {
+        // La biblioteca se carga justo después de crear el proceso, por lo que lo que se mide a
+        // partir de aquí ya incluye la carga del código nativo:
+
+        int64_t now = Timer::get_monotonic_nanoseconds ();
+        int64_t age = get_process_age ();
+
+        origin_is_process = age >= 0;
+        origin            = origin_is_process ? now - age : now;
+
+        milestones.reserve (max_milestones);
+
+        if (origin_is_process) milestones.push_back ({ "process started", origin, 0 });
+
+        milestones.push_back ({ "library loaded", now, get_thread_number () });
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Startup_Timeline::mark (const std::string & name)
+    {
+        if (!is_open ()) return;
+
+        int64_t  now    = Timer::get_monotonic_nanoseconds ();
+        uint32_t thread = get_thread_number ();
+
+        std::lock_guard< std::mutex > lock(mutex);
+
+        if (open.load (std::memory_order_relaxed) && milestones.size () < max_milestones)
+        {
+            milestones.push_back ({ name, now, thread });
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Startup_Timeline::finish ()
+    {
+        std::vector< Milestone > closed_milestones;
+        std::string              path;
+
+        {
+            std::lock_guard< std::mutex > lock(mutex);
+
+            if (!open.exchange (false)) return;
+
+            closed_milestones = milestones;
+            path              = export_path;
+        }
+
+        // Cada hito se muestra con el tiempo desde el origen y desde el hito anterior, que es lo
+        // que permite ver qué paso se come el arranque:
+
+        int64_t total = closed_milestones.back ().timestamp - origin;
+
+        log.i ("startup: ", float(total) * 1e-6f, " ms to the first frame since the ", origin_is_process ? "process start" : "library load");
+
+        int64_t previous = origin;
+
+        for (auto & milestone : closed_milestones)
+        {
+            char times[48];
+
+            std::snprintf
+            (
+                times, sizeof(times), "%9.2f ms (+%8.2f)",
+                double(milestone.timestamp - origin  ) * 1e-6,
+                double(milestone.timestamp - previous) * 1e-6
+            );
+
+            log.i ("startup: ", times, " thread ", milestone.thread_number, ": ", milestone.name);
+
+            previous = milestone.timestamp;
+        }
+
+        if (!path.empty () && !save_chrome_trace (path))
+        {
+            log.w ("startup: can't save the timeline to ", path);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    std::vector< Startup_Timeline::Milestone > Startup_Timeline::get_milestones () const
+    {
+        std::lock_guard< std::mutex > lock(mutex);
+
+        return milestones;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    float Startup_Timeline::get_elapsed_seconds () const
+    {
+        std::lock_guard< std::mutex > lock(mutex);
+
+        return float(milestones.back ().timestamp - origin) * 1e-9f;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Startup_Timeline::write_chrome_trace (std::ostream & output) const
+    {
+        std::vector< Milestone > copy = get_milestones ();
+
+        output << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        output << std::fixed << std::setprecision (3);
+
+        for (size_t index = 0; index < copy.size (); ++index)
+        {
+            const Milestone & milestone = copy[index];
+
+            if (index > 0) output << ',';
+
+            output << "{\"name\":";
+
+            write_json_string (output, milestone.name);
+
+            output << ",\"cat\":\"startup\",\"ph\":\"i\",\"s\":\"p\""
+                   << ",\"ts\":"  << double(milestone.timestamp) * 1e-3
+                   << ",\"pid\":1,\"tid\":" << milestone.thread_number
+                   << ",\"args\":{\"since_origin_ms\":" << double(milestone.timestamp - origin) * 1e-6 << "}}";
+        }
+
+        output << "]}\n";
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Startup_Timeline::save_chrome_trace (const std::string & path) const
+    {
+        std::ofstream file(path);
+
+        if (!file) return false;
+
+        write_chrome_trace (file);
+
+        return bool(file);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    uint32_t Startup_Timeline::get_thread_number ()
+    {
+        static std::atomic< uint32_t > next_number(1);
+
+        thread_local uint32_t number = next_number.fetch_add (1, std::memory_order_relaxed);
+
+        return number;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    int64_t Startup_Timeline::get_process_age ()
+    {
+        #if defined(BASICS_ANDROID_OS) || defined(BASICS_LINUX_OS)
+
+            // El campo 22 de /proc/self/stat es el instante en el que se creó el proceso, en ticks
+            // del reloj desde el arranque del sistema. El nombre del proceso (campo 2) puede tener
+            // espacios, por lo que se empieza a contar tras su paréntesis de cierre:
+
+            std::FILE * file = std::fopen ("/proc/self/stat", "r");
+
+            if (!file) return -1;
+
+            char   buffer[1024];
+            size_t length = std::fread (buffer, 1, sizeof(buffer) - 1, file);
+
+            std::fclose (file);
+
+            buffer[length] = '\0';
+
+            const char * fields = std::strrchr (buffer, ')');
+
+            if (!fields) return -1;
+
+            unsigned long long start_ticks = 0;
+
+            if
+            (
+                std::sscanf
+                (
+                    fields + 1,
+                    " %*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %*u %*u %*d %*d %*d %*d %*d %*d %llu",
+                    &start_ticks
+                ) != 1
+            )
+            {
+                return -1;
+            }
+
+            long            ticks_per_second = sysconf (_SC_CLK_TCK);
+            struct timespec boot_time;
+
+            if (ticks_per_second <= 0 || clock_gettime (CLOCK_BOOTTIME, &boot_time) != 0) return -1;
+
+            int64_t now   = int64_t(boot_time.tv_sec) * 1000000000 + boot_time.tv_nsec;
+            int64_t start = int64_t(start_ticks) * 1000000000 / ticks_per_second;
+            int64_t age   = now - start;
+
+            // Los ticks tienen una resolución de 10 ms en la mayoría de sistemas. Una edad negativa
+            // o de más de un minuto indica que los relojes no son comparables:
+
+            if (age < 0 || age > int64_t(60) * 1000000000) return -1;
+
+            return age;
+
+        #else
+
+            return -1;
+
+        #endif
+    }
+
+}
@@ -10,26 +10,38 @@
  * C1802030140
  */
 
+#include <cwchar>
 #include <basics/Text_Layout>
 
 namespace basics
 {
 
-    Text_Layout::Text_Layout(const Raster_Font & font, const std::wstring & text)
+    Text_Layout::Text_Layout(const Raster_Font & font, const wchar_t * text, Frame_Arena * arena)
     :
-        width (0.f),
-        height(0.f)
+        glyphs(Frame_Allocator< Glyph >(arena))
     {
+        layout (font, text, text ? std::wcslen (text) : 0);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Text_Layout::layout (const Raster_Font & font, const wchar_t * text, size_t length)
+    {
+        width  = 0.f;
+        height = 0.f;
+
         Raster_Font::Metrics metrics = font.get_metrics ();
 
-        glyphs.reserve (text.length ());
+        glyphs.reserve (length);
 
         float current_x  = 0;
         float current_y  = -metrics.line_height;
         float line_width = 0;
 
-        for (auto & c : text)
+        for (const wchar_t * end = text + length; text < end; ++text)
         {
+            wchar_t c = *text;
+
             if (c == L'\n')
             {
                 if (current_x > width) width = current_x;
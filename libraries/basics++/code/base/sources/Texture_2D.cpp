@@ -10,12 +10,51 @@
  * C1801161300
  */
 
+#include <future>
+#include <map>
+#include <mutex>
 #include <basics/png_decode>
+#include <basics/Startup_Timeline>
 #include <basics/Texture_2D>
 
 namespace basics
 {
 
+    namespace
+    {
+
+        struct Decoded_Image
+        {
+            bool                     decoded;
+            Color_Buffer< Rgba8888 > color_buffer;
+            Texture_2D::Options      options;
+        };
+
+        std::mutex                                             prefetch_mutex;
+        std::map< std::string, std::future< Decoded_Image > > prefetched_images;
+
+        Decoded_Image decode (const std::string & asset_path)
+        {
+            Decoded_Image            image{ false, {}, {} };
+            std::shared_ptr< Asset > asset = Asset::open (asset_path);
+
+            if (asset)
+            {
+                std::vector< byte > data;
+
+                if (asset->read_all (data))
+                {
+                    image.decoded = png_decode (data, image.color_buffer, image.options.width, image.options.height);
+                }
+            }
+
+            if (startup_timeline.is_open ()) startup_timeline.mark ("texture decoded: " + asset_path);
+
+            return image;
+        }
+
+    }
+
     Id                  Texture_2D::texture_2d_specialization_ids      [10];
     Texture_2D::Factory Texture_2D::texture_2d_specialization_factories[10];
     size_t              Texture_2D::texture_2d_specialization_count;
@@ -37,25 +76,45 @@ namespace basics
 
     std::shared_ptr< Texture_2D > Texture_2D::create (Id id, Graphics_Context::Accessor & context, const std::string & asset_path, const Options & options)
     {
-        std::shared_ptr< Asset > asset = Asset::open (asset_path);
+        // Si la imagen se había empezado a decodificar con prefetch(), se usa ese resultado:
+
+        std::future< Decoded_Image > prefetched_image;
 
-        if (asset)
         {
-            std::vector< byte >  data;
+            std::lock_guard< std::mutex > lock(prefetch_mutex);
+
+            auto prefetched = prefetched_images.find (asset_path);
 
-            if (asset->read_all (data))
+            if (prefetched != prefetched_images.end ())
             {
-                Color_Buffer< Rgba8888 > color_buffer;
-                Texture_2D::Options      options;
+                prefetched_image = std::move (prefetched->second);
 
-                if (png_decode (data, color_buffer, options.width, options.height))
-                {
-                    return Texture_2D::create (id, context, color_buffer, options);
-                }
+                prefetched_images.erase (prefetched);
             }
         }
 
+        Decoded_Image image = prefetched_image.valid () ? prefetched_image.get () : decode (asset_path);
+
+        if (image.decoded)
+        {
+            std::shared_ptr< Texture_2D > texture = Texture_2D::create (id, context, image.color_buffer, image.options);
+
+            if (startup_timeline.is_open ()) startup_timeline.mark ("texture created: " + asset_path);
+
+            return texture;
+        }
+
         return std::shared_ptr< Texture_2D >();
     }
 
+    void Texture_2D::prefetch (const std::string & asset_path)
+    {
+        std::lock_guard< std::mutex > lock(prefetch_mutex);
+
+        if (prefetched_images.count (asset_path) == 0)
+        {
+            prefetched_images[asset_path] = std::async (std::launch::async, decode, asset_path);
+        }
+    }
+
 }
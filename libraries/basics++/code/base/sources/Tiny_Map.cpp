@@ -0,0 +1,31 @@
+/*
+ * TINY MAP
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1801201704
+ */
+
+#include <cstdlib>
+#include <basics/Log>
+#include <basics/Tiny_Map>
+
+namespace basics
+{
+
+    void tiny_map_overflow (size_t capacity)
+    {
+        // Sobrescribir otro elemento perdería datos sin avisar, por lo que se prefiere terminar. El
+        // log se vacía antes porque lo escribe otro hilo:
+
+        log.f ("Tiny_Map full: can't add a key beyond its capacity of ", capacity, " items");
+        log.flush ();
+
+        std::abort ();
+    }
+
+}
@@ -0,0 +1,185 @@
+/*
+ * ASSET BENCHMARKS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802231100
+ */
+
+#include <cstring>
+#include <basics/Asset>
+#include <basics/Atlas>
+#include <basics/Frame_Arena>
+#include <basics/png_decode>
+#include <basics/Raster_Font>
+#include <basics/Text_Layout>
+#include "Benchmark.hpp"
+#include "Headless_Context.hpp"
+
+using namespace basics;
+
+namespace benchmarks
+{
+
+    namespace
+    {
+
+        // Assets reales del juego (projects/android-studio-3/app/src/main/assets) y el atlas de
+        // benchmarks/assets, que reutiliza la textura de la fuente:
+
+        const char * const png_paths[] =
+        {
+            "game-scene/background.png",
+            "game-scene/click.png",
+            "game-scene/fonts/impact.png",
+        };
+
+        const char * const atlas_path = "game-scene/fonts/impact.sprites";
+        const char * const  font_path = "game-scene/fonts/impact.fnt";
+
+        const wchar_t short_text[] = L"PAUSA";
+        const wchar_t  long_text[] = L"Puntos: 1250   Nivel: 7   Tiempo: 00:42\nPulsa en la pantalla para continuar";
+
+        // -----------------------------------------------------------------------------------------
+
+        void run_png_benchmarks (Suite & suite)
+        {
+            for (const char * path : png_paths)
+            {
+                std::shared_ptr< Asset > asset = Asset::open (path);
+                std::vector< byte >      data;
+
+                if (!asset || !asset->read_all (data))
+                {
+                    suite.skip ("png", std::string("decode ") + path, "asset not found");
+                    continue;
+                }
+
+                // Se decodifica una vez fuera del cronómetro para conocer el número de píxeles:
+
+                Color_Buffer< Rgba8888 > color_buffer;
+                unsigned                 width  = 0;
+                unsigned                 height = 0;
+
+                if (!png_decode (data, color_buffer, width, height))
+                {
+                    suite.skip ("png", std::string("decode ") + path, "decoding failed");
+                    continue;
+                }
+
+                suite.run
+                (
+                    "png", std::string("decode ") + path, uint64_t(width) * height,
+                    [&data] ()
+                    {
+                        Color_Buffer< Rgba8888 > color_buffer;
+                        unsigned                 width, height;
+
+                        png_decode (data, color_buffer, width, height);
+
+                        keep (color_buffer);
+                    }
+                );
+            }
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        void run_font_benchmarks (Suite & suite, Graphics_Context::Accessor & context)
+        {
+            // Las texturas que se cargan se añaden al contexto y este no permite quitarlas, por lo
+            // que cada carga se hace con un contexto nuevo para no acumularlas. Crearlo solo cuesta
+            // unos microsegundos, frente a los milisegundos de decodificar la textura:
+
+            if (Asset::exists (atlas_path))
+            {
+                suite.run
+                (
+                    "atlas", std::string("load ") + atlas_path, 1,
+                    [] ()
+                    {
+                        Headless_Graphics graphics({ 1280, 720 });
+                        Atlas             atlas(atlas_path, graphics.context);
+
+                        keep (atlas);
+                    }
+                );
+            }
+            else
+                suite.skip ("atlas", std::string("load ") + atlas_path, "asset not found");
+
+            if (!Asset::exists (font_path))
+            {
+                suite.skip ("font", std::string("load ") + font_path, "asset not found");
+                return;
+            }
+
+            suite.run
+            (
+                "font", std::string("load ") + font_path, 1,
+                [] ()
+                {
+                    Headless_Graphics graphics({ 1280, 720 });
+                    Raster_Font       font(font_path, graphics.context);
+
+                    keep (font);
+                }
+            );
+
+            // Text_Layout con los glifos reservados con new y en una arena que se vacía en cada
+            // iteración, como hace Director al terminar cada fotograma:
+
+            Raster_Font font(font_path, context);
+            Frame_Arena arena;
+
+            for (const wchar_t * text : { short_text, long_text })
+            {
+                size_t      length = std::wcslen (text);
+                std::string suffix = std::to_string (length) + " chars";
+
+                suite.run
+                (
+                    "text", "layout heap " + suffix, length,
+                    [&font, text] ()
+                    {
+                        Text_Layout layout(font, text);
+
+                        keep (layout);
+                    }
+                );
+
+                suite.run
+                (
+                    "text", "layout arena " + suffix, length,
+                    [&font, &arena, text] ()
+                    {
+                        {
+                            Text_Layout layout(font, text, &arena);
+
+                            keep (layout);
+                        }
+
+                        arena.reset ();
+                    }
+                );
+            }
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void run_asset_benchmarks (Suite & suite)
+    {
+        run_png_benchmarks (suite);
+
+        Headless_Graphics graphics({ 1280, 720 });
+
+        run_font_benchmarks (suite, graphics.context);
+    }
+
+}
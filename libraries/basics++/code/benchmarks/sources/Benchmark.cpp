@@ -0,0 +1,296 @@
+/*
+ * BENCHMARK
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802231100
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <thread>
+#include "Benchmark.hpp"
+
+namespace benchmarks
+{
+
+    namespace
+    {
+
+        std::string escape (const std::string & text)
+        {
+            std::string escaped;
+
+            for (char character : text)
+            {
+                switch (character)
+                {
+                    case '"':  escaped += "\\\""; break;
+                    case '\\': escaped += "\\\\"; break;
+                    case '\n': escaped += "\\n";  break;
+                    case '\t': escaped += "\\t";  break;
+
+                    default:
+                    {
+                        if (static_cast< unsigned char >(character) < 0x20)
+                        {
+                            char code[8];
+
+                            std::snprintf (code, sizeof(code), "\\u%04x", unsigned(character));
+
+                            escaped += code;
+                        }
+                        else
+                            escaped += character;
+                    }
+                }
+            }
+
+            return escaped;
+        }
+
+        // Busca en una línea escrita por write_json() el valor de una clave. No es un parser de
+        // JSON general, solo entiende el formato de una línea por benchmark que se escribe aquí.
+
+        bool find_string (const std::string & line, const char * key, std::string & value)
+        {
+            std::string pattern = std::string("\"") + key + "\": \"";
+            size_t      start   = line.find (pattern);
+
+            if (start == std::string::npos) return false;
+
+            value.clear ();
+
+            for (size_t index = start + pattern.size (); index < line.size () && line[index] != '"'; ++index)
+            {
+                if (line[index] == '\\' && index + 1 < line.size ()) ++index;
+
+                value += line[index];
+            }
+
+            return true;
+        }
+
+        bool find_number (const std::string & line, const char * key, double & value)
+        {
+            std::string pattern = std::string("\"") + key + "\": ";
+            size_t      start   = line.find (pattern);
+
+            if (start == std::string::npos) return false;
+
+            value = std::strtod (line.c_str () + start + pattern.size (), nullptr);
+
+            return true;
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Suite::skip (const std::string & group, const std::string & name, const std::string & reason)
+    {
+        if (is_selected (group, name))
+        {
+            std::cerr << "  " << std::left << std::setw (52) << (group + '/' + name) << "skipped: " << reason << std::endl;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Suite::report_check (const std::string & group, const std::string & name, bool passed, const std::string & detail)
+    {
+        std::cerr
+            << "  " << std::left << std::setw (52) << (group + '/' + name)
+            << (passed ? "ok" : "FAILED") << (detail.empty () ? "" : ": ") << detail << std::endl;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Suite::is_selected (const std::string & group, const std::string & name) const
+    {
+        std::string full_name = group + '/' + name;
+
+        if (!options.filter.empty () && full_name.find (options.filter) == std::string::npos)
+        {
+            return false;
+        }
+
+        if (options.list_only)
+        {
+            std::cout << full_name << std::endl;
+
+            return false;
+        }
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Suite::add (const std::string & group, const std::string & name, uint64_t iterations, uint64_t items, std::vector< double > & sample_times)
+    {
+        Result result;
+
+        result.group      = group;
+        result.name       = name;
+        result.iterations = iterations;
+        result.samples    = unsigned(sample_times.size ());
+        result.items      = items;
+
+        std::sort (sample_times.begin (), sample_times.end ());
+
+        size_t count  = sample_times.size ();
+        double sum    = 0.0;
+        double square = 0.0;
+
+        for (double sample_time : sample_times) sum += sample_time;
+
+        result.mean_ns   = sum / double(count);
+        result.median_ns = count % 2 ? sample_times[count / 2] : (sample_times[count / 2 - 1] + sample_times[count / 2]) * .5;
+        result.min_ns    = sample_times.front ();
+        result.max_ns    = sample_times.back  ();
+
+        for (double sample_time : sample_times) square += (sample_time - result.mean_ns) * (sample_time - result.mean_ns);
+
+        result.stddev_ns = count > 1 ? std::sqrt (square / double(count - 1)) : 0.0;
+
+        results.push_back (result);
+
+        // Se informa del progreso por stderr para no mezclarlo con el JSON:
+
+        std::cerr
+            << "  " << std::left << std::setw (52) << (group + '/' + name)
+            << std::right << std::fixed << std::setprecision (1) << std::setw (14) << result.median_ns << " ns"
+            << "  ±" << std::setprecision (1) << (result.median_ns > 0.0 ? result.stddev_ns * 100.0 / result.median_ns : 0.0) << '%'
+            << std::endl;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Suite::write_json (std::ostream & output) const
+    {
+        // Se escribe un benchmark por línea para que los diffs entre ejecuciones sean legibles y
+        // para que compare() pueda leer el archivo sin un parser completo:
+
+        output << "{\n";
+        output << "  \"suite\": \"basics++\",\n";
+        output << "  \"format\": 1,\n";
+        output << "  \"context\": {";
+
+        #if defined(__clang__)
+            output << " \"compiler\": \"clang " << __clang_major__ << '.' << __clang_minor__ << "\",";
+        #elif defined(__GNUC__)
+            output << " \"compiler\": \"gcc " << __GNUC__ << '.' << __GNUC_MINOR__ << "\",";
+        #else
+            output << " \"compiler\": \"unknown\",";
+        #endif
+
+        #if defined(NDEBUG)
+            output << " \"assertions\": false,";
+        #else
+            output << " \"assertions\": true,";
+        #endif
+
+        output << " \"hardware_threads\": " << std::thread::hardware_concurrency ();
+        output << ", \"samples\": "         << options.samples;
+        output << ", \"min_sample_time\": " << options.min_sample_time << " },\n";
+        output << "  \"benchmarks\":\n  [\n";
+
+        output << std::setprecision (9);
+
+        for (size_t index = 0; index < results.size (); ++index)
+        {
+            const Result & result = results[index];
+
+            output
+                << "    { \"group\": \""         << escape (result.group) << '"'
+                << ", \"name\": \""              << escape (result.name ) << '"'
+                << ", \"iterations\": "          << result.iterations
+                << ", \"samples\": "             << result.samples
+                << ", \"items\": "               << result.items
+                << ", \"median_ns\": "           << result.median_ns
+                << ", \"mean_ns\": "             << result.mean_ns
+                << ", \"min_ns\": "              << result.min_ns
+                << ", \"max_ns\": "              << result.max_ns
+                << ", \"stddev_ns\": "           << result.stddev_ns
+                << ", \"items_per_second\": "    << result.get_items_per_second ()
+                << " }" << (index + 1 < results.size () ? "," : "") << '\n';
+        }
+
+        output << "  ]\n}\n";
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    int Suite::compare (const std::string & baseline_path, double threshold, std::ostream & report) const
+    {
+        std::ifstream baseline_file(baseline_path);
+
+        if (!baseline_file)
+        {
+            report << "can't read the baseline " << baseline_path << std::endl;
+
+            return -1;
+        }
+
+        std::map< std::string, double > baseline;
+        std::string                     line;
+
+        while (std::getline (baseline_file, line))
+        {
+            std::string group, name;
+            double      median_ns;
+
+            if (find_string (line, "group", group) && find_string (line, "name", name) && find_number (line, "median_ns", median_ns))
+            {
+                baseline[group + '/' + name] = median_ns;
+            }
+        }
+
+        int regressions = 0;
+
+        report << "\ncomparison with " << baseline_path << ":\n";
+
+        for (auto & result : results)
+        {
+            std::string full_name = result.group + '/' + result.name;
+            auto        previous  = baseline.find (full_name);
+
+            report << "  " << std::left << std::setw (52) << full_name << std::right;
+
+            if (previous == baseline.end () || previous->second <= 0.0)
+            {
+                report << "           new\n";
+                continue;
+            }
+
+            double change = result.median_ns / previous->second - 1.0;
+
+            report << std::fixed << std::setprecision (1) << std::showpos << std::setw (13) << change * 100.0 << '%' << std::noshowpos;
+
+            if (change > threshold)
+            {
+                report << "  REGRESSION";
+
+                ++regressions;
+            }
+
+            report << '\n';
+        }
+
+        report << std::flush;
+
+        return regressions;
+    }
+
+}
@@ -0,0 +1,213 @@
+/*
+ *  BENCHMARK
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C1802231100
+ */
+
+#ifndef BASICS_BENCHMARK_HEADER
+#define BASICS_BENCHMARK_HEADER
+
+    #include <chrono>
+    #include <cstdint>
+    #include <iosfwd>
+    #include <string>
+    #include <utility>
+    #include <vector>
+
+    namespace benchmarks
+    {
+
+        /**
+         * Impide que el compilador elimine el cálculo de un valor que no se usa después.
+         */
+        template< typename TYPE >
+        inline void keep (const TYPE & value)
+        {
+            #if defined(__GNUC__) || defined(__clang__)
+                asm volatile ("" : : "g"(&value) : "memory");
+            #else
+                static volatile const void * sink;
+                sink = &value;
+            #endif
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        struct Result
+        {
+            std::string group;
+            std::string name;
+            uint64_t    iterations;             ///< Iteraciones de cada muestra.
+            unsigned    samples;
+            uint64_t    items;                  ///< Elementos procesados en cada iteración.
+            double      mean_ns;                ///< Tiempos por iteración.
+            double      median_ns;
+            double      min_ns;
+            double      max_ns;
+            double      stddev_ns;
+
+            double get_items_per_second () const
+            {
+                return median_ns > 0.0 ? double(items) * 1e9 / median_ns : 0.0;
+            }
+        };
+
+        // -----------------------------------------------------------------------------------------
+
+        /**
+         * Ejecuta y cronometra los benchmarks. Cada uno se repite primero hasta que una muestra dura
+         * al menos min_sample_time y después se toman varias muestras con ese número de
+         * iteraciones. Se guarda el tiempo por iteración de cada muestra y se resume con la mediana,
+         * que es la que se compara con la línea base porque le afectan menos las interrupciones.
+         */
+        class Suite
+        {
+        public:
+
+            struct Options
+            {
+                std::string filter;                 ///< Solo se ejecutan los que contienen este texto en "grupo/nombre".
+                double      min_sample_time = .02;  ///< En segundos.
+                unsigned    samples         = 15;
+                bool        list_only       = false;
+            };
+
+        private:
+
+            typedef std::chrono::steady_clock Clock;
+
+            Options               options;
+            std::vector< Result > results;
+            unsigned              failure_count = 0;
+
+        public:
+
+            Suite(const Options & options) : options(options)
+            {
+            }
+
+        public:
+
+            /**
+             * Cronometra body(), que se llama una vez por iteración.
+             * @param items Elementos que procesa cada llamada (píxeles, eventos, partículas...).
+             */
+            template< typename BODY >
+            void run (const std::string & group, const std::string & name, uint64_t items, BODY && body)
+            {
+                if (!is_selected (group, name)) return;
+
+                // Se calcula el número de iteraciones de cada muestra:
+
+                uint64_t iterations = 1;
+                double   elapsed    = time (body, iterations);
+
+                while (elapsed < options.min_sample_time && iterations < (uint64_t(1) << 40))
+                {
+                    // Se estima cuántas iteraciones hacen falta sin multiplicar más de por 10:
+
+                    double factor = elapsed > 0.0 ? options.min_sample_time * 1.2 / elapsed : 10.0;
+
+                    iterations = uint64_t(double(iterations) * (factor < 2.0 ? 2.0 : factor > 10.0 ? 10.0 : factor));
+                    elapsed    = time (body, iterations);
+                }
+
+                std::vector< double > sample_times(options.samples);
+
+                for (auto & sample_time : sample_times)
+                {
+                    sample_time = time (body, iterations) * 1e9 / double(iterations);
+                }
+
+                add (group, name, iterations, items, sample_times);
+            }
+
+            /**
+             * Anota un benchmark que no se pudo ejecutar (por ejemplo, porque falta un asset).
+             */
+            void skip (const std::string & group, const std::string & name, const std::string & reason);
+
+            /**
+             * Ejecuta una comprobación (resultados equivalentes, presupuestos de llamadas...) que
+             * hace fallar la ejecución si no se cumple. body(detail) retorna si se cumple y puede
+             * describir en detail lo que ha medido.
+             */
+            template< typename BODY >
+            void check (const std::string & group, const std::string & name, BODY && body)
+            {
+                if (!is_selected (group, name)) return;
+
+                std::string detail;
+                bool        passed = body (detail);
+
+                if (!passed) ++failure_count;
+
+                report_check (group, name, passed, detail);
+            }
+
+        public:
+
+            const std::vector< Result > & get_results () const
+            {
+                return results;
+            }
+
+            unsigned get_failure_count () const
+            {
+                return failure_count;
+            }
+
+            void write_json (std::ostream & output) const;
+
+            /**
+             * Compara las medianas con las de un archivo JSON escrito antes con write_json().
+             * @param threshold Aumento relativo a partir del cual se considera que hay una regresión.
+             * @return Número de regresiones o -1 si no se pudo leer la línea base.
+             */
+            int compare (const std::string & baseline_path, double threshold, std::ostream & report) const;
+
+        private:
+
+            bool is_selected (const std::string & group, const std::string & name) const;
+
+            void add (const std::string & group, const std::string & name, uint64_t iterations, uint64_t items, std::vector< double > & sample_times);
+
+            void report_check (const std::string & group, const std::string & name, bool passed, const std::string & detail);
+
+            template< typename BODY >
+            static double time (BODY & body, uint64_t iterations)
+            {
+                Clock::time_point start = Clock::now ();
+
+                for (uint64_t iteration = 0; iteration < iterations; ++iteration)
+                {
+                    body ();
+                }
+
+                return std::chrono::duration< double >(Clock::now () - start).count ();
+            }
+
+        };
+
+        // -----------------------------------------------------------------------------------------
+
+        // Cada archivo registra los benchmarks (y las comprobaciones) de un área:
+
+        void run_math_checks       (Suite & suite);
+        void run_input_checks      (Suite & suite);
+
+        void run_asset_benchmarks  (Suite & suite);
+        void run_core_benchmarks   (Suite & suite);
+        void run_math_benchmarks   (Suite & suite);
+        void run_gaming_benchmarks (Suite & suite);
+        void run_render_benchmarks (Suite & suite);
+
+    }
+
+#endif
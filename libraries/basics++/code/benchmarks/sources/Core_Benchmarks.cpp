@@ -0,0 +1,490 @@
+/*
+ * CORE BENCHMARKS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802231100
+ */
+
+#include <atomic>
+#include <sstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <basics/Event_Queue>
+#include <basics/fnv>
+#include <basics/Frame_Arena>
+#include <basics/Log>
+#include <basics/Object_Pool>
+#include <basics/Profiler>
+#include <basics/Var>
+#include "Benchmark.hpp"
+
+using namespace basics;
+
+namespace benchmarks
+{
+
+    namespace
+    {
+
+        void run_event_queue_benchmarks (Suite & suite)
+        {
+            // Un solo hilo que encola y extrae, como cuando la cola está casi vacía:
+
+            {
+                Event_Queue queue;
+                Event       event(ID(touch-started));
+                Event       polled;
+
+                event[ID(x)] = 100.f;
+                event[ID(y)] = 200.f;
+
+                suite.run
+                (
+                    "event_queue", "push+poll 1 thread", 1,
+                    [&] ()
+                    {
+                        queue.push (event);
+                        queue.poll (polled);
+
+                        keep (polled);
+                    }
+                );
+            }
+
+            // Varios productores (hilo de entrada, hilo de la UI...) encolan a la vez mientras el
+            // hilo del juego extrae. Los productores reintentan cuando la banda está llena para
+            // que no se pierda ningún evento:
+
+            for (unsigned producer_count : { 1u, 3u })
+            {
+                const unsigned events_per_producer = 2000;
+                const uint64_t total_events        = uint64_t(producer_count) * events_per_producer;
+
+                Event_Queue queue(1024, Event_Queue::DROP_NEWEST);
+
+                suite.run
+                (
+                    "event_queue", "contention " + std::to_string (producer_count) + " producers", total_events,
+                    [&] ()
+                    {
+                        std::vector< std::thread > producers;
+
+                        for (unsigned index = 0; index < producer_count; ++index)
+                        {
+                            producers.emplace_back
+                            (
+                                [&queue, index, events_per_producer] ()
+                                {
+                                    Event event(ID(touch-started), index % 2 ? Event::NORMAL_PRIORITY : Event::HIGH_PRIORITY);
+
+                                    event[ID(x)] = float(index);
+
+                                    for (unsigned count = 0; count < events_per_producer; )
+                                    {
+                                        if (queue.push (event)) ++count; else std::this_thread::yield ();
+                                    }
+                                }
+                            );
+                        }
+
+                        Event    event;
+                        uint64_t polled = 0;
+
+                        while (polled < total_events)
+                        {
+                            if (queue.poll (event)) ++polled; else std::this_thread::yield ();
+                        }
+
+                        for (auto & producer : producers) producer.join ();
+                    }
+                );
+            }
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        void run_hash_benchmarks (Suite & suite)
+        {
+            const std::string short_key = "touch-moved";
+            const std::string  long_key = "game-scene/fonts/impact.fnt#character-map/page-0/glyph-0123";
+
+            for (const std::string * key : { &short_key, &long_key })
+            {
+                suite.run
+                (
+                    "fnv", "fnv32 " + std::to_string (key->size ()) + " chars", key->size (),
+                    [key] ()
+                    {
+                        uint32_t hash = fnv32 (*key);
+
+                        keep (hash);
+                    }
+                );
+            }
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        void run_var_benchmarks (Suite & suite)
+        {
+            float value = 0.f;
+
+            suite.run
+            (
+                "var", "box+unbox float", 1,
+                [&value] ()
+                {
+                    Var var;
+
+                    var = value;
+                    value = *var.as< var::Float > () + 1.f;
+
+                    keep (value);
+                }
+            );
+
+            // Así se usan en los eventos de entrada (Director::dispatch_input, Input_Log...):
+
+            suite.run
+            (
+                "var", "event properties x+y", 2,
+                [] ()
+                {
+                    Event event(ID(touch-moved));
+
+                    event[ID(x)] = 10.f;
+                    event[ID(y)] = 20.f;
+
+                    float x = *event[ID(x)].as< var::Float > ();
+                    float y = *event[ID(y)].as< var::Float > ();
+
+                    keep (x);
+                    keep (y);
+                }
+            );
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        struct Particle
+        {
+            float x, y, speed_x, speed_y, life;
+        };
+
+        void run_allocation_benchmarks (Suite & suite)
+        {
+            Frame_Arena arena;
+
+            suite.run
+            (
+                "memory", "frame arena 64 allocations", 64,
+                [&arena] ()
+                {
+                    for (unsigned index = 0; index < 64; ++index)
+                    {
+                        keep (arena.allocate (48));
+                    }
+
+                    arena.reset ();
+                }
+            );
+
+            suite.run
+            (
+                "memory", "make_shared", 1,
+                [] ()
+                {
+                    std::shared_ptr< Particle > particle = std::make_shared< Particle > ();
+
+                    keep (particle);
+                }
+            );
+
+            suite.run
+            (
+                "memory", "make_pooled", 1,
+                [] ()
+                {
+                    Pooled< Particle > particle = make_pooled< Particle > ();
+
+                    keep (particle);
+                }
+            );
+
+            // Dos pools creados con 16 pools de diferencia corresponden a la misma caché del hilo. Al
+            // alternar entre ellos cada uno debe conservar la suya:
+
+            {
+                std::vector< std::unique_ptr< Object_Pool< Particle > > > pools;
+
+                for (unsigned index = 0; index < 17; ++index) pools.emplace_back (new Object_Pool< Particle >);
+
+                Object_Pool< Particle > & first = *pools.front ();
+                Object_Pool< Particle > & last  = *pools.back  ();
+
+                suite.run
+                (
+                    "memory", "alternate colliding pools", 2,
+                    [&first, &last] ()
+                    {
+                        Particle * a = first.allocate ();
+                        Particle * b = last .allocate ();
+
+                        keep (a);
+                        keep (b);
+
+                        first.deallocate (a);
+                        last .deallocate (b);
+                    }
+                );
+
+                // Con más pools que cachés, los que no tienen caché usan la lista compartida:
+
+                suite.check
+                (
+                    "memory", "more pools than thread caches",
+                    [&pools] (std::string & detail)
+                    {
+                        std::vector< std::unique_ptr< Object_Pool< Particle > > > extra;
+
+                        for (unsigned index = 0; index < 16; ++index) extra.emplace_back (new Object_Pool< Particle >);
+
+                        std::vector< Particle * > objects;
+
+                        for (auto & pool : extra) objects.push_back (pool->allocate ());
+
+                        size_t live = 0;
+
+                        for (size_t index = 0; index < extra.size (); ++index)
+                        {
+                            extra[index]->deallocate (objects[index]);
+
+                            extra[index]->trim ();
+
+                            live += extra[index]->get_statistics ().live;
+                        }
+
+                        detail = std::to_string (pools.size () + extra.size ()) + " pools, " + std::to_string (live) + " objects left alive";
+
+                        return live == 0;
+                    }
+                );
+            }
+
+            // Cada hilo reserva en su propia caché y libera objetos creados en otro hilo. Al terminar
+            // los hilos, todos los huecos deben haber vuelto al pool:
+
+            suite.check
+            (
+                "memory", "pool threads return their slots",
+                [] (std::string & detail)
+                {
+                    const unsigned thread_count = 4;
+                    const unsigned object_count = 1000;
+
+                    Object_Pool< Particle >                pool;
+                    std::vector< std::vector< Particle * > > objects(thread_count);
+                    std::vector< std::thread >               threads;
+
+                    for (unsigned thread = 0; thread < thread_count; ++thread)
+                    {
+                        threads.emplace_back
+                        (
+                            [&pool, &objects, thread] ()
+                            {
+                                for (unsigned index = 0; index < object_count; ++index)
+                                {
+                                    objects[thread].push_back (pool.create ());
+                                }
+                            }
+                        );
+                    }
+
+                    for (auto & thread : threads) thread.join ();
+
+                    threads.clear ();
+
+                    for (unsigned thread = 0; thread < thread_count; ++thread)
+                    {
+                        threads.emplace_back
+                        (
+                            [&pool, &objects, thread] ()
+                            {
+                                for (Particle * particle : objects[(thread + 1) % thread_count])
+                                {
+                                    pool.destroy (particle);
+                                }
+                            }
+                        );
+                    }
+
+                    for (auto & thread : threads) thread.join ();
+
+                    Object_Pool_Base::Statistics statistics = pool.get_statistics ();
+
+                    detail =
+                        std::to_string (statistics.allocations  ) + " allocations, " +
+                        std::to_string (statistics.deallocations) + " deallocations, " +
+                        std::to_string (statistics.live         ) + " alive";
+
+                    return statistics.allocations   == thread_count * object_count
+                        && statistics.deallocations == thread_count * object_count
+                        && statistics.live          == 0
+                        && pool.trim ();
+                }
+            );
+        }
+
+
+        // -----------------------------------------------------------------------------------------
+
+        void run_log_checks (Suite & suite)
+        {
+            // Cada hilo que escribe toma un buffer de unos 64 KB. Los de los hilos que terminan se
+            // deben reutilizar en lugar de acumularse:
+
+            suite.check
+            (
+                "log", "ended threads' rings are reused",
+                [] (std::string & detail)
+                {
+                    const unsigned thread_count = 16;
+
+                    log.set_system_output (false);
+
+                    size_t rings_before = log.get_ring_count ();
+
+                    for (unsigned thread = 0; thread < thread_count; ++thread)
+                    {
+                        std::thread ([thread] () { log.i ("thread ", thread); }).join ();
+
+                        log.flush ();
+                    }
+
+                    size_t rings_created = log.get_ring_count () - rings_before;
+
+                    log.set_system_output (true);
+
+                    detail = std::to_string (rings_created) + " rings for " + std::to_string (thread_count) + " consecutive threads";
+
+                    return rings_created <= 1;
+                }
+            );
+        }
+
+
+        // -----------------------------------------------------------------------------------------
+
+        void run_profiler_checks (Suite & suite)
+        {
+            // Los buffers del profiler ocupan unos 512 KB por hilo y se reutilizan igual que los
+            // del log:
+
+            suite.check
+            (
+                "profiler", "ended threads' rings are reused",
+                [] (std::string & detail)
+                {
+                    const unsigned thread_count = 16;
+
+                    size_t rings_before = profiler.get_ring_count ();
+
+                    for (unsigned thread = 0; thread < thread_count; ++thread)
+                    {
+                        std::thread
+                        (
+                            [] ()
+                            {
+                                Profiler::begin_zone ("check");
+                                Profiler::end_zone   ("check");
+                            }
+                        )
+                        .join ();
+                    }
+
+                    size_t rings_created = profiler.get_ring_count () - rings_before;
+
+                    detail = std::to_string (rings_created) + " rings for " + std::to_string (thread_count) + " consecutive threads";
+
+                    return rings_created <= 1;
+                }
+            );
+
+            // reset() no vacía los buffers mientras otro hilo escribe en ellos, sino que deja de
+            // exportar lo registrado antes:
+
+            suite.check
+            (
+                "profiler", "reset while another thread records",
+                [] (std::string & detail)
+                {
+                    std::atomic< bool > started(false);
+                    std::atomic< bool > stop   (false);
+
+                    std::thread recorder
+                    (
+                        [&started, &stop] ()
+                        {
+                            Profiler::begin_zone ("before reset");
+                            Profiler::end_zone   ("before reset");
+
+                            started = true;
+
+                            while (!stop)
+                            {
+                                Profiler::begin_zone ("during reset");
+                                Profiler::end_zone   ("during reset");
+                            }
+                        }
+                    );
+
+                    while (!started) std::this_thread::yield ();
+
+                    for (unsigned index = 0; index < 100; ++index) profiler.reset ();
+
+                    stop = true;
+
+                    recorder.join ();
+
+                    Profiler::begin_zone ("after reset");
+                    Profiler::end_zone   ("after reset");
+
+                    std::ostringstream trace;
+
+                    profiler.write_chrome_trace (trace);
+
+                    bool before = trace.str ().find ("\"before reset\"") != std::string::npos;
+                    bool after  = trace.str ().find ("\"after reset\"" ) != std::string::npos;
+
+                    detail = std::string(before ? "records before reset exported" : "records before reset discarded") +
+                             (after ? ", records after reset exported" : ", records after reset missing");
+
+                    profiler.reset ();
+
+                    return !before && after;
+                }
+            );
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void run_core_benchmarks (Suite & suite)
+    {
+        run_event_queue_benchmarks (suite);
+        run_hash_benchmarks        (suite);
+        run_var_benchmarks         (suite);
+        run_allocation_benchmarks  (suite);
+        run_log_checks             (suite);
+        run_profiler_checks        (suite);
+    }
+
+}
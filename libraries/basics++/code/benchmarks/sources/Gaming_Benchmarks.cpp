@@ -0,0 +1,384 @@
+/*
+ * GAMING BENCHMARKS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802231100
+ */
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <basics/Atlas>
+#include <basics/Broad_Phase>
+#include <basics/Entity_Store>
+#include <basics/Particle_System>
+#include <basics/Sprite_Animator>
+#include <basics/Texture_2D>
+#include <basics/Tweener>
+#include "Benchmark.hpp"
+
+using namespace basics;
+
+namespace benchmarks
+{
+
+    namespace
+    {
+
+        const float frame_time = 1.f / 60.f;
+
+        /**
+         * Textura con tamaño pero sin recursos en la GPU, para los atlas que solo se usan por sus
+         * coordenadas.
+         */
+        struct Detached_Texture : public Texture_2D
+        {
+
+            Detached_Texture(unsigned width, unsigned height) : Texture_2D(width, height)
+            {
+            }
+
+            bool initialize () override { return true; }
+            void finalize   () override { }
+
+        };
+
+        // Crea entidades repartidas en un área de 4000x4000 con velocidades aleatorias. La semilla
+        // es fija para que todas las ejecuciones midan exactamente lo mismo:
+
+        void populate (Entity_Store & store, size_t count, std::vector< Entity_Store::Handle > * handles = nullptr)
+        {
+            std::minstd_rand                        random(1234);
+            std::uniform_real_distribution< float > position(0.f, 4000.f);
+            std::uniform_real_distribution< float > speed   (-100.f, 100.f);
+            std::uniform_real_distribution< float > size    (8.f, 64.f);
+
+            const Texture_2D * no_texture = nullptr;
+
+            store.reserve (count);
+
+            for (size_t index = 0; index < count; ++index)
+            {
+                float side = size (random);
+
+                Entity_Store::Handle handle = store.create (no_texture, { side, side });
+
+                store.set_position (handle, { position (random), position (random) });
+                store.set_speed    (handle, { speed    (random), speed    (random) });
+
+                if (handles) handles->push_back (handle);
+            }
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        void run_entity_benchmarks (Suite & suite)
+        {
+            const size_t count = 10000;
+
+            Entity_Store store;
+
+            populate (store, count);
+
+            // Se alterna el signo del tiempo para que las entidades oscilen en lugar de alejarse
+            // sin límite durante las miles de iteraciones de cada muestra:
+
+            float time = frame_time;
+
+            suite.run
+            (
+                "entities", "move 10000", count,
+                [&store, &time] ()
+                {
+                    store.move (time = -time);
+                }
+            );
+
+            // Por encima de Entity_Store::parallel_threshold el movimiento se reparte entre los
+            // hilos del Worker_Pool. Se mide siempre con varios hilos, aunque solo haya un núcleo,
+            // para ver lo que cuesta repartir además de lo que se gana:
+
+            {
+                const size_t large_count = 262144;
+
+                Entity_Store large_store;
+
+                populate (large_store, large_count);
+
+                // Repartir el trabajo no debe cambiar el resultado:
+
+                suite.check
+                (
+                    "entities", "parallel move matches serial",
+                    [large_count] (std::string & detail)
+                    {
+                        Entity_Store serial, parallel;
+
+                        populate (serial,   large_count);
+                        populate (parallel, large_count);
+
+                        serial  .set_worker_count (1);
+                        parallel.set_worker_count (4);
+
+                        for (unsigned frame = 0; frame < 3; ++frame)
+                        {
+                            serial  .move (frame_time);
+                            parallel.move (frame_time);
+                        }
+
+                        size_t differences = 0;
+
+                        for (size_t index = 0; index < large_count; ++index)
+                        {
+                            if (serial.get_position (serial.get_handle (index)) != parallel.get_position (parallel.get_handle (index))) ++differences;
+                        }
+
+                        detail = std::to_string (differences) + " different positions";
+
+                        return differences == 0;
+                    }
+                );
+
+                for (unsigned workers : { 1u, std::max (std::thread::hardware_concurrency (), 2u) })
+                {
+                    large_store.set_worker_count (workers);
+
+                    suite.run
+                    (
+                        "entities", "move 262144 (" + std::to_string (workers) + (workers == 1 ? " worker)" : " workers)"), large_count,
+                        [&large_store, &time] ()
+                        {
+                            large_store.move (time = -time);
+                        }
+                    );
+                }
+            }
+
+            // Destruir mueve la última entidad al hueco, pero el orden de dibujado debe seguir siendo
+            // el de creación:
+
+            suite.check
+            (
+                "entities", "destroy keeps draw order",
+                [] (std::string & detail)
+                {
+                    Entity_Store                        store;
+                    std::vector< Entity_Store::Handle > handles;
+
+                    populate (store, 1000, &handles);
+
+                    std::vector< Entity_Store::Handle > survivors;
+
+                    for (size_t index = 0; index < handles.size (); ++index)
+                    {
+                        if (index % 3 == 0) store.destroy (handles[index]); else survivors.push_back (handles[index]);
+                    }
+
+                    const std::vector< uint32_t > & visible = store.filter_visible ();
+
+                    if (visible.size () != survivors.size ())
+                    {
+                        detail = std::to_string (visible.size ()) + " visible entities, expected " + std::to_string (survivors.size ());
+                        return false;
+                    }
+
+                    for (size_t index = 0; index < visible.size (); ++index)
+                    {
+                        if (store.get_handle (visible[index]) != survivors[index])
+                        {
+                            detail = "entity " + std::to_string (index) + " is drawn out of order";
+                            return false;
+                        }
+                    }
+
+                    detail = std::to_string (visible.size ()) + " entities in creation order";
+
+                    return true;
+                }
+            );
+
+            // Lo que cuesta llenar un nivel y vaciarlo destruyendo las entidades una a una:
+
+            {
+                Entity_Store                        doomed;
+                std::vector< Entity_Store::Handle > handles;
+
+                suite.run
+                (
+                    "entities", "create and destroy 10000", count,
+                    [&doomed, &handles, count] ()
+                    {
+                        doomed.clear ();
+                        handles.clear ();
+
+                        populate (doomed, count, &handles);
+
+                        for (const Entity_Store::Handle & handle : handles) doomed.destroy (handle);
+
+                        keep (doomed.filter_visible ().size ());
+                    }
+                );
+            }
+
+            // 10000 cajas que se mueven en cada fotograma, como en los niveles más cargados:
+
+            Broad_Phase broad_phase;
+
+            for (size_t index = 0; index < store.size (); ++index)
+            {
+                broad_phase.add (store, store.get_handle (index));
+            }
+
+            suite.run
+            (
+                "broad_phase", "10000 moving boxes", count,
+                [&store, &broad_phase, &time] ()
+                {
+                    store.move (time = -time);
+
+                    broad_phase.synchronize (store, time);
+
+                    keep (broad_phase.update ().size ());
+                }
+            );
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        void run_particle_benchmarks (Suite & suite)
+        {
+            const size_t count = 100000;
+
+            Particle_System  particles(count);
+            Particle_Emitter emitter;
+
+            // Las partículas no mueren durante el benchmark para que siempre se procesen todas:
+
+            emitter.position     = { 640.f, 360.f };
+            emitter.min_lifetime = 1e6f;
+            emitter.max_lifetime = 1e6f;
+
+            particles.set_seed (1234);
+            particles.burst    (emitter, unsigned(count));
+
+            suite.run
+            (
+                "particles", "update 100000", count,
+                [&particles] ()
+                {
+                    particles.update (frame_time);
+                }
+            );
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        void run_tween_benchmarks (Suite & suite)
+        {
+            const size_t count = 10000;
+
+            std::vector< float > values(count);
+            Tweener              tweener;
+
+            tweener.reserve (count);
+
+            for (size_t index = 0; index < count; ++index)
+            {
+                tweener.add (&values[index], 0.f, 1.f, 1e6f, Tweener::Easing(index % 5));
+            }
+
+            suite.run
+            (
+                "tweener", "update 10000", count,
+                [&tweener] ()
+                {
+                    tweener.update (frame_time);
+                }
+            );
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        void run_animation_benchmarks (Suite & suite)
+        {
+            const size_t   count  = 10000;
+            const unsigned frames = 8;
+
+            // Un atlas de 256x32 píxeles con las slices de una animación de 8 fotogramas. Solo se
+            // usan sus coordenadas, por lo que la textura no llega a subirse a la GPU:
+
+            Atlas atlas(std::make_shared< Detached_Texture > (frames * 32, 32));
+
+            for (unsigned frame = 0; frame < frames; ++frame)
+            {
+                atlas.add_slice (fnv32 ("walk" + std::to_string (frame)), { float(frame * 32), 0.f }, { 32.f, 32.f });
+            }
+
+            // Las coordenadas de textura de los slices deben quedar normalizadas:
+
+            suite.check
+            (
+                "atlas", "normalized slice coordinates",
+                [&atlas] (std::string & detail)
+                {
+                    const Atlas::Slice * last = atlas.get_slice (fnv32 ("walk" + std::to_string (frames - 1)));
+
+                    if (!last)
+                    {
+                        detail = "missing slice";
+                        return false;
+                    }
+
+                    detail = "u from " + std::to_string (last->u_left) + " to " + std::to_string (last->u_right) +
+                             ", v from " + std::to_string (last->v_bottom) + " to " + std::to_string (last->v_top);
+
+                    return last->u_left == .875f && last->u_right == 1.f && last->v_bottom == 0.f && last->v_top == 1.f;
+                }
+            );
+
+            Entity_Store                        store;
+            std::vector< Entity_Store::Handle > handles;
+            Sprite_Animator                     animator;
+
+            populate (store, count, &handles);
+
+            Sprite_Animator::Clip walk = animator.add_clip (atlas, "walk", frames, 12.f);
+
+            animator.reserve (count);
+
+            for (size_t index = 0; index < count; ++index)
+            {
+                animator.play (store, handles[index], walk, .5f + float(index % 4) * .25f);
+            }
+
+            suite.run
+            (
+                "sprite_animator", "update 10000", count,
+                [&animator, &store] ()
+                {
+                    animator.update (frame_time, store);
+                }
+            );
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void run_gaming_benchmarks (Suite & suite)
+    {
+        run_entity_benchmarks    (suite);
+        run_particle_benchmarks  (suite);
+        run_tween_benchmarks     (suite);
+        run_animation_benchmarks (suite);
+    }
+
+}
@@ -0,0 +1,63 @@
+/*
+ *  GENERIC FLOAT
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C1802231100
+ */
+
+#ifndef BASICS_BENCHMARKS_GENERIC_FLOAT_HEADER
+#define BASICS_BENCHMARKS_GENERIC_FLOAT_HEADER
+
+    #include <basics/Matrix>
+
+    namespace benchmarks
+    {
+
+        /**
+         * Float que no coincide con las especializaciones SSE/NEON de Matrix, por lo que sus
+         * productos usan la plantilla genérica con las mismas operaciones escalares que haría con
+         * float. Sirve de referencia para comprobar y medir las especializaciones.
+         */
+        struct Generic_Float
+        {
+            float value;
+
+            Generic_Float() = default;
+
+            constexpr Generic_Float(float value) : value(value)
+            {
+            }
+
+            Generic_Float & operator += (Generic_Float other)
+            {
+                value += other.value;
+                return *this;
+            }
+
+            friend Generic_Float operator * (Generic_Float a, Generic_Float b)
+            {
+                return a.value * b.value;
+            }
+        };
+
+        template< unsigned M, unsigned N >
+        using Generic_Matrix = basics::Matrix< M, N, Generic_Float >;
+
+        template< unsigned M, unsigned N >
+        Generic_Matrix< M, N > to_generic (const basics::Matrix< M, N, float > & matrix)
+        {
+            Generic_Matrix< M, N > result;
+
+            for (unsigned index = 0; index < M * N; ++index) result.values[index] = matrix.values[index];
+
+            return result;
+        }
+
+    }
+
+#endif
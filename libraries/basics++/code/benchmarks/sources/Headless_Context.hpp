@@ -0,0 +1,123 @@
+/*
+ *  HEADLESS CONTEXT
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C1802231100
+ */
+
+#ifndef BASICS_HEADLESS_CONTEXT_HEADER
+#define BASICS_HEADLESS_CONTEXT_HEADER
+
+    #include <memory>
+    #include <basics/Window>
+    #include <basics/opengles/Context>
+
+    namespace benchmarks
+    {
+
+        using namespace basics;
+
+        /**
+         * Ventana sin superficie real que solo sirve para poder crear un contexto gráfico.
+         */
+        class Headless_Window final : public Window
+        {
+
+            Size2u size;
+
+        public:
+
+            Headless_Window(const Size2u & size) : Window(ID(headless-window)), size(size)
+            {
+                available = true;
+            }
+
+        public:
+
+            Size2u   get_size   () override { return size;        }
+            unsigned get_width  () override { return size.width;  }
+            unsigned get_height () override { return size.height; }
+
+        };
+
+        // -----------------------------------------------------------------------------------------
+
+        /**
+         * Contexto de OpenGL ES 2 que no crea ninguna superficie. Se compila con
+         * BASICS_OPENGLES_GL_STUB, por lo que las llamadas gl* que hacen Canvas_ES2, Texture_2D, etc.
+         * van a la implementación en CPU de GL_Recorder y se pueden cronometrar sin GPU.
+         */
+        class Headless_Context final : public opengles::Context
+        {
+
+            Size2u size;
+
+        public:
+
+            Headless_Context(Window & window) : opengles::Context(window, nullptr), size(window.get_size ())
+            {
+                version = VERSION_2_0;
+            }
+
+        public:
+
+            void invalidate () override { }
+            void suspend    () override { }
+            bool resume     () override { return true; }
+
+            bool is_available () const override { return true; }
+            bool is_current   () const override { return true; }
+
+            unsigned get_surface_width  () override { return size.width;  }
+            unsigned get_surface_height () override { return size.height; }
+
+            bool set_sync_swap  (bool ) override { return true; }
+            void reset_viewport () override { }
+            void set_viewport   (const Point2u & , const Size2u & ) override { }
+
+            bool make_current () override
+            {
+                return true;
+            }
+
+            bool flush_and_display () override
+            {
+                return true;
+            }
+
+        };
+
+        // -----------------------------------------------------------------------------------------
+
+        /**
+         * Ventana y contexto listos para usar. Mientras exista el accesor de context el contexto
+         * está bloqueado, como cuando Director llama a Scene::render().
+         */
+        struct Headless_Graphics
+        {
+            Headless_Window            window;
+            Graphics_Context::Accessor context;
+
+            Headless_Graphics(const Size2u & size) : window(size), context(lock (window))
+            {
+            }
+
+        private:
+
+            static Graphics_Context::Accessor lock (Headless_Window & window)
+            {
+                window.set_graphics_context (std::make_shared< Headless_Context > (window));
+
+                return window.lock_graphics_context ();
+            }
+
+        };
+
+    }
+
+#endif
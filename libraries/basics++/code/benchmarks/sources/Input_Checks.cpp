@@ -0,0 +1,221 @@
+/*
+ * INPUT CHECKS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802231100
+ */
+
+#include <set>
+#include <string>
+#include <basics/Touch_Packet>
+#include "Benchmark.hpp"
+
+using namespace basics;
+
+namespace benchmarks
+{
+
+    namespace
+    {
+
+        struct Touch
+        {
+            int32_t             pointer_id;
+            Touch_Packet::Phase phase;
+            float               x;
+            float               y;
+            int64_t             timestamp;
+            uint8_t             flags;
+        };
+
+        /**
+         * Compara la muestra index del paquete con la esperada y describe la primera diferencia.
+         */
+        bool check_sample (const Touch_Packet & packet, size_t index, const Touch & expected, std::string & detail)
+        {
+            if
+            (
+                packet.get_pointer_id (index) == expected.pointer_id &&
+                packet.get_phase      (index) == expected.phase      &&
+                packet.get_x          (index) == expected.x          &&
+                packet.get_y          (index) == expected.y          &&
+                packet.get_timestamp  (index) == expected.timestamp  &&
+                packet.get_flags ()  [index]  == expected.flags
+            )
+            {
+                return true;
+            }
+
+            detail =
+                "sample " + std::to_string (index) + " is pointer " + std::to_string (packet.get_pointer_id (index)) +
+                " at (" + std::to_string (packet.get_x (index)) + ", " + std::to_string (packet.get_y (index)) + ")" +
+                ", expected pointer " + std::to_string (expected.pointer_id) +
+                " at (" + std::to_string (expected.x) + ", " + std::to_string (expected.y) + ")";
+
+            return false;
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        void run_touch_packet_checks (Suite & suite)
+        {
+            // Tres dedos que empiezan, se mueven y uno que se levanta, como los añade el
+            // dispatcher de Android (la muestra histórica va antes que la actual):
+
+            suite.check
+            (
+                "touch_packet", "several pointers and a removal",
+                [] (std::string & detail)
+                {
+                    const uint8_t historical = Touch_Packet::HISTORICAL;
+                    const uint8_t primary    = Touch_Packet::PRIMARY;
+
+                    const Touch touches[] =
+                    {
+                        { 0, Touch_Packet::STARTED, 10.f, 20.f, 1, primary              },
+                        { 1, Touch_Packet::STARTED, 30.f, 40.f, 2, 0                    },
+                        { 2, Touch_Packet::STARTED, 50.f, 60.f, 3, 0                    },
+                        { 0, Touch_Packet::MOVED,   11.f, 21.f, 4, historical | primary },
+                        { 0, Touch_Packet::MOVED,   12.f, 22.f, 5, primary              },
+                        { 1, Touch_Packet::ENDED,   31.f, 41.f, 6, 0                    },
+                        { 2, Touch_Packet::MOVED,   52.f, 62.f, 7, 0                    },
+                    };
+
+                    const size_t touch_count = sizeof(touches) / sizeof(touches[0]);
+
+                    Touch_Packet packet;
+
+                    for (const Touch & touch : touches)
+                    {
+                        packet.add (touch.pointer_id, touch.phase, touch.x, touch.y, touch.timestamp, touch.flags);
+                    }
+
+                    if (packet.size () != touch_count)
+                    {
+                        detail = std::to_string (packet.size ()) + " samples, expected " + std::to_string (touch_count);
+                        return false;
+                    }
+
+                    for (size_t index = 0; index < touch_count; ++index)
+                    {
+                        if (!check_sample (packet, index, touches[index], detail)) return false;
+                    }
+
+                    // Los dedos que siguen en la pantalla al final del paquete:
+
+                    std::set< int32_t > down;
+
+                    for (size_t index = 0; index < packet.size (); ++index)
+                    {
+                        switch (packet.get_phase (index))
+                        {
+                            case Touch_Packet::STARTED:   down.insert (packet.get_pointer_id (index)); break;
+                            case Touch_Packet::ENDED:
+                            case Touch_Packet::CANCELLED: down.erase  (packet.get_pointer_id (index)); break;
+                            default: break;
+                        }
+                    }
+
+                    if (down != std::set< int32_t >{ 0, 2 })
+                    {
+                        detail = std::to_string (down.size ()) + " pointers down, expected pointers 0 and 2";
+                        return false;
+                    }
+
+                    detail = std::to_string (packet.size ()) + " samples";
+
+                    return packet.get_coalesced_count () == 0 && packet.get_dropped_count () == 0;
+                }
+            );
+
+            // Con el paquete lleno, un movimiento sustituye al último movimiento de su dedo y un
+            // final desplaza al movimiento más antiguo. Si no quedan movimientos, se descarta:
+
+            suite.check
+            (
+                "touch_packet", "full packet",
+                [] (std::string & detail)
+                {
+                    const size_t capacity = Touch_Packet::capacity;
+
+                    Touch_Packet packet;
+
+                    packet.add (0, Touch_Packet::STARTED, 0.f, 0.f, 0);
+                    packet.add (1, Touch_Packet::STARTED, 0.f, 0.f, 1);
+
+                    for (size_t index = 2; index < capacity; ++index)
+                    {
+                        packet.add (int32_t(index % 2), Touch_Packet::MOVED, float(index), float(index), int64_t(index));
+                    }
+
+                    bool added_move = packet.add (1, Touch_Packet::MOVED, 999.f, 998.f, 1000);
+
+                    if (!added_move || packet.size () != capacity || packet.get_coalesced_count () != 1)
+                    {
+                        detail = "a move into a full packet wasn't coalesced";
+                        return false;
+                    }
+
+                    if (!check_sample (packet, capacity - 1, { 1, Touch_Packet::MOVED, 999.f, 998.f, 1000, 0 }, detail))
+                    {
+                        return false;
+                    }
+
+                    bool added_end = packet.add (0, Touch_Packet::ENDED, 5.f, 6.f, 1001);
+
+                    if (!added_end || packet.size () != capacity || packet.get_coalesced_count () != 2)
+                    {
+                        detail = "an end into a full packet didn't displace a move";
+                        return false;
+                    }
+
+                    if
+                    (
+                        !check_sample (packet, 0,            { 0, Touch_Packet::STARTED, 0.f, 0.f,    0, 0 }, detail) ||
+                        !check_sample (packet, 1,            { 1, Touch_Packet::STARTED, 0.f, 0.f,    1, 0 }, detail) ||
+                        !check_sample (packet, 2,            { 1, Touch_Packet::MOVED,   3.f, 3.f,    3, 0 }, detail) ||
+                        !check_sample (packet, capacity - 1, { 0, Touch_Packet::ENDED,   5.f, 6.f, 1001, 0 }, detail)
+                    )
+                    {
+                        return false;
+                    }
+
+                    // Un paquete lleno solo de inicios no tiene movimientos que sacrificar:
+
+                    Touch_Packet starts;
+
+                    for (size_t index = 0; index < capacity; ++index)
+                    {
+                        starts.add (int32_t(index), Touch_Packet::STARTED, 0.f, 0.f, int64_t(index));
+                    }
+
+                    bool added_start = starts.add (int32_t(capacity), Touch_Packet::STARTED, 0.f, 0.f, 0);
+
+                    if (added_start || starts.size () != capacity || starts.get_dropped_count () != 1)
+                    {
+                        detail = "a start into a packet full of starts wasn't dropped";
+                        return false;
+                    }
+
+                    detail = std::to_string (capacity) + " samples";
+
+                    return true;
+                }
+            );
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void run_input_checks (Suite & suite)
+    {
+        run_touch_packet_checks (suite);
+    }
+
+}
@@ -0,0 +1,219 @@
+/*
+ * MATH BENCHMARKS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802231100
+ */
+
+#include <vector>
+#include <basics/Affine2>
+#include <basics/Kernels>
+#include <basics/Matrix>
+#include <basics/Rotation>
+#include <basics/Scaling>
+#include <basics/Transformation>
+#include <basics/Translation>
+#include "Benchmark.hpp"
+#include "Generic_Float.hpp"
+
+using namespace basics;
+
+namespace benchmarks
+{
+
+    namespace
+    {
+
+        // Los productos de floats 3x3 y 4x4 usan SSE/NEON si están disponibles. Los de
+        // Generic_Float hacen las mismas operaciones con floats en la plantilla genérica, por lo
+        // que son la referencia escalar con la que compararlos. Los de doubles también usan la
+        // plantilla genérica, pero con el doble de precisión:
+
+        #if defined(BASICS_MATH_SIMD)
+            const char * const float_path = " (simd)";
+        #else
+            const char * const float_path = " (scalar)";
+        #endif
+
+        template< typename MATRIX >
+        MATRIX make_matrix (float seed)
+        {
+            MATRIX matrix;
+
+            for (unsigned row = 0; row < MATRIX::number_of_rows; ++row)
+            {
+                for (unsigned column = 0; column < MATRIX::number_of_columns; ++column)
+                {
+                    matrix[row][column] = typename MATRIX::Number(seed + float(row * 7 + column) * .125f);
+                }
+            }
+
+            return matrix;
+        }
+
+        template< typename MATRIX >
+        void run_product (Suite & suite, const std::string & name)
+        {
+            MATRIX a = make_matrix< MATRIX > (1.f);
+            MATRIX b = make_matrix< MATRIX > (2.f);
+
+            suite.run
+            (
+                "matrix", name, 1,
+                [&a, &b] ()
+                {
+                    keep (a);
+                    keep (b);
+
+                    MATRIX result = a * b;
+
+                    keep (result);
+                }
+            );
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        void run_matrix_benchmarks (Suite & suite)
+        {
+            run_product< Matrix33f              > (suite, std::string("product 3x3 float" ) + float_path);
+            run_product< Generic_Matrix< 3, 3 > > (suite, std::string("product 3x3 float (generic)"));
+            run_product< Matrix33d              > (suite, std::string("product 3x3 double (scalar)"));
+            run_product< Matrix44f              > (suite, std::string("product 4x4 float" ) + float_path);
+            run_product< Generic_Matrix< 4, 4 > > (suite, std::string("product 4x4 float (generic)"));
+            run_product< Matrix44d              > (suite, std::string("product 4x4 double (scalar)"));
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        void run_transformation_benchmarks (Suite & suite)
+        {
+            float    angle        = .5f;
+            float    scale        = 1.5f;
+            Vector2f displacement = { 640.f, 360.f };
+
+            suite.run
+            (
+                "transformation", "rotate_then_translate_2d", 1,
+                [&] ()
+                {
+                    keep (angle);
+
+                    Transformation2f transformation = rotate_then_translate_2d (angle, displacement);
+
+                    keep (transformation);
+                }
+            );
+
+            suite.run
+            (
+                "transformation", "scale_then_translate_2d", 1,
+                [&] ()
+                {
+                    keep (scale);
+
+                    Transformation2f transformation = scale_then_translate_2d (scale, displacement);
+
+                    keep (transformation);
+                }
+            );
+
+            // Lo que hace un sprite al calcular su transformación completa:
+
+            suite.run
+            (
+                "transformation", "translation*rotation*scaling", 1,
+                [&] ()
+                {
+                    keep (angle);
+                    keep (scale);
+
+                    Transformation2f transformation = Translation2f(displacement) * Rotation2f(angle) * Scaling2f(scale);
+
+                    keep (transformation);
+                }
+            );
+
+            suite.run
+            (
+                "transformation", "affine2 translation*rotation*scaling", 1,
+                [&] ()
+                {
+                    keep (angle);
+                    keep (scale);
+
+                    Affine2f affine = Affine2f::translation (640.f, 360.f) * Affine2f::rotation (angle) * Affine2f::scaling (scale);
+
+                    keep (affine);
+                }
+            );
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        void run_kernel_benchmarks (Suite & suite)
+        {
+            const size_t count = 4096;
+
+            std::vector< float > xs(count), ys(count), out_xs(count), out_ys(count), angles(count);
+
+            for (size_t index = 0; index < count; ++index)
+            {
+                xs    [index] = float(index % 640);
+                ys    [index] = float(index / 640);
+                angles[index] = float(index) * .001f;
+            }
+
+            Affine2f affine = Affine2f::rotation_then_translation (.5f, .8660254f, 10.f, 20.f);
+
+            suite.run
+            (
+                "kernels", "transform 4096 points", count,
+                [&] ()
+                {
+                    kernels::transform (affine, xs.data (), ys.data (), out_xs.data (), out_ys.data (), xs.size ());
+
+                    keep (out_xs.front ());
+                }
+            );
+
+            suite.run
+            (
+                "kernels", "sincos 4096 angles", count,
+                [&] ()
+                {
+                    kernels::sincos (angles.data (), out_xs.data (), out_ys.data (), count);
+
+                    keep (out_xs.front ());
+                }
+            );
+
+            suite.run
+            (
+                "kernels", "bounds 4096 points", count,
+                [&] ()
+                {
+                    kernels::Bounds2f bounds = kernels::bounds (xs.data (), ys.data (), count);
+
+                    keep (bounds);
+                }
+            );
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void run_math_benchmarks (Suite & suite)
+    {
+        run_matrix_benchmarks         (suite);
+        run_transformation_benchmarks (suite);
+        run_kernel_benchmarks         (suite);
+    }
+
+}
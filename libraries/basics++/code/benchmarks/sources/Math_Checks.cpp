@@ -0,0 +1,125 @@
+/*
+ * MATH CHECKS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802231100
+ */
+
+#include <cfloat>
+#include <cmath>
+#include <random>
+#include <string>
+#include <basics/Matrix>
+#include "Benchmark.hpp"
+#include "Generic_Float.hpp"
+
+using namespace basics;
+
+namespace benchmarks
+{
+
+    namespace
+    {
+
+        const unsigned sample_count = 100000;
+
+        // Valores con signos y magnitudes variadas (de 2^-8 a 2^8) para que las sumas de los
+        // productos redondeen de formas distintas:
+
+        template< unsigned M, unsigned N >
+        Matrix< M, N, float > make_random_matrix (std::mt19937 & random)
+        {
+            std::uniform_real_distribution< float > mantissa(-1.f, 1.f);
+            std::uniform_int_distribution < int   > exponent(-8, 8);
+
+            Matrix< M, N, float > matrix;
+
+            for (float & value : matrix.values) value = std::ldexp (mantissa (random), exponent (random));
+
+            return matrix;
+        }
+
+        /**
+         * Compara el producto de floats (SSE/NEON si están disponibles) con el de la plantilla
+         * genérica. Cada elemento puede diferir como mucho en 2·N·FLT_EPSILON·Σ|aᵢ·bᵢ|, que es el
+         * doble de la cota del error de redondeo de una suma de N productos, y deben coincidir bit
+         * a bit cuando no se fusionan multiplicaciones y sumas (-ffp-contract=off y
+         * BASICS_MATH_NO_FMA).
+         */
+        template< unsigned M, unsigned N, unsigned P >
+        void check_product (Suite & suite, const std::string & name)
+        {
+            suite.check
+            (
+                "matrix", name,
+                [] (std::string & detail)
+                {
+                    std::mt19937 random(1234);
+
+                    unsigned exact_count   = 0;
+                    unsigned failure_count = 0;
+
+                    for (unsigned sample = 0; sample < sample_count; ++sample)
+                    {
+                        Matrix< M, N, float > a = make_random_matrix< M, N > (random);
+                        Matrix< N, P, float > b = make_random_matrix< N, P > (random);
+
+                        Matrix< M, P, float > simd    = a * b;
+                        Generic_Matrix< M, P > generic = to_generic (a) * to_generic (b);
+
+                        bool exact = true;
+
+                        for (unsigned r = 0; r < M; ++r)
+                        {
+                            for (unsigned c = 0; c < P; ++c)
+                            {
+                                float magnitude = 0.f;
+
+                                for (unsigned index = 0; index < N; ++index)
+                                {
+                                    magnitude += std::fabs (a[r][index] * b[index][c]);
+                                }
+
+                                float difference = std::fabs (simd[r][c] - generic[r][c].value);
+
+                                if (difference != 0.f) exact = false;
+
+                                if (difference > 2.f * N * FLT_EPSILON * magnitude) ++failure_count;
+                            }
+                        }
+
+                        if (exact) ++exact_count;
+                    }
+
+                    detail = std::to_string (exact_count) + " of " + std::to_string (sample_count) + " bit-exact";
+
+                    if (failure_count > 0) detail += ", " + std::to_string (failure_count) + " elements out of tolerance";
+
+                    // El proyecto de los benchmarks compila sin fusionar multiplicaciones y sumas,
+                    // por lo que en ese caso se exige que coincidan bit a bit:
+
+                    #if defined(BASICS_MATH_NO_FMA)
+                        return failure_count == 0 && exact_count == sample_count;
+                    #else
+                        return failure_count == 0;
+                    #endif
+                }
+            );
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void run_math_checks (Suite & suite)
+    {
+        check_product< 3, 3, 3 > (suite, "simd vs generic 3x3*3x3");
+        check_product< 4, 4, 4 > (suite, "simd vs generic 4x4*4x4");
+    }
+
+}
@@ -0,0 +1,358 @@
+/*
+ * RENDER BENCHMARKS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802231100
+ */
+
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <basics/Asset>
+#include <basics/Camera>
+#include <basics/Canvas>
+#include <basics/Entity_Store>
+#include <basics/Frame_Arena>
+#include <basics/Particle_System>
+#include <basics/Raster_Font>
+#include <basics/Render_Statistics>
+#include <basics/Text_Layout>
+#include <basics/Texture_2D>
+#include <basics/opengles/GL_Recorder>
+#include "Benchmark.hpp"
+#include "Headless_Context.hpp"
+#include "Menu_Layout.hpp"
+
+using namespace basics;
+
+namespace benchmarks
+{
+
+    namespace
+    {
+
+        const unsigned canvas_width  = 1280;
+        const unsigned canvas_height =  720;
+
+        /**
+         * Escena de prueba parecida a un fotograma de juego: fondo, sprites, partículas, un panel y
+         * textos del marcador.
+         */
+        class Benchmark_Scene
+        {
+
+            std::shared_ptr< Texture_2D  > background;
+            std::shared_ptr< Texture_2D  > sprite;
+            std::unique_ptr< Raster_Font > font;
+            Entity_Store                   entities;
+            Particle_System                particles;
+            unsigned                       score;
+
+        public:
+
+            Benchmark_Scene(Graphics_Context::Accessor & context, size_t sprite_count, size_t particle_count)
+            :
+                particles(particle_count),
+                score    (0)
+            {
+                background = Texture_2D::create (ID(background), context, "game-scene/background.png");
+                sprite     = Texture_2D::create (ID(sprite),     context, "game-scene/click.png");
+
+                if (background) context->add (background);
+                if (sprite    ) context->add (sprite    );
+
+                font.reset (new Raster_Font("game-scene/fonts/impact.fnt", context));
+
+                std::minstd_rand                        random(1234);
+                std::uniform_real_distribution< float > x(0.f, float(canvas_width ));
+                std::uniform_real_distribution< float > y(0.f, float(canvas_height));
+
+                for (size_t index = 0; index < sprite_count; ++index)
+                {
+                    Entity_Store::Handle handle = entities.create (sprite.get (), { 64.f, 54.f });
+
+                    entities.set_position (handle, { x (random), y (random) });
+                }
+
+                // Las partículas usan como slice el glifo de un punto de la fuente:
+
+                const Raster_Font::Character * dot = font->get_character ('.');
+
+                Particle_Emitter emitter;
+
+                emitter.position     = { canvas_width * .5f, canvas_height * .5f };
+                emitter.min_lifetime = 1e6f;
+                emitter.max_lifetime = 1e6f;
+
+                particles.set_slice (dot ? dot->slice : nullptr);
+                particles.set_seed  (1234);
+                particles.burst     (emitter, unsigned(particle_count));
+            }
+
+            bool is_ready () const
+            {
+                return background && sprite && font->get_character ('0');
+            }
+
+            void render (Canvas & canvas)
+            {
+                canvas.clear ();
+
+                canvas.fill_rectangle ({ canvas_width * .5f, canvas_height * .5f }, { float(canvas_width), float(canvas_height) }, background.get ());
+
+                entities.render (canvas);
+
+                particles.render (canvas);
+
+                // Panel del marcador:
+
+                canvas.set_color      (0.f, 0.f, 0.f);
+                canvas.set_opacity    (.5f);
+                canvas.fill_rectangle ({ 0.f, canvas_height - 80.f }, { float(canvas_width), 80.f });
+                canvas.set_opacity    (1.f);
+                canvas.set_color      (1.f, 1.f, 1.f);
+
+                // Los textos cambian en cada fotograma y se construyen en la arena del fotograma:
+
+                frame::wstring text(L"Puntos: ");
+
+                text += std::to_wstring (score++).c_str ();
+
+                Text_Layout score_layout(*font, text, &frame_arena);
+                Text_Layout pause_layout(*font, L"PAUSA", &frame_arena);
+
+                canvas.draw_text ({ 20.f, canvas_height - 10.f }, score_layout);
+                canvas.draw_text ({ canvas_width - 20.f, canvas_height - 10.f }, pause_layout, TOP | RIGHT);
+            }
+
+        };
+
+        // -----------------------------------------------------------------------------------------
+
+        /**
+         * Dibuja lo mismo que Menu_Scene una vez cargada: sus texturas y sus objetos se crean con
+         * el mismo código del juego (Menu_Layout), con las instrucciones ocultas, y se ven a través
+         * de una cámara que muestra todo el canvas del menú.
+         */
+        class Menu_Frame
+        {
+
+            // Menu_Scene conserva el ancho de su canvas y ajusta el alto según la proporción de la
+            // superficie, que aquí es la del canvas de los benchmarks:
+
+            static constexpr unsigned menu_width  = 720;
+            static constexpr float    menu_aspect = float(canvas_width) / float(canvas_height);
+
+            project_template::Menu_Texture_Map textures;
+            Entity_Store                       entities;
+            project_template::Menu_Objects     objects;         ///< Se destruyen antes que entities.
+            Camera                             camera;
+            bool                               ready;
+
+        public:
+
+            Menu_Frame(Graphics_Context::Accessor & context)
+            :
+                camera({ float(menu_width), float(menu_width) * menu_aspect }),
+                ready (false)
+            {
+                for (unsigned index = 0; index < project_template::menu_textures_count; ++index)
+                {
+                    const project_template::Menu_Texture_Data & data = project_template::menu_textures_data[index];
+
+                    std::shared_ptr< Texture_2D > texture = Texture_2D::create (data.id, context, data.path);
+
+                    if (!texture) return;
+
+                    context->add (texture);
+
+                    textures[data.id] = texture;
+                }
+
+                unsigned menu_height = unsigned(menu_width * menu_aspect);
+
+                objects = project_template::create_menu_objects (entities, textures, menu_width, menu_height, menu_aspect);
+
+                camera.set_position ({ menu_width * .5f, menu_height * .5f });
+
+                ready = true;
+            }
+
+            bool is_ready () const
+            {
+                return ready;
+            }
+
+            void render (Canvas & canvas)
+            {
+                canvas.clear ();
+
+                camera.apply (canvas);
+
+                entities.render (canvas, camera.get_visible_bounds ());
+            }
+
+        };
+
+        // -----------------------------------------------------------------------------------------
+
+        /**
+         * Dibuja un fotograma con los mismos pasos que Director::run(), pero sin presentar nada.
+         */
+        template< class SCENE >
+        void render_frame (Graphics_Context::Accessor & context, Canvas & canvas, SCENE * scene)
+        {
+            render_statistics.begin_frame ();
+
+            opengles::gl_recorder.begin_frame ();
+
+            if (scene) scene->render (canvas); else canvas.clear ();
+
+            context->flush_and_display ();
+
+            frame_arena.reset ();
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        /**
+         * Máximo de llamadas de dibujo y de subidas de uniforms que puede enviar un fotograma.
+         */
+        struct Gl_Budget
+        {
+            uint32_t draw_calls;
+            uint32_t uniform_uploads;
+        };
+
+        /**
+         * Dibuja un fotograma de la escena y falla si lo que se envía a OpenGL supera el presupuesto,
+         * lo que detecta que un cambio rompe el batching o vuelve a subir uniforms redundantes.
+         */
+        template< class SCENE >
+        void check_gl_budget
+        (
+            Suite & suite, const std::string & name, Graphics_Context::Accessor & context, Canvas & canvas, SCENE & scene, const Gl_Budget & budget
+        )
+        {
+            suite.check
+            (
+                "render", name + " gl budget",
+                [&] (std::string & detail)
+                {
+                    render_frame (context, canvas, &scene);
+
+                    const opengles::GL_Recorder::Counts & counts = opengles::gl_recorder.get_frame_counts ();
+
+                    detail =
+                        std::to_string (counts.draw_calls     ) + " of " + std::to_string (budget.draw_calls     ) + " draw calls, " +
+                        std::to_string (counts.uniform_uploads) + " of " + std::to_string (budget.uniform_uploads) + " uniform uploads";
+
+                    return counts.draw_calls <= budget.draw_calls && counts.uniform_uploads <= budget.uniform_uploads;
+                }
+            );
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void run_render_benchmarks (Suite & suite)
+    {
+        if (!Asset::exists ("game-scene/background.png") || !Asset::exists ("game-scene/fonts/impact.fnt"))
+        {
+            suite.skip ("render", "frame", "assets not found");
+            return;
+        }
+
+        Headless_Graphics graphics({ canvas_width, canvas_height });
+
+        Graphics_Context::Accessor & context = graphics.context;
+
+        Canvas * canvas = Canvas::create (ID(canvas), context, {{ canvas_width, canvas_height }});
+
+        if (!canvas)
+        {
+            suite.skip ("render", "frame", "no canvas for the context");
+            return;
+        }
+
+        // Los presupuestos parten de lo que envía hoy cada fotograma con un pequeño margen (cada
+        // entidad y cada glifo es una llamada de dibujo). Si un cambio los supera a propósito, hay
+        // que revisarlos aquí:
+
+        Menu_Frame menu(context);
+
+        // El menú dibuja 4 de sus 5 objetos (las instrucciones empiezan ocultas) con 3 subidas de
+        // uniforms. El margen es el de mostrar también las instrucciones:
+
+        if (menu.is_ready ())
+        {
+            check_gl_budget (suite, "menu", context, *canvas, menu, { 5, 4 });
+        }
+        else
+        {
+            suite.skip ("render", "menu gl budget", "assets not loaded");
+        }
+
+        suite.run
+        (
+            "render", "frame clear only", 1,
+            [&] ()
+            {
+                render_frame< Benchmark_Scene > (context, *canvas, nullptr);
+            }
+        );
+
+        struct Load { const char * name; size_t sprites; size_t particles; Gl_Budget budget; };
+
+        for
+        (
+            const Load & load :
+            {
+                Load{ "frame light",   50,   500, {   80, 12 } },
+                Load{ "frame heavy", 1000, 10000, { 1040, 12 } }
+            }
+        )
+        {
+            Benchmark_Scene scene(context, load.sprites, load.particles);
+
+            if (!scene.is_ready ())
+            {
+                suite.skip ("render", load.name, "assets not loaded");
+                continue;
+            }
+
+            check_gl_budget (suite, load.name, context, *canvas, scene, load.budget);
+
+            suite.run
+            (
+                "render", load.name, 1,
+                [&] ()
+                {
+                    render_frame (context, *canvas, &scene);
+                }
+            );
+
+            // Lo que envía cada fotograma a OpenGL, para poder relacionar el tiempo con el trabajo:
+
+            if (!suite.get_results ().empty () && suite.get_results ().back ().name == load.name)
+            {
+                render_frame (context, *canvas, &scene);
+
+                const opengles::GL_Recorder::Counts & counts = opengles::gl_recorder.get_frame_counts ();
+
+                std::cerr
+                    << "    " << counts.calls << " gl calls, " << counts.draw_calls << " draw calls, "
+                    << counts.vertices << " vertices, " << counts.bytes_uploaded << " bytes uploaded"
+                    << std::endl;
+            }
+        }
+    }
+
+}
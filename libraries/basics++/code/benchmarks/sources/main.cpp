@@ -0,0 +1,136 @@
+/*
+ * BENCHMARKS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802231100
+ */
+
+// Benchmarks de las partes de basics++ que más se usan en cada fotograma. Se compila para Linux
+// con projects/benchmarks/CMakeLists.txt, usando el stub de OpenGL ES en CPU, y escribe los
+// resultados en JSON para poder comparar cada cambio con una ejecución anterior. Antes se ejecutan
+// unas comprobaciones (equivalencia de resultados, presupuestos de llamadas...) que, como las
+// regresiones, hacen que el programa termine con el código 1:
+//
+//     basics-benchmarks --output baseline.json
+//     ...
+//     basics-benchmarks --output current.json --baseline baseline.json
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <basics/enable>
+#include <basics/opengles/OpenGL_ES2>
+#include "Benchmark.hpp"
+
+namespace
+{
+
+    const char usage[] =
+        "usage: basics-benchmarks [options]\n"
+        "  --filter TEXT      run only the checks and benchmarks whose group/name contains TEXT\n"
+        "  --output FILE      write the JSON results to FILE instead of stdout\n"
+        "  --baseline FILE    compare the medians with a previous JSON output\n"
+        "  --threshold RATIO  slowdown reported as a regression (default 0.10)\n"
+        "  --samples N        samples per benchmark (default 15)\n"
+        "  --min-time SECS    minimum duration of each sample (default 0.02)\n"
+        "  --list             list the benchmarks without running them\n";
+
+}
+
+int main (int argc, char * argv[])
+{
+    using namespace benchmarks;
+
+    Suite::Options options;
+    std::string    output_path;
+    std::string    baseline_path;
+    double         threshold = .10;
+
+    for (int index = 1; index < argc; ++index)
+    {
+        const char * argument = argv[index];
+        const char * value    = index + 1 < argc ? argv[index + 1] : nullptr;
+
+        auto takes_value = [&] ()
+        {
+            if (!value)
+            {
+                std::cerr << argument << " needs a value\n" << usage;
+                std::exit (2);
+            }
+
+            ++index;
+
+            return value;
+        };
+
+        if (!std::strcmp (argument, "--filter"   )) options.filter          = takes_value (); else
+        if (!std::strcmp (argument, "--output"   )) output_path             = takes_value (); else
+        if (!std::strcmp (argument, "--baseline" )) baseline_path           = takes_value (); else
+        if (!std::strcmp (argument, "--threshold")) threshold               = std::atof (takes_value ()); else
+        if (!std::strcmp (argument, "--samples"  )) options.samples         = unsigned(std::atoi (takes_value ())); else
+        if (!std::strcmp (argument, "--min-time" )) options.min_sample_time = std::atof (takes_value ()); else
+        if (!std::strcmp (argument, "--list"     )) options.list_only       = true; else
+        {
+            std::cerr << usage;
+
+            return std::strcmp (argument, "--help") ? 2 : 0;
+        }
+    }
+
+    if (options.samples == 0) options.samples = 1;
+
+    // Se usan las mismas especializaciones de Canvas y Texture_2D que en Android. El registro de
+    // llamadas a OpenGL solo cuenta, ya que guardar cada llamada falsearía los tiempos:
+
+    basics::enable< basics::OpenGL_ES2 > ();
+
+    basics::opengles::gl_recorder.set_call_recording (false);
+
+    Suite suite(options);
+
+    run_math_checks       (suite);
+    run_input_checks      (suite);
+
+    run_core_benchmarks   (suite);
+    run_math_benchmarks   (suite);
+    run_asset_benchmarks  (suite);
+    run_gaming_benchmarks (suite);
+    run_render_benchmarks (suite);
+
+    if (options.list_only) return 0;
+
+    if (output_path.empty ())
+    {
+        suite.write_json (std::cout);
+    }
+    else
+    {
+        std::ofstream output(output_path);
+
+        suite.write_json (output);
+
+        if (!output)
+        {
+            std::cerr << "can't write " << output_path << std::endl;
+
+            return 2;
+        }
+    }
+
+    if (!baseline_path.empty ())
+    {
+        int regressions = suite.compare (baseline_path, threshold, std::cerr);
+
+        if (regressions < 0) return 2;
+        if (regressions > 0) return 1;
+    }
+
+    return suite.get_failure_count () > 0 ? 1 : 0;
+}
@@ -0,0 +1,168 @@
+/*
+ *  BROAD PHASE
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C1802151130
+ */
+
+#ifndef BASICS_BROAD_PHASE_HEADER
+#define BASICS_BROAD_PHASE_HEADER
+
+    #include <cstdint>
+    #include <vector>
+    #include <basics/Entity_Store>
+    #include <basics/Kernels>
+    #include <basics/Non_Copyable>
+    #include <basics/Vector>
+
+    namespace basics
+    {
+
+        /**
+         * Fase amplia de la detección de colisiones por barrido y poda (sweep and prune).
+         * Las cajas de las entidades se mantienen ordenadas por su borde izquierdo. Como entre un
+         * fotograma y el siguiente las entidades se mueven poco, el orden se corrige con una
+         * ordenación por inserción que en la práctica es lineal. Después basta con recorrer la lista
+         * una vez comparando cada caja solo con las que empiezan antes de que ella termine.
+         * Cada llamada a update() compara las parejas que se solapan con las del fotograma anterior
+         * y genera eventos BEGIN, PERSIST y END.
+         * Las entidades marcadas como continuas usan la caja que barren durante el fotograma
+         * (según su velocidad), de forma que las que se mueven muy rápido no atraviesan a otras
+         * sin llegar a solaparse en ningún fotograma. time_of_impact() permite afinar después el
+         * instante del contacto de esas parejas.
+         */
+        class Broad_Phase : Non_Copyable
+        {
+        public:
+
+            typedef Entity_Store::Handle Handle;
+            typedef kernels::Bounds2f    Bounds;
+
+            enum Phase
+            {
+                BEGIN,
+                PERSIST,
+                END
+            };
+
+            struct Overlap
+            {
+                Handle first;
+                Handle second;
+                Phase  phase;
+            };
+
+        private:
+
+            struct Endpoint
+            {
+                float    left;                  ///< Copia del borde izquierdo para ordenar sin indirecciones.
+                uint32_t proxy;
+            };
+
+            struct Pair
+            {
+                uint64_t key;                   ///< Índices de las dos entidades (el menor en la parte alta).
+                Handle   first;
+                Handle   second;
+
+                bool operator < (const Pair & other) const
+                {
+                    return key < other.key;
+                }
+            };
+
+        private:
+
+            // Datos de cada proxy (uno por entidad registrada):
+
+            std::vector< Handle  > handles;
+            std::vector< Bounds  > bounds;
+            std::vector< uint8_t > continuous;
+
+            std::vector< uint32_t > slots;      ///< Proxy de cada índice de entidad.
+            std::vector< Endpoint > sorted;     ///< Proxies ordenados por el borde izquierdo.
+
+            std::vector< Pair    > pairs;       ///< Parejas que se solapan en el último update().
+            std::vector< Pair    > previous_pairs;
+            std::vector< Overlap > overlaps;
+
+        public:
+
+            void add    (const Handle & handle, const Bounds & bounds, bool continuous = false);
+            void add    (const Entity_Store & store, const Handle & handle, bool continuous = false);
+            void remove (const Handle & handle);
+            void clear  ();
+
+            bool contains (const Handle & handle) const
+            {
+                return handle.index < slots.size () && slots[handle.index] != Entity_Store::invalid_index && handles[slots[handle.index]] == handle;
+            }
+
+            size_t size () const
+            {
+                return handles.size ();
+            }
+
+        public:
+
+            /**
+             * Cambia la caja de una entidad. La posición que ocupa en la lista ordenada se corrige en
+             * el siguiente update().
+             */
+            void set_bounds (const Handle & handle, const Bounds & new_bounds);
+
+            /**
+             * Copia las cajas de todas las entidades registradas desde el almacén. Las entidades
+             * ocultas no se solapan con nada y las destruidas se eliminan.
+             * A las entidades continuas se les añade el desplazamiento speed * time.
+             */
+            void synchronize (const Entity_Store & store, float time);
+
+            /**
+             * Ordena las cajas, busca las parejas que se solapan y retorna los eventos de este
+             * fotograma. Las parejas se identifican por los índices de sus entidades, por lo que el
+             * orden de los eventos es determinista.
+             * La lista es válida hasta la siguiente llamada.
+             */
+            const std::vector< Overlap > & update ();
+
+            const std::vector< Overlap > & get_overlaps () const
+            {
+                return overlaps;
+            }
+
+        public:
+
+            /**
+             * Calcula el primer instante en [0, time] en el que dos cajas que se mueven con velocidad
+             * constante empiezan a solaparse. Retorna false si no llegan a solaparse.
+             */
+            static bool time_of_impact
+            (
+                const Bounds   & a,
+                const Vector2f & speed_a,
+                const Bounds   & b,
+                const Vector2f & speed_b,
+                float            time,
+                float          & impact_time
+            );
+
+        private:
+
+            void update_bounds (uint32_t proxy, const Bounds & new_bounds);
+            void remove        (uint32_t proxy);
+            void sort          ();
+            void sweep         ();
+            void classify      ();
+
+        };
+
+    }
+
+#endif
@@ -13,15 +13,188 @@
 #ifndef BASICS_CAMERA_HEADER
 #define BASICS_CAMERA_HEADER
 
+    #include <cmath>
+    #include <basics/Affine2>
+    #include <basics/assert>
+    #include <basics/Canvas>
+    #include <basics/Kernels>
     #include <basics/macros>
+    #include <basics/Point>
+    #include <basics/Size>
+    #include <basics/Vector>
 
     namespace basics
     {
 
+        /**
+         * Cámara 2D que determina qué parte del mundo se ve en el canvas.
+         * La posición es el punto del mundo que aparece en el centro de la vista, el zoom es el
+         * número de unidades del canvas que ocupa cada unidad del mundo y la rotación (en radianes)
+         * gira el mundo alrededor de ese punto en sentido contrario.
+         * Una cámara centrada en la vista, con zoom 1 y sin rotación produce la transformación
+         * identidad, por lo que las coordenadas del mundo coinciden con las del canvas.
+         */
         class Camera
         {
         public:
 
+            typedef kernels::Bounds2f Bounds;
+
+        private:
+
+            Size2f   viewport;
+            Point2f  position;
+            float    zoom;
+            float    rotation;
+
+            mutable Affine2f transform;         ///< Del mundo al canvas.
+            mutable Bounds   visible_bounds;
+            mutable bool     dirty;
+
+        public:
+
+            Camera()
+            :
+                viewport({ 1.f, 1.f }),
+                position({ .5f, .5f }),
+                zoom    (1.f),
+                rotation(0.f),
+                dirty   (true)
+            {
+            }
+
+            Camera(const Size2f & viewport)
+            :
+                viewport(viewport),
+                position({ viewport.width * .5f, viewport.height * .5f }),
+                zoom    (1.f),
+                rotation(0.f),
+                dirty   (true)
+            {
+            }
+
+        public:
+
+            const Size2f  & get_viewport () const { return viewport; }
+            const Point2f & get_position () const { return position; }
+            float           get_zoom     () const { return zoom;     }
+            float           get_rotation () const { return rotation; }
+
+            /**
+             * Cambia el tamaño de la vista (normalmente el del canvas) sin mover la cámara.
+             */
+            void set_viewport (const Size2f & new_viewport)
+            {
+                viewport = new_viewport;
+                dirty    = true;
+            }
+
+            void set_position (const Point2f & new_position)
+            {
+                position = new_position;
+                dirty    = true;
+            }
+
+            void move (const Vector2f & displacement)
+            {
+                position.coordinates.x () += displacement[0];
+                position.coordinates.y () += displacement[1];
+                dirty = true;
+            }
+
+            void set_zoom (float new_zoom)
+            {
+                assert(new_zoom > 0.f);
+
+                zoom  = new_zoom;
+                dirty = true;
+            }
+
+            void set_rotation (float new_rotation)
+            {
+                rotation = new_rotation;
+                dirty    = true;
+            }
+
+        public:
+
+            /**
+             * Retorna la transformación que lleva las coordenadas del mundo a las del canvas.
+             */
+            const Affine2f & get_transform () const
+            {
+                if (dirty) refresh ();
+
+                return transform;
+            }
+
+            /**
+             * Retorna la caja alineada con los ejes (en coordenadas del mundo) que envuelve la parte
+             * visible del mundo. Si la cámara está girada la caja es algo mayor que la vista.
+             */
+            const Bounds & get_visible_bounds () const
+            {
+                if (dirty) refresh ();
+
+                return visible_bounds;
+            }
+
+            bool is_visible (const Bounds & bounds) const
+            {
+                const Bounds & view = get_visible_bounds ();
+
+                return bounds.right >= view.left && bounds.left <= view.right && bounds.top >= view.bottom && bounds.bottom <= view.top;
+            }
+
+            /**
+             * Convierte un punto del canvas (por ejemplo un toque) a coordenadas del mundo.
+             */
+            Point2f to_world (const Point2f & point) const
+            {
+                return get_transform ().inverse ().transform (point);
+            }
+
+            Point2f to_view (const Point2f & point) const
+            {
+                return get_transform ().transform (point);
+            }
+
+            /**
+             * Establece la transformación del canvas para dibujar el mundo visto desde la cámara.
+             */
+            void apply (Canvas & canvas) const
+            {
+                canvas.set_transform (get_transform ().to_transformation ());
+            }
+
+        private:
+
+            void refresh () const
+            {
+                float sin = std::sin (-rotation);
+                float cos = std::cos (-rotation);
+
+                transform =
+                    Affine2f::translation (viewport.width * .5f, viewport.height * .5f) *
+                    Affine2f::rotation    (sin, cos) *
+                    Affine2f::scaling     (zoom) *
+                    Affine2f::translation (-position[0], -position[1]);
+
+                // Las esquinas de la vista se llevan al mundo para obtener la caja visible:
+
+                Affine2f inverse = transform.inverse ();
+
+                const Point2f corners[] =
+                {
+                    inverse.transform (Point2f{ 0.f,            0.f             }),
+                    inverse.transform (Point2f{ viewport.width, 0.f             }),
+                    inverse.transform (Point2f{ 0.f,            viewport.height }),
+                    inverse.transform (Point2f{ viewport.width, viewport.height }),
+                };
+
+                visible_bounds = kernels::bounds (corners, 4);
+                dirty          = false;
+            }
 
         };
 
@@ -13,11 +13,19 @@
 #ifndef BASICS_DIRECTOR_HEADER
 #define BASICS_DIRECTOR_HEADER
 
+    #include <atomic>
     #include <memory>
+    #include <mutex>
+    #include <string>
     #include <basics/declarations>
     #include <basics/Event_Queue>
     #include <basics/Graphics_Context>
     #include <basics/Graphics_Resource_Cache>
+    #include <basics/Input_Log>
+    #include <basics/Latency_Histogram>
+    #include <basics/Memory_Tracker>
+    #include <basics/Performance_Hud>
+    #include <basics/Touch_Packet>
     #include <basics/Window>
 
     namespace basics
@@ -29,6 +37,24 @@
 
             typedef bool (* Graphics_Context_Factory) (Window::Accessor & window, Graphics_Resource_Cache * cache);
 
+            /**
+             * Latencias desde que se origina un evento de entrada hasta que la escena lo maneja,
+             * hasta que se renderiza el fotograma y hasta que se presenta en pantalla.
+             */
+            struct Input_Latency
+            {
+                Latency_Histogram to_handle;
+                Latency_Histogram to_render;
+                Latency_Histogram to_display;
+
+                void clear ()
+                {
+                    to_handle .clear ();
+                    to_render .clear ();
+                    to_display.clear ();
+                }
+            };
+
         public:
 
             static Director & get_instance ()
@@ -37,6 +63,11 @@
                 return director;
             }
 
+        private:
+
+            static constexpr size_t event_batch_size      = 32;
+            static constexpr size_t max_tracked_inputs    = 64;      ///< Eventos por fotograma cuya latencia se mide
+
         private:
 
             struct
@@ -64,6 +95,26 @@
 
             Event_Queue event_queue;
 
+            Touch_Packet pending_touches;               ///< Muestras recibidas desde el último fotograma
+            Touch_Packet frame_touches;                 ///< Muestras que se entregan a la escena en este fotograma
+            std::mutex   touches_mutex;
+
+            Event        frame_events[event_batch_size];
+
+            Performance_Hud performance_hud;
+
+            Memory_Tracker::Snapshot scene_memory;      ///< Memoria en uso antes de inicializar la escena actual
+
+            Input_Latency input_latency;
+            int64_t       frame_input_timestamps[max_tracked_inputs];
+            size_t        frame_input_count;
+            bool          late_input_latching;
+
+            std::unique_ptr< Input_Replayer > replayer;
+            Input_Frame                       replay_frame;
+            std::atomic< bool >               replaying;
+            bool                              exit_after_replay;
+
             float surface_width;
             float surface_height;
 
@@ -83,6 +134,80 @@
 
             Graphics_Context::Accessor lock_graphics_context ();
 
+            /**
+             * Si se activa, la entrada que llegue mientras se actualiza la escena se entrega justo
+             * antes de renderizar, en lugar de esperar al siguiente fotograma. Reduce la latencia
+             * a costa de que la escena pueda recibir entrada después de update().
+             */
+            void set_late_input_latching (bool enabled)
+            {
+                late_input_latching = enabled;
+            }
+
+            bool is_late_input_latching () const
+            {
+                return late_input_latching;
+            }
+
+            const Input_Latency & get_input_latency () const
+            {
+                return input_latency;
+            }
+
+            void reset_input_latency ()
+            {
+                input_latency.clear ();
+            }
+
+            /**
+             * Panel de rendimiento que se dibuja encima de la escena. Está oculto por defecto.
+             */
+            Performance_Hud & get_performance_hud ()
+            {
+                return performance_hud;
+            }
+
+            void set_performance_hud_visible (bool visible)
+            {
+                performance_hud.set_visible (visible);
+            }
+
+            void toggle_performance_hud ()
+            {
+                performance_hud.toggle ();
+            }
+
+            /**
+             * Graba en un archivo la entrada que se entrega en cada fotograma y el tiempo con el que
+             * se actualiza la escena, para poder reproducir la partida con start_replay().
+             */
+            bool start_recording (const std::string & path)
+            {
+                return input_recorder.start (path);
+            }
+
+            void stop_recording ()
+            {
+                input_recorder.stop ();
+            }
+
+            /**
+             * Sustituye la entrada y la duración de cada fotograma por las grabadas en el archivo,
+             * de modo que dos ejecuciones de la misma grabación hacen el mismo trabajo. Mientras
+             * dura se ignora la entrada que llega a handle(). No se reproducen los eventos de la
+             * ventana (creación, destrucción y cambios de configuración) porque dependen de la
+             * superficie real.
+             * @param exit_at_end Si es true el director termina al acabar la grabación.
+             */
+            bool start_replay (const std::string & path, bool exit_at_end = false);
+
+            void stop_replay ();
+
+            bool is_replaying () const
+            {
+                return replaying;
+            }
+
         public:
 
             void run_scene (const std::shared_ptr< Scene > & new_scene);
@@ -94,12 +219,36 @@
 
             void handle (const Event & event)
             {
-                event_queue.push (event);
+                if (!replaying) event_queue.push (event);
+            }
+
+            void handle (Event && event)
+            {
+                if (!replaying) event_queue.push (std::move (event));
+            }
+
+            /**
+             * Acumula las muestras táctiles hasta el siguiente fotograma. Se puede llamar desde
+             * cualquier hilo.
+             */
+            void handle (const Touch_Packet & touches)
+            {
+                if (!replaying)
+                {
+                    std::lock_guard< std::mutex > lock(touches_mutex);
+
+                    pending_touches.append (touches);
+                }
             }
 
         private:
 
             void run_kernel ();
+            void finalize_scene ();
+            bool replay_frame_input (float & time);
+            void dispatch_input (float h_ratio, float v_ratio);
+            void track_input_latency (int64_t timestamp, int64_t now);
+            void record_frame_latency (Latency_Histogram & histogram);
             bool check_scene ();
             void reset_viewport (Window::Accessor & window);
 
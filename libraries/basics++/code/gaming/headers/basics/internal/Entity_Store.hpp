@@ -0,0 +1,319 @@
+/*
+ *  ENTITY STORE
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C1802141020
+ */
+
+#ifndef BASICS_ENTITY_STORE_HEADER
+#define BASICS_ENTITY_STORE_HEADER
+
+    #include <cstdint>
+    #include <vector>
+    #include <basics/Atlas>
+    #include <basics/Canvas>
+    #include <basics/Kernels>
+    #include <basics/Non_Copyable>
+    #include <basics/Point>
+    #include <basics/Size>
+    #include <basics/Texture_2D>
+    #include <basics/Vector>
+
+    namespace basics
+    {
+
+        /**
+         * Almacena los objetos de una escena (posición, tamaño, anchor, velocidad, visibilidad y
+         * textura o slice de atlas) en columnas contiguas en lugar de en un objeto por entidad.
+         * Los sistemas de movimiento, filtrado de visibilidad y dibujado recorren las columnas de
+         * principio a fin, por lo que su coste depende del ancho de banda de memoria y no de los
+         * saltos entre punteros.
+         * Destruir una entidad mueve la última a su hueco, por lo que las columnas dejan de estar
+         * en el orden de creación. Ese orden, que es también el de dibujado (las entidades creadas
+         * después se dibujan encima), se restablece de una vez antes del siguiente filtrado o
+         * dibujado.
+         */
+        class Entity_Store : Non_Copyable
+        {
+        public:
+
+            /**
+             * Referencia estable a una entidad. La generación permite detectar referencias a
+             * entidades ya destruidas aunque su índice se haya reutilizado.
+             */
+            struct Handle
+            {
+                uint32_t index;
+                uint32_t generation;
+
+                Handle() : index(invalid_index), generation(0)
+                {
+                }
+
+                Handle(uint32_t index, uint32_t generation) : index(index), generation(generation)
+                {
+                }
+
+                bool is_valid () const
+                {
+                    return index != invalid_index;
+                }
+
+                bool operator == (const Handle & other) const
+                {
+                    return index == other.index && generation == other.generation;
+                }
+
+                bool operator != (const Handle & other) const
+                {
+                    return !(*this == other);
+                }
+            };
+
+            static constexpr uint32_t invalid_index = 0xFFFFFFFF;
+
+            /**
+             * A partir de este número de entidades el sistema de movimiento reparte el trabajo
+             * entre los hilos del Worker_Pool. Con menos, mover todas las entidades en un solo hilo
+             * cuesta menos que despertar a los demás.
+             */
+            static constexpr size_t parallel_threshold = 65536;
+
+        private:
+
+            // Columnas densas (una posición por entidad viva):
+
+            std::vector< float                > xs;
+            std::vector< float                > ys;
+            std::vector< float                > speeds_x;
+            std::vector< float                > speeds_y;
+            std::vector< float                > widths;
+            std::vector< float                > heights;
+            std::vector< int32_t              > anchors;
+            std::vector< uint8_t              > visibilities;
+            std::vector< const Texture_2D   * > textures;
+            std::vector< const Atlas::Slice * > slices;
+            std::vector< uint32_t             > owners;             ///< Índice de la entidad que ocupa cada posición.
+            std::vector< uint32_t             > sequences;          ///< Orden de creación de cada posición.
+
+            // Tabla de indirección de los handles:
+
+            std::vector< uint32_t > positions;                      ///< Posición en las columnas de cada índice de entidad.
+            std::vector< uint32_t > generations;
+            std::vector< uint32_t > free_indices;
+
+            std::vector< uint32_t > visible_list;
+
+            size_t   hidden_count;
+            unsigned worker_count;
+            uint32_t next_sequence;
+            bool     unordered;                                     ///< Alguna destrucción ha alterado el orden de creación.
+
+        public:
+
+            Entity_Store();
+
+        public:
+
+            Handle create  (const Texture_2D   * texture, const Size2f & size, int anchor = CENTER);
+            Handle create  (const Atlas::Slice * slice,   const Size2f & size, int anchor = CENTER);
+            void   destroy (const Handle & handle);
+            void   clear   ();
+            void   reserve (size_t capacity);
+
+            bool is_alive (const Handle & handle) const
+            {
+                return
+                    handle.index < generations.size () &&
+                    generations[handle.index] == handle.generation &&
+                    positions  [handle.index] != invalid_index;
+            }
+
+            size_t size () const
+            {
+                return owners.size ();
+            }
+
+            /**
+             * Retorna la posición en las columnas de una entidad viva. La posición de una entidad
+             * puede cambiar cuando se destruye otra o al restablecer el orden de dibujado.
+             */
+            size_t position_of (const Handle & handle) const
+            {
+                return positions[handle.index];
+            }
+
+        public:
+
+            // Acceso por handle (el handle debe ser de una entidad viva):
+
+            Point2f  get_position (const Handle & handle) const { size_t i = position_of (handle); return { xs[i], ys[i] }; }
+            Vector2f get_speed    (const Handle & handle) const { size_t i = position_of (handle); return { speeds_x[i], speeds_y[i] }; }
+            Size2f   get_size     (const Handle & handle) const { size_t i = position_of (handle); return { widths[i], heights[i] }; }
+            int      get_anchor   (const Handle & handle) const { return anchors[position_of (handle)]; }
+            bool     is_visible   (const Handle & handle) const { return visibilities[position_of (handle)] != 0; }
+
+            const Texture_2D   * get_texture (const Handle & handle) const { return textures[position_of (handle)]; }
+            const Atlas::Slice * get_slice   (const Handle & handle) const { return slices  [position_of (handle)]; }
+
+            float get_left_x (const Handle & handle) const
+            {
+                return get_left_x (position_of (handle));
+            }
+
+            float get_bottom_y (const Handle & handle) const
+            {
+                return get_bottom_y (position_of (handle));
+            }
+
+            void set_position (const Handle & handle, const Point2f & position)
+            {
+                size_t i = position_of (handle);
+
+                xs[i] = position[0];
+                ys[i] = position[1];
+            }
+
+            void set_position_x (const Handle & handle, float x) { xs[position_of (handle)] = x; }
+            void set_position_y (const Handle & handle, float y) { ys[position_of (handle)] = y; }
+
+            void set_speed (const Handle & handle, const Vector2f & speed)
+            {
+                size_t i = position_of (handle);
+
+                speeds_x[i] = speed[0];
+                speeds_y[i] = speed[1];
+            }
+
+            void set_speed_x (const Handle & handle, float speed_x) { speeds_x[position_of (handle)] = speed_x; }
+            void set_speed_y (const Handle & handle, float speed_y) { speeds_y[position_of (handle)] = speed_y; }
+
+            void set_size (const Handle & handle, const Size2f & size)
+            {
+                size_t i = position_of (handle);
+
+                widths [i] = size.width;
+                heights[i] = size.height;
+            }
+
+            void set_anchor  (const Handle & handle, int anchor)                    { anchors[position_of (handle)] = anchor; }
+            void set_texture (const Handle & handle, const Texture_2D   * texture)  { size_t i = position_of (handle); textures[i] = texture; slices[i] = nullptr; }
+            void set_slice   (const Handle & handle, const Atlas::Slice * slice)    { size_t i = position_of (handle); slices[i] = slice; textures[i] = nullptr; }
+
+            void set_visible (const Handle & handle, bool visible)
+            {
+                uint8_t & visibility = visibilities[position_of (handle)];
+
+                if (visibility != uint8_t(visible))
+                {
+                    visibility = uint8_t(visible);
+
+                    if (visible) hidden_count--; else hidden_count++;
+                }
+            }
+
+        public:
+
+            // Acceso directo a las columnas para los sistemas externos (todas tienen size() elementos):
+
+            float       * get_xs       ()       { return xs.data ();       }
+            float       * get_ys       ()       { return ys.data ();       }
+            const float * get_xs       () const { return xs.data ();       }
+            const float * get_ys       () const { return ys.data ();       }
+            const float * get_speeds_x () const { return speeds_x.data (); }
+            const float * get_speeds_y () const { return speeds_y.data (); }
+            const float * get_widths   () const { return widths.data ();   }
+            const float * get_heights  () const { return heights.data ();  }
+
+            const int32_t * get_anchors      () const { return anchors.data ();      }
+            const uint8_t * get_visibilities () const { return visibilities.data (); }
+
+            Handle get_handle (size_t position) const
+            {
+                uint32_t index = owners[position];
+
+                return Handle(index, generations[index]);
+            }
+
+            float get_left_x (size_t i) const
+            {
+                int horizontal = anchors[i] & 0x3;
+
+                return horizontal == LEFT ? xs[i] : horizontal == RIGHT ? xs[i] - widths[i] : xs[i] - widths[i] * .5f;
+            }
+
+            float get_bottom_y (size_t i) const
+            {
+                int vertical = anchors[i] & 0xC;
+
+                return vertical == BOTTOM ? ys[i] : vertical == TOP ? ys[i] - heights[i] : ys[i] - heights[i] * .5f;
+            }
+
+        public:
+
+            /**
+             * Número de hilos que usa el sistema de movimiento cuando hay al menos parallel_threshold
+             * entidades. Por defecto es el número de núcleos del procesador.
+             */
+            void set_worker_count (unsigned count)
+            {
+                worker_count = count > 0 ? count : 1;
+            }
+
+            unsigned get_worker_count () const
+            {
+                return worker_count;
+            }
+
+        public:
+
+            // Sistemas:
+
+            /**
+             * Desplaza todas las entidades visibles según su velocidad durante el tiempo indicado.
+             */
+            void move (float time);
+
+            /**
+             * Retorna la lista de posiciones de las entidades visibles en orden de dibujado.
+             * La lista es válida hasta que se vuelva a llamar a este método o se modifique el almacén.
+             * Si se han destruido entidades, antes se restablece el orden de creación de las columnas.
+             */
+            const std::vector< uint32_t > & filter_visible ();
+
+            /**
+             * Igual que filter_visible() pero descartando también las entidades cuyo rectángulo no
+             * se solapa con la caja indicada (normalmente Camera::get_visible_bounds()).
+             */
+            const std::vector< uint32_t > & filter_visible (const kernels::Bounds2f & view);
+
+            /**
+             * Dibuja las entidades visibles en orden de creación.
+             */
+            void render (Canvas & canvas);
+
+            /**
+             * Dibuja las entidades visibles que se solapan con la caja indicada. Las que quedan
+             * fuera no llegan a enviarse al canvas.
+             */
+            void render (Canvas & canvas, const kernels::Bounds2f & view);
+
+        private:
+
+            Handle add (const Texture_2D * texture, const Atlas::Slice * slice, const Size2f & size, int anchor);
+
+            void move   (size_t first, size_t last, float time);
+            void submit (Canvas & canvas);
+
+            void restore_order ();
+
+        };
+
+    }
+
+#endif
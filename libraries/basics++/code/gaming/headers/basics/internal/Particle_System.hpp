@@ -0,0 +1,186 @@
+/*
+ *  PARTICLE SYSTEM
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C1802161730
+ */
+
+#ifndef BASICS_PARTICLE_SYSTEM_HEADER
+#define BASICS_PARTICLE_SYSTEM_HEADER
+
+    #include <cstdint>
+    #include <vector>
+    #include <basics/Atlas>
+    #include <basics/Canvas>
+    #include <basics/Non_Copyable>
+    #include <basics/Point>
+    #include <basics/Vector>
+
+    namespace basics
+    {
+
+        /**
+         * Describe cómo nacen las partículas: dónde, en qué dirección, con qué velocidad, cuánto
+         * viven y cómo cambia su tamaño. Los ángulos se expresan en radianes.
+         * La emisión continua acumula en accumulator la fracción de partícula pendiente entre
+         * fotogramas, por lo que cada emisor debe tener su propia copia.
+         */
+        struct Particle_Emitter
+        {
+            Point2f  position;
+            float    rate;                      ///< Partículas por segundo en la emisión continua.
+            float    direction;
+            float    spread;                    ///< Desviación máxima respecto a direction.
+            float    min_speed, max_speed;
+            float    min_lifetime, max_lifetime;
+            float    start_size, end_size;
+            uint32_t color;                     ///< RGBA empaquetado como en Canvas::fill_rectangles().
+            float    accumulator;
+
+            Particle_Emitter()
+            :
+                position    { 0.f, 0.f },
+                rate        (0.f),
+                direction   (1.5707963f),
+                spread      (3.1415927f),
+                min_speed   (50.f),  max_speed   (150.f),
+                min_lifetime(.5f),   max_lifetime(1.f),
+                start_size  (16.f),  end_size    (0.f),
+                color       (0xFFFFFFFF),
+                accumulator (0.f)
+            {
+            }
+        };
+
+        /**
+         * Conjunto de partículas de capacidad fija que comparten un mismo slice de atlas.
+         * Cada atributo se guarda en un array propio (estructura de arrays) para que las
+         * actualizaciones se puedan hacer con SSE o NEON. Las partículas que mueren se eliminan
+         * moviendo la última a su hueco, por lo que las vivas siempre ocupan las primeras
+         * posiciones y todas se dibujan con una única llamada a Canvas::fill_rectangles().
+         * Cuando la capacidad se agota las nuevas partículas se descartan.
+         */
+        class Particle_System : Non_Copyable
+        {
+
+            std::vector< float    > xs;
+            std::vector< float    > ys;
+            std::vector< float    > speeds_x;
+            std::vector< float    > speeds_y;
+            std::vector< float    > ages;
+            std::vector< float    > inverse_lifetimes;
+            std::vector< float    > start_sizes;
+            std::vector< float    > size_deltas;
+            std::vector< float    > sizes;
+            std::vector< float    > alphas;             ///< Va de 1 a 0 a lo largo de la vida.
+            std::vector< uint32_t > colors;
+            std::vector< uint32_t > packed_colors;      ///< Colores con el alfa aplicado para dibujar.
+
+            size_t   capacity;
+            size_t   count;
+            size_t   dropped;                           ///< Partículas descartadas por falta de hueco.
+            uint32_t seed;
+
+            Vector2f             gravity;
+            const Atlas::Slice * slice;
+
+        public:
+
+            Particle_System(size_t capacity = 1024, const Atlas::Slice * slice = nullptr);
+
+        public:
+
+            size_t size () const
+            {
+                return count;
+            }
+
+            size_t get_capacity () const
+            {
+                return capacity;
+            }
+
+            size_t get_dropped_count () const
+            {
+                return dropped;
+            }
+
+            const float * get_xs () const
+            {
+                return xs.data ();
+            }
+
+            const float * get_ys () const
+            {
+                return ys.data ();
+            }
+
+            const float * get_sizes () const
+            {
+                return sizes.data ();
+            }
+
+            void set_slice (const Atlas::Slice * new_slice)
+            {
+                slice = new_slice;
+            }
+
+            void set_gravity (const Vector2f & new_gravity)
+            {
+                gravity = new_gravity;
+            }
+
+            void set_seed (uint32_t new_seed)
+            {
+                seed = new_seed ? new_seed : 1;
+            }
+
+        public:
+
+            /**
+             * Emite de golpe el número de partículas indicado.
+             */
+            void burst (const Particle_Emitter & emitter, unsigned amount);
+
+            /**
+             * Emite las partículas que corresponden al intervalo de tiempo según emitter.rate.
+             */
+            void emit  (Particle_Emitter & emitter, float time);
+
+            void clear ()
+            {
+                count = 0;
+            }
+
+            /**
+             * Aplica la gravedad, mueve y envejece todas las partículas y elimina las que mueren.
+             */
+            void update (float time);
+
+            void render (Canvas & canvas);
+
+        private:
+
+            float random (float min, float max)
+            {
+                // xorshift32: suficiente para efectos visuales y mucho más barato que rand()
+
+                seed ^= seed << 13;
+                seed ^= seed >> 17;
+                seed ^= seed <<  5;
+
+                return min + (max - min) * float(seed >> 8) * (1.f / 16777216.f);
+            }
+
+            void remove (size_t index);
+
+        };
+
+    }
+
+#endif
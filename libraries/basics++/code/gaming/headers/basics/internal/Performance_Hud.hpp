@@ -0,0 +1,136 @@
+/*
+ *  PERFORMANCE HUD
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C1802181130
+ */
+
+#ifndef BASICS_PERFORMANCE_HUD_HEADER
+#define BASICS_PERFORMANCE_HUD_HEADER
+
+    #include <cstdint>
+    #include <vector>
+    #include <basics/Canvas>
+    #include <basics/Non_Copyable>
+    #include <basics/Render_Statistics>
+    #include <basics/Size>
+
+    namespace basics
+    {
+
+        /**
+         * Panel superpuesto que muestra los FPS, una gráfica con la duración de los últimos
+         * fotogramas, el tiempo de CPU de cada fase del fotograma, las estadísticas de renderizado,
+         * el número de eventos pendientes y la memoria anotada en memory_tracker.
+         * Solo usa primitivas de Canvas y una fuente de 3x5 píxeles incluida en el código, por lo
+         * que no necesita assets. Todo el texto se dibuja con una sola llamada a
+         * Canvas::fill_rectangles(), al igual que cada color de la gráfica.
+         * Director lo dibuja después de Scene::render() y antes de presentar el fotograma cuando
+         * está visible.
+         */
+        class Performance_Hud : Non_Copyable
+        {
+        public:
+
+            enum Phase
+            {
+                INPUT,
+                UPDATE,
+                RENDER,
+                FLUSH,                          ///< Corresponde al fotograma anterior.
+                PHASE_COUNT
+            };
+
+            static constexpr size_t history_size = 120;
+
+        private:
+
+            float             frame_times[history_size];    ///< Segundos. Buffer circular.
+            size_t            history_head;
+            size_t            history_count;
+            float             phase_times[PHASE_COUNT];     ///< Segundos del último fotograma.
+            size_t            event_queue_depth;
+            Render_Statistics frame_statistics;
+            float             frame_budget;
+            bool              visible;
+
+            // Rectángulos pendientes de dibujar:
+
+            std::vector< float > lefts;
+            std::vector< float > bottoms;
+            std::vector< float > widths;
+            std::vector< float > heights;
+
+        public:
+
+            Performance_Hud();
+
+        public:
+
+            void set_visible (bool new_visible)
+            {
+                visible = new_visible;
+            }
+
+            void toggle ()
+            {
+                visible = !visible;
+            }
+
+            bool is_visible () const
+            {
+                return visible;
+            }
+
+            /**
+             * Duración objetivo de un fotograma en segundos. Se marca en la gráfica y las barras
+             * que la superan se pintan en rojo.
+             */
+            void set_frame_budget (float seconds)
+            {
+                frame_budget = seconds;
+            }
+
+        public:
+
+            void record_phase (Phase phase, float seconds)
+            {
+                phase_times[phase] = seconds;
+            }
+
+            void record_frame (float frame_time, size_t new_event_queue_depth);
+
+            /**
+             * Guarda las estadísticas de renderizado de la escena antes de que el propio panel
+             * empiece a dibujar.
+             */
+            void capture_render_statistics ()
+            {
+                frame_statistics = render_statistics;
+            }
+
+            void render (Canvas & canvas, const Size2u & view_size);
+
+        private:
+
+            void add_rectangle (float left, float bottom, float width, float height)
+            {
+                lefts  .push_back (left  );
+                bottoms.push_back (bottom);
+                widths .push_back (width );
+                heights.push_back (height);
+            }
+
+            void add_text (const char * text, float left, float top, float pixel_size);
+            void submit   (Canvas & canvas);
+
+        };
+
+    }
+
+#endif
@@ -15,7 +15,9 @@
 
     #include <basics/Event>
     #include <basics/Graphics_Context>
+    #include <basics/Memory_Tracker>
     #include <basics/Size>
+    #include <basics/Touch_Packet>
 
     namespace basics
     {
@@ -35,6 +37,27 @@
 
             virtual ~Scene() = default;
 
+        public:
+
+            // Lo que ocupa cada escena se anota al crearla con new. Como el destructor es virtual,
+            // al destruirla se recibe el tamaño de la clase derivada:
+
+            static void * operator new (size_t size)
+            {
+                void * memory = ::operator new (size);
+
+                memory_tracker.add (Memory_Tracker::SCENES, int64_t(size));
+
+                return memory;
+            }
+
+            static void operator delete (void * memory, size_t size)
+            {
+                memory_tracker.remove (Memory_Tracker::SCENES, int64_t(size));
+
+                ::operator delete (memory);
+            }
+
         public:
 
             virtual bool initialize () { return true; }
@@ -43,6 +66,26 @@
             virtual void finalize   () { }
 
             virtual void handle     (Event & event) { }
+
+            /**
+             * Recibe una vez por fotograma todas las muestras táctiles (de todos los dedos e incluyendo
+             * las muestras históricas) ya convertidas a coordenadas de la escena.
+             * Por defecto, para las escenas que solo manejan eventos, se genera un evento touch-started,
+             * touch-moved o touch-ended por cada muestra actual del primer dedo.
+             */
+            virtual void handle_touches (Touch_Packet & touches)
+            {
+                for (size_t index = 0, count = touches.size (); index < count; ++index)
+                {
+                    if (touches.is_primary (index) && !touches.is_historical (index))
+                    {
+                        Event event = touches.make_event (index);
+
+                        handle (event);
+                    }
+                }
+            }
+
             virtual void update     (float time) { }
             virtual void render     (Graphics_Context::Accessor & context) { }
 
@@ -0,0 +1,133 @@
+/*
+ *  SPATIAL GRID
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C1802141545
+ */
+
+#ifndef BASICS_SPATIAL_GRID_HEADER
+#define BASICS_SPATIAL_GRID_HEADER
+
+    #include <cstdint>
+    #include <vector>
+    #include <basics/Entity_Store>
+    #include <basics/Kernels>
+    #include <basics/Non_Copyable>
+    #include <basics/Point>
+    #include <basics/Size>
+
+    namespace basics
+    {
+
+        /**
+         * Rejilla uniforme que indexa los rectángulos de las entidades interactivas de un
+         * Entity_Store para resolver rápidamente qué entidad hay bajo un toque.
+         * Cada entidad guarda una copia de sus límites y solo se mueve entre celdas cuando cambia
+         * el rango de celdas que ocupa. Una consulta solo examina las entidades de una celda, por lo
+         * que su coste no depende del número total de entidades de la escena.
+         * Las entidades que quedan fuera del área de la rejilla se asignan a las celdas del borde.
+         */
+        class Spatial_Grid : Non_Copyable
+        {
+        public:
+
+            typedef Entity_Store::Handle Handle;
+            typedef kernels::Bounds2f    Bounds;
+
+        private:
+
+            struct Item
+            {
+                Handle   handle;
+                Bounds   bounds;
+                uint32_t depth;                 ///< Posición de la entidad en el orden de dibujado.
+                bool     visible;
+                int      first_column, first_row;
+                int      last_column,  last_row;
+            };
+
+            typedef std::vector< uint32_t > Cell;
+
+        private:
+
+            std::vector< Item     > items;
+            std::vector< uint32_t > slots;      ///< Posición en items de cada índice de entidad.
+            std::vector< Cell     > cells;
+
+            Point2f origin;
+            float   cell_size;
+            float   inverse_cell_size;
+            int     columns;
+            int     rows;
+
+        public:
+
+            Spatial_Grid();
+
+            Spatial_Grid(const Point2f & origin, const Size2f & area, float cell_size = 128.f)
+            {
+                resize (origin, area, cell_size);
+            }
+
+        public:
+
+            /**
+             * Cambia el área cubierta por la rejilla y redistribuye las entidades que contiene.
+             */
+            void resize (const Point2f & origin, const Size2f & area, float cell_size = 128.f);
+
+            void add    (const Entity_Store & store, const Handle & handle);
+            void remove (const Handle & handle);
+            void clear  ();
+
+            bool contains (const Handle & handle) const
+            {
+                return handle.index < slots.size () && slots[handle.index] != Entity_Store::invalid_index && items[slots[handle.index]].handle == handle;
+            }
+
+            size_t size () const
+            {
+                return items.size ();
+            }
+
+        public:
+
+            /**
+             * Copia los límites, la visibilidad y el orden de dibujado de una entidad desde el
+             * almacén. Se debe llamar cuando la entidad se mueve, cambia de tamaño o se oculta.
+             */
+            void update (const Entity_Store & store, const Handle & handle);
+
+            /**
+             * Actualiza todas las entidades de la rejilla. Basta con llamarlo una vez por fotograma
+             * después de mover las entidades.
+             */
+            void synchronize (const Entity_Store & store);
+
+            /**
+             * Retorna la entidad visible que se dibuja más arriba de entre las que contienen el punto,
+             * o un handle no válido si no hay ninguna.
+             */
+            Handle hit (const Point2f & point) const;
+
+        private:
+
+            void update (Item & item, uint32_t slot, const Entity_Store & store);
+            void remove (uint32_t slot);
+
+            void link   (const Item & item, uint32_t slot);
+            void unlink (const Item & item, uint32_t slot);
+
+            int column_of (float x) const;
+            int row_of    (float y) const;
+
+        };
+
+    }
+
+#endif
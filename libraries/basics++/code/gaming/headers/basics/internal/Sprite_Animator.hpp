@@ -0,0 +1,156 @@
+/*
+ *  SPRITE ANIMATOR
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C1802161045
+ */
+
+#ifndef BASICS_SPRITE_ANIMATOR_HEADER
+#define BASICS_SPRITE_ANIMATOR_HEADER
+
+    #include <cstdint>
+    #include <string>
+    #include <vector>
+    #include <basics/Atlas>
+    #include <basics/Entity_Store>
+    #include <basics/Id>
+    #include <basics/Non_Copyable>
+
+    namespace basics
+    {
+
+        /**
+         * Reproduce animaciones formadas por secuencias de slices de un Atlas sobre las entidades
+         * de un Entity_Store.
+         * Los fotogramas de cada clip se buscan en el atlas una sola vez al añadir el clip y se
+         * guardan como punteros a Atlas::Slice (con sus coordenadas de textura ya normalizadas) en
+         * una tabla compartida por todos los clips. El estado de reproducción de cada entidad se
+         * guarda en arrays contiguos y todas las animaciones se avanzan con una única llamada a
+         * update() por fotograma. Cambiar de fotograma cuesta un acceso a la tabla.
+         */
+        class Sprite_Animator : Non_Copyable
+        {
+        public:
+
+            typedef Entity_Store::Handle Handle;
+            typedef uint32_t             Clip;
+
+            enum Playback : uint8_t
+            {
+                ONCE,                           ///< Se detiene en el último fotograma.
+                LOOP,
+                PING_PONG,                      ///< Avanza y retrocede alternativamente.
+            };
+
+            static constexpr Clip invalid_clip = 0xFFFFFFFF;
+
+        private:
+
+            struct Clip_Data
+            {
+                uint32_t first_frame;           ///< Posición del primer fotograma en frames.
+                uint32_t frame_count;
+                float    frames_per_second;
+                Playback playback;
+            };
+
+        private:
+
+            std::vector< const Atlas::Slice * > frames;
+            std::vector< Clip_Data            > clips;
+
+            // Columnas densas (una posición por entidad animada):
+
+            std::vector< Handle   > handles;
+            std::vector< uint32_t > instance_clips;
+            std::vector< float    > elapsed;            ///< Tiempo transcurrido medido en fotogramas.
+            std::vector< float    > speeds;
+            std::vector< float    > rates;              ///< Fotogramas por segundo del clip por la velocidad (0 en pausa).
+            std::vector< uint32_t > current_frames;
+
+            std::vector< uint32_t > slots;              ///< Posición en las columnas de cada índice de entidad.
+            std::vector< uint32_t > dead;
+
+        public:
+
+            /**
+             * Añade un clip formado por los slices del atlas cuyos ids se indican, en ese orden.
+             * Los ids que no existen en el atlas se descartan.
+             * @return Identificador del clip o invalid_clip si no se ha encontrado ningún fotograma.
+             */
+            Clip add_clip (const Atlas & atlas, const std::vector< Id > & frame_ids, float frames_per_second, Playback playback = LOOP);
+
+            /**
+             * Añade un clip cuyos fotogramas se llaman prefix0, prefix1... prefixN-1 (por ejemplo,
+             * "hero.walk." dentro de un dir "hero" con sprites llamados "walk.0", "walk.1"...).
+             */
+            Clip add_clip (const Atlas & atlas, const std::string & prefix, unsigned frame_count, float frames_per_second, Playback playback = LOOP);
+
+            size_t get_clip_count () const
+            {
+                return clips.size ();
+            }
+
+            float get_clip_duration (Clip clip) const
+            {
+                return clips[clip].frame_count / clips[clip].frames_per_second;
+            }
+
+        public:
+
+            /**
+             * Empieza a reproducir un clip sobre una entidad desde su primer fotograma (o lo
+             * reinicia si ya se estaba reproduciendo otro). El slice de la entidad se cambia en el
+             * momento.
+             */
+            void play   (Entity_Store & store, const Handle & entity, Clip clip, float speed = 1.f);
+            void pause  (const Handle & entity);
+            void resume (const Handle & entity);
+            void stop   (const Handle & entity);
+            void clear  ();
+            void reserve (size_t capacity);
+
+            void set_speed (const Handle & entity, float speed);
+
+            bool contains (const Handle & entity) const
+            {
+                return entity.index < slots.size () && slots[entity.index] != Entity_Store::invalid_index && handles[slots[entity.index]] == entity;
+            }
+
+            bool is_playing (const Handle & entity) const
+            {
+                return contains (entity) && rates[slots[entity.index]] != 0.f;
+            }
+
+            uint32_t get_frame (const Handle & entity) const
+            {
+                return current_frames[slots[entity.index]];
+            }
+
+            size_t size () const
+            {
+                return handles.size ();
+            }
+
+        public:
+
+            /**
+             * Avanza todas las animaciones y cambia el slice de las entidades cuyo fotograma ha
+             * cambiado. Las entidades destruidas se descartan.
+             */
+            void update (float time, Entity_Store & store);
+
+        private:
+
+            void remove (uint32_t slot);
+
+        };
+
+    }
+
+#endif
@@ -0,0 +1,255 @@
+/*
+ *  TWEENER
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C1802151710
+ */
+
+#ifndef BASICS_TWEENER_HEADER
+#define BASICS_TWEENER_HEADER
+
+    #include <cstdint>
+    #include <vector>
+    #include <basics/Entity_Store>
+    #include <basics/Non_Copyable>
+
+    namespace basics
+    {
+
+        /**
+         * Interpola valores float a lo largo del tiempo (opacidades, posiciones, tamaños...).
+         * Todas las interpolaciones activas se guardan en arrays contiguos y se avanzan juntas con
+         * una única llamada a update() por fotograma. Cada una puede pertenecer a uno de 32 grupos
+         * que se pausan y reanudan a la vez.
+         * Al terminar se llama a una función con un puntero de contexto, por lo que añadir una
+         * interpolación no reserva memoria una vez que los arrays han crecido lo suficiente.
+         */
+        class Tweener : Non_Copyable
+        {
+        public:
+
+            enum Easing : uint8_t
+            {
+                LINEAR,
+                QUADRATIC_IN,
+                QUADRATIC_OUT,
+                QUADRATIC_IN_OUT,
+                CUBIC_IN,
+                CUBIC_OUT,
+                CUBIC_IN_OUT,
+                SINE_IN_OUT,
+                BACK_OUT,
+                STEP,
+            };
+
+            /**
+             * Propiedades de las entidades de un Entity_Store que se pueden interpolar.
+             */
+            enum Property : uint8_t
+            {
+                POSITION_X,
+                POSITION_Y,
+                WIDTH,
+                HEIGHT,
+            };
+
+            struct Handle
+            {
+                uint32_t index;
+                uint32_t generation;
+
+                Handle() : index(invalid_index), generation(0)
+                {
+                }
+
+                Handle(uint32_t index, uint32_t generation) : index(index), generation(generation)
+                {
+                }
+
+                bool operator == (const Handle & other) const
+                {
+                    return index == other.index && generation == other.generation;
+                }
+
+                bool operator != (const Handle & other) const
+                {
+                    return !(*this == other);
+                }
+            };
+
+            /**
+             * Se llama cuando una interpolación termina (no cuando se cancela). Puede añadir o
+             * cancelar otras interpolaciones.
+             */
+            typedef void (* Callback) (void * context, Handle tween);
+
+            static constexpr uint32_t invalid_index = 0xFFFFFFFF;
+            static constexpr unsigned group_count   = 32;
+
+        private:
+
+            struct Completion
+            {
+                Callback callback;
+                void   * context;
+                Handle   handle;
+            };
+
+        private:
+
+            // Columnas densas (una posición por interpolación activa):
+
+            std::vector< float    > elapsed;            ///< Negativo mientras dura el retardo inicial.
+            std::vector< float    > inverse_durations;
+            std::vector< float    > progress;           ///< Valor entre 0 y 1 ya suavizado.
+            std::vector< float    > starts;
+            std::vector< float    > deltas;
+            std::vector< uint8_t  > easings;
+            std::vector< uint8_t  > groups;
+            std::vector< float  * > targets;            ///< nullptr si el destino es una entidad.
+            std::vector< Entity_Store * > stores;
+            std::vector< Entity_Store::Handle > entities;
+            std::vector< uint8_t  > properties;
+            std::vector< Callback > callbacks;
+            std::vector< void   * > contexts;
+            std::vector< uint32_t > owners;
+
+            // Tabla de indirección de los handles:
+
+            std::vector< uint32_t > positions;
+            std::vector< uint32_t > generations;
+            std::vector< uint32_t > free_indices;
+
+            std::vector< uint32_t   > finished;
+            std::vector< Completion > completions;
+
+            uint32_t paused_groups;                     ///< Un bit por grupo.
+
+        public:
+
+            Tweener() : paused_groups(0)
+            {
+            }
+
+        public:
+
+            /**
+             * Interpola el float apuntado por target desde from hasta to. El puntero debe seguir
+             * siendo válido mientras la interpolación esté activa.
+             */
+            Handle add
+            (
+                float  * target,
+                float    from,
+                float    to,
+                float    duration,
+                Easing   easing    = LINEAR,
+                float    delay     = 0.f,
+                Callback callback  = nullptr,
+                void   * context   = nullptr,
+                unsigned group     = 0
+            );
+
+            /**
+             * Interpola una propiedad de una entidad. Si la entidad se destruye la interpolación
+             * sigue su curso sin efecto.
+             */
+            Handle add
+            (
+                Entity_Store                & store,
+                const Entity_Store::Handle  & entity,
+                Property                      property,
+                float                         from,
+                float                         to,
+                float                         duration,
+                Easing                        easing    = LINEAR,
+                float                         delay     = 0.f,
+                Callback                      callback  = nullptr,
+                void                        * context   = nullptr,
+                unsigned                      group     = 0
+            );
+
+            void cancel (const Handle & handle);
+            void clear  ();
+            void reserve (size_t capacity);
+
+            bool is_active (const Handle & handle) const
+            {
+                return
+                    handle.index < generations.size () &&
+                    generations[handle.index] == handle.generation &&
+                    positions  [handle.index] != invalid_index;
+            }
+
+            size_t size () const
+            {
+                return owners.size ();
+            }
+
+        public:
+
+            void pause (unsigned group)
+            {
+                paused_groups |=  (1u << group);
+            }
+
+            void resume (unsigned group)
+            {
+                paused_groups &= ~(1u << group);
+            }
+
+            void pause_all ()
+            {
+                paused_groups = 0xFFFFFFFF;
+            }
+
+            void resume_all ()
+            {
+                paused_groups = 0;
+            }
+
+            bool is_paused (unsigned group) const
+            {
+                return (paused_groups & (1u << group)) != 0;
+            }
+
+        public:
+
+            /**
+             * Avanza todas las interpolaciones de los grupos no pausados, escribe los nuevos valores
+             * y llama a los callbacks de las que terminan.
+             */
+            void update (float time);
+
+            static float ease (Easing easing, float t);
+
+        private:
+
+            Handle add
+            (
+                float                       * target,
+                Entity_Store                * store,
+                const Entity_Store::Handle  & entity,
+                Property                      property,
+                float                         from,
+                float                         to,
+                float                         duration,
+                Easing                        easing,
+                float                         delay,
+                Callback                      callback,
+                void                        * context,
+                unsigned                      group
+            );
+
+            void remove (size_t position);
+
+        };
+
+    }
+
+#endif
@@ -0,0 +1,89 @@
+/*
+ *  WORKER POOL
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C1802231300
+ */
+
+#ifndef BASICS_WORKER_POOL_HEADER
+#define BASICS_WORKER_POOL_HEADER
+
+    #include <atomic>
+    #include <condition_variable>
+    #include <cstdint>
+    #include <functional>
+    #include <mutex>
+    #include <thread>
+    #include <vector>
+    #include <basics/Non_Copyable>
+
+    namespace basics
+    {
+
+        /**
+         * Hilos que se crean una sola vez y se reutilizan para repartir trabajo dentro de un
+         * fotograma (por ejemplo, el sistema de movimiento de Entity_Store). Los hilos se crean
+         * la primera vez que se necesitan y esperan dormidos entre una tanda y la siguiente.
+         * Despertarlos cuesta unos microsegundos, por lo que solo compensa con tandas que tardan
+         * bastante más que eso en un solo hilo.
+         */
+        class Worker_Pool final : Non_Copyable
+        {
+        public:
+
+            typedef std::function< void (size_t task_index) > Task;
+
+        private:
+
+            std::vector< std::thread > threads;
+
+            std::mutex                 run_mutex;           ///< Solo se ejecuta una tanda a la vez.
+            std::mutex                 mutex;
+            std::condition_variable    wake_condition;
+            std::condition_variable    done_condition;
+
+            const Task               * task;
+            size_t                     task_count;
+            std::atomic< size_t >      next_task;
+            size_t                     pending_count;       ///< Tareas de la tanda sin terminar.
+            size_t                     active_count;        ///< Hilos del pool que están tomando tareas.
+            uint64_t                   generation;          ///< Cambia con cada tanda.
+            bool                       stopping;
+
+        public:
+
+            Worker_Pool();
+           ~Worker_Pool();
+
+        public:
+
+            /**
+             * Llama a task(0), task(1)... task(task_count - 1) repartiendo las llamadas entre el
+             * hilo que llama, que también trabaja, y hasta thread_count - 1 hilos del pool. Retorna
+             * cuando han terminado todas.
+             */
+            void run (size_t task_count, unsigned thread_count, const Task & task);
+
+            size_t get_thread_count () const
+            {
+                return threads.size ();
+            }
+
+        private:
+
+            void   ensure_threads  (size_t count);
+            void   thread_function ();
+            size_t run_tasks       ();
+
+        };
+
+        extern Worker_Pool worker_pool;
+
+    }
+
+#endif
@@ -0,0 +1,350 @@
+/*
+ * BROAD PHASE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802151130
+ */
+
+#include <algorithm>
+#include <limits>
+#include <basics/Broad_Phase>
+
+namespace basics
+{
+
+    namespace
+    {
+
+        // Caja de las entidades ocultas: queda al final de la lista ordenada y no se solapa con nada.
+
+        const kernels::Bounds2f inactive_bounds = kernels::Bounds2f::none ();
+
+        kernels::Bounds2f entity_bounds (const Entity_Store & store, size_t position)
+        {
+            float left   = store.get_left_x   (position);
+            float bottom = store.get_bottom_y (position);
+
+            return { left, bottom, left + store.get_widths ()[position], bottom + store.get_heights ()[position] };
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Broad_Phase::add (const Handle & handle, const Bounds & new_bounds, bool is_continuous)
+    {
+        if (!handle.is_valid () || contains (handle)) return;
+
+        if (handle.index >= slots.size ())
+        {
+            slots.resize (handle.index + 1, Entity_Store::invalid_index);
+        }
+        else
+        if (slots[handle.index] != Entity_Store::invalid_index)
+        {
+            remove (slots[handle.index]);       // Entidad destruida cuyo índice se ha reutilizado
+        }
+
+        uint32_t proxy = uint32_t(handles.size ());
+
+        handles   .push_back (handle);
+        bounds    .push_back (new_bounds);
+        continuous.push_back (is_continuous);
+        sorted    .push_back ({ new_bounds.left, proxy });
+
+        slots[handle.index] = proxy;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Broad_Phase::add (const Entity_Store & store, const Handle & handle, bool is_continuous)
+    {
+        if (store.is_alive (handle))
+        {
+            size_t position = store.position_of (handle);
+
+            add (handle, store.get_visibilities ()[position] ? entity_bounds (store, position) : inactive_bounds, is_continuous);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Broad_Phase::remove (const Handle & handle)
+    {
+        if (contains (handle)) remove (slots[handle.index]);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Broad_Phase::remove (uint32_t proxy)
+    {
+        uint32_t last = uint32_t(handles.size () - 1);
+
+        // Se quita de la lista ordenada sin alterar el orden del resto y el último proxy pasa a
+        // ocupar el hueco:
+
+        for (size_t i = 0; i < sorted.size (); )
+        {
+            if (sorted[i].proxy == proxy)
+            {
+                sorted.erase (sorted.begin () + i);
+            }
+            else
+            {
+                if (sorted[i].proxy == last) sorted[i].proxy = proxy;
+
+                ++i;
+            }
+        }
+
+        slots[handles[proxy].index] = Entity_Store::invalid_index;
+
+        if (proxy != last)
+        {
+            handles   [proxy] = handles   [last];
+            bounds    [proxy] = bounds    [last];
+            continuous[proxy] = continuous[last];
+
+            slots[handles[proxy].index] = proxy;
+        }
+
+        handles   .pop_back ();
+        bounds    .pop_back ();
+        continuous.pop_back ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Broad_Phase::clear ()
+    {
+        handles       .clear ();
+        bounds        .clear ();
+        continuous    .clear ();
+        slots         .clear ();
+        sorted        .clear ();
+        pairs         .clear ();
+        previous_pairs.clear ();
+        overlaps      .clear ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Broad_Phase::set_bounds (const Handle & handle, const Bounds & new_bounds)
+    {
+        if (contains (handle)) bounds[slots[handle.index]] = new_bounds;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Broad_Phase::synchronize (const Entity_Store & store, float time)
+    {
+        const float   * speeds_x     = store.get_speeds_x     ();
+        const float   * speeds_y     = store.get_speeds_y     ();
+        const uint8_t * visibilities = store.get_visibilities ();
+
+        for (uint32_t proxy = 0; proxy < handles.size (); )
+        {
+            if (!store.is_alive (handles[proxy]))
+            {
+                remove (proxy);                 // Se sustituye por el último proxy
+                continue;
+            }
+
+            size_t position = store.position_of (handles[proxy]);
+
+            if (!visibilities[position])
+            {
+                bounds[proxy] = inactive_bounds;
+            }
+            else
+            {
+                Bounds box = entity_bounds (store, position);
+
+                if (continuous[proxy])
+                {
+                    // Se amplía la caja con la posición que tendrá al final del fotograma:
+
+                    float dx = speeds_x[position] * time;
+                    float dy = speeds_y[position] * time;
+
+                    if (dx < 0.f) box.left   += dx; else box.right += dx;
+                    if (dy < 0.f) box.bottom += dy; else box.top   += dy;
+                }
+
+                bounds[proxy] = box;
+            }
+
+            ++proxy;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    const std::vector< Broad_Phase::Overlap > & Broad_Phase::update ()
+    {
+        sort     ();
+        sweep    ();
+        classify ();
+
+        return overlaps;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Broad_Phase::sort ()
+    {
+        for (auto & endpoint : sorted)
+        {
+            endpoint.left = bounds[endpoint.proxy].left;
+        }
+
+        // Ordenación por inserción: casi lineal cuando la lista ya estaba casi ordenada.
+
+        for (size_t i = 1, count = sorted.size (); i < count; ++i)
+        {
+            Endpoint endpoint = sorted[i];
+            size_t   j        = i;
+
+            for ( ; j > 0 && sorted[j - 1].left > endpoint.left; --j)
+            {
+                sorted[j] = sorted[j - 1];
+            }
+
+            sorted[j] = endpoint;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Broad_Phase::sweep ()
+    {
+        pairs.clear ();
+
+        for (size_t i = 0, count = sorted.size (); i < count; ++i)
+        {
+            const Bounds & a = bounds[sorted[i].proxy];
+
+            for (size_t j = i + 1; j < count && sorted[j].left <= a.right; ++j)
+            {
+                const Bounds & b = bounds[sorted[j].proxy];
+
+                if (b.bottom <= a.top && b.top >= a.bottom)
+                {
+                    const Handle & first  = handles[sorted[i].proxy];
+                    const Handle & second = handles[sorted[j].proxy];
+
+                    if (first.index < second.index)
+                    {
+                        pairs.push_back ({ uint64_t(first.index) << 32 | second.index, first, second });
+                    }
+                    else
+                    {
+                        pairs.push_back ({ uint64_t(second.index) << 32 | first.index, second, first });
+                    }
+                }
+            }
+        }
+
+        std::sort (pairs.begin (), pairs.end ());
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Broad_Phase::classify ()
+    {
+        overlaps.clear ();
+
+        // Ambas listas están ordenadas por clave, por lo que se pueden comparar mezclándolas:
+
+        auto current  = pairs.begin ();
+        auto previous = previous_pairs.begin ();
+
+        while (current != pairs.end () || previous != previous_pairs.end ())
+        {
+            if (previous == previous_pairs.end () || (current != pairs.end () && current->key < previous->key))
+            {
+                overlaps.push_back ({ current->first, current->second, BEGIN });
+                ++current;
+            }
+            else
+            if (current == pairs.end () || previous->key < current->key)
+            {
+                overlaps.push_back ({ previous->first, previous->second, END });
+                ++previous;
+            }
+            else
+            {
+                // Misma clave. Si alguna entidad ha sido sustituida por otra que reutiliza su índice
+                // se trata como una pareja distinta:
+
+                if (current->first == previous->first && current->second == previous->second)
+                {
+                    overlaps.push_back ({ current->first, current->second, PERSIST });
+                }
+                else
+                {
+                    overlaps.push_back ({ previous->first, previous->second, END   });
+                    overlaps.push_back ({ current ->first, current ->second, BEGIN });
+                }
+
+                ++current;
+                ++previous;
+            }
+        }
+
+        previous_pairs.swap (pairs);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Broad_Phase::time_of_impact
+    (
+        const Bounds   & a,
+        const Vector2f & speed_a,
+        const Bounds   & b,
+        const Vector2f & speed_b,
+        float            time,
+        float          & impact_time
+    )
+    {
+        // Se considera que a está quieta y b se mueve con la velocidad relativa:
+
+        const float infinity = std::numeric_limits< float >::infinity ();
+
+        float entry = -infinity;
+        float exit  =  infinity;
+
+        const float a_min[] = { a.left,  a.bottom }, a_max[] = { a.right, a.top };
+        const float b_min[] = { b.left,  b.bottom }, b_max[] = { b.right, b.top };
+
+        for (unsigned axis = 0; axis < 2; ++axis)
+        {
+            float speed = speed_b[axis] - speed_a[axis];
+
+            if (speed == 0.f)
+            {
+                if (b_max[axis] < a_min[axis] || b_min[axis] > a_max[axis]) return false;
+            }
+            else
+            {
+                float t1 = (a_min[axis] - b_max[axis]) / speed;
+                float t2 = (a_max[axis] - b_min[axis]) / speed;
+
+                entry = std::max (entry, std::min (t1, t2));
+                exit  = std::min (exit,  std::max (t1, t2));
+            }
+        }
+
+        if (entry > exit || exit < 0.f || entry > time) return false;
+
+        impact_time = std::max (entry, 0.f);
+
+        return true;
+    }
+
+}
@@ -12,12 +12,17 @@
 
 #include <basics/Application>
 #include <basics/Director>
+#include <basics/Frame_Arena>
 #include <basics/Log>
+#include <basics/Profiler>
+#include <basics/Render_Statistics>
 #include <basics/Scene>
+#include <basics/Startup_Timeline>
 #include <basics/Timer>
 #include <basics/Window>
 #include <basics/opengles/Canvas_ES2>
 #include <basics/opengles/Context>
+#include <basics/opengles/GL_Recorder>
 
 namespace basics
 {
@@ -30,6 +35,10 @@ namespace basics
     {
         kernel.running           = false;
         graphics_context_factory = opengles::Context::create;
+        frame_input_count        = 0;
+        late_input_latching      = false;
+        replaying                = false;
+        exit_after_replay        = false;
     }
 
     // ---------------------------------------------------------------------------------------------
@@ -69,6 +78,8 @@ namespace basics
 
     void Director::run_kernel ()
     {
+        startup_timeline.mark ("director started");
+
         kernel.running = true;
         kernel.exit    = false;
 
@@ -91,20 +102,21 @@ namespace basics
 
             if (target_scene)
             {
-                // If the current scene must be replaced, then it is first finalized:
-
-                if (current_scene) current_scene->finalize ();
+                // If the current scene must be replaced, then it is first finalized and then
+                // possibly destroyed:
 
-                // And then possibly destroyed:
-
-                current_scene.reset ();
+                finalize_scene ();
 
                 // The new scene is then initialized:
 
+                scene_memory = memory_tracker.get_snapshot ();
+
                 if (target_scene->initialize ())
                 {
                     // If the initialization succeeded, then it is made current:
 
+                    startup_timeline.mark ("scene initialized");
+
                     current_scene = target_scene;
 
                     // The target pointer is cleared:
@@ -125,69 +137,93 @@ namespace basics
                 }
             }
 
+            // When a recording is being replayed, it provides the input and the duration of
+            // the frame instead of the live input and the timer:
+
+            if (replaying) replay_frame_input (time);
+
             bool previously_active = state;
 
-            while (application.poll (event))
+            BASICS_PROFILE_FRAME();
+
+            for (unsigned category = 0; category < Memory_Tracker::CATEGORY_COUNT; ++category)
             {
-                switch (event.id)
-                {
-                    case Application::Event_Id::RESUME:
-                    {
-                        state.active = true;
-                        break;
-                    }
+                BASICS_PROFILE_COUNTER
+                (
+                    Memory_Tracker::get_name    (Memory_Tracker::Category(category)),
+                    memory_tracker.get_current  (Memory_Tracker::Category(category))
+                );
+            }
 
-                    case Application::Event_Id::SUSPEND:
-                    {
-                        state.active = false;
-                        break;
-                    }
+            {
+                BASICS_PROFILE_ZONE("Application::poll");
+
+                while (application.poll (event))
+                {
+                    input_recorder.record_application_event (event);
 
-                    case Application::Event_Id::WINDOW_CREATED:
+                    switch (event.id)
                     {
-                        window_handle = Window::get_window (default_window_id);
+                        case Application::Event_Id::RESUME:
+                        {
+                            state.active = true;
+                            break;
+                        }
 
-                        Window::Accessor window = window_handle.lock ();
+                        case Application::Event_Id::SUSPEND:
+                        {
+                            state.active = false;
+                            break;
+                        }
 
-                        if (graphics_context_factory)
+                        case Application::Event_Id::WINDOW_CREATED:
                         {
-                            if (!window->has_graphics_context ())
+                            window_handle = Window::get_window (default_window_id);
+
+                            Window::Accessor window = window_handle.lock ();
+
+                            if (graphics_context_factory)
                             {
-                                if (!graphics_context_factory (window, &graphics_resource_cache))
+                                if (!window->has_graphics_context ())
                                 {
-                                    log.e ("ERROR: failed to initialize the OpenGL ES context!");
+                                    if (!graphics_context_factory (window, &graphics_resource_cache))
+                                    {
+                                        log.e ("ERROR: failed to initialize the OpenGL ES context!");
+
+                                        return;
+                                    }
 
-                                    return;
+                                    startup_timeline.mark ("graphics context created");
                                 }
-                            }
 
-                            reset_viewport (window);
+                                reset_viewport (window);
 
-                            state.graphics = true;
-                        }
+                                state.graphics = true;
+                            }
 
-                        break;
-                    }
+                            break;
+                        }
 
-                    case Application::Event_Id::WINDOW_DESTROYED:
-                    {
-                        state.graphics = false;
-                        break;
-                    }
+                        case Application::Event_Id::WINDOW_DESTROYED:
+                        {
+                            state.graphics = false;
+                            break;
+                        }
 
-                    case Application::Event_Id::CONFIGURATION_CHANGED:
-                    {
-                        Window::Accessor window = window_handle.lock ();
+                        case Application::Event_Id::CONFIGURATION_CHANGED:
+                        {
+                            Window::Accessor window = window_handle.lock ();
 
-                        reset_viewport  (window);
+                            reset_viewport  (window);
 
-                        break;
-                    }
+                            break;
+                        }
 
-                    case Application::Event_Id::QUIT:
-                    {
-                        kernel.exit = true;
-                        break;
+                        case Application::Event_Id::QUIT:
+                        {
+                            kernel.exit = true;
+                            break;
+                        }
                     }
                 }
             }
@@ -198,15 +234,19 @@ namespace basics
 
                 if (window)
                 {
-                    while (window->poll (event))
                     {
-                        switch (event.id)
+                        BASICS_PROFILE_ZONE("Window::poll");
+
+                        while (window->poll (event))
                         {
-                            case Window::GOT_FOCUS:             state.focused = true;    break;
-                            case Window::LOST_FOCUS:            state.focused = false;   break;
-                            case Window::LOST_GRAPHICS_CONTEXT:                          break;
-                            case Window::RESIZED:
-                            case Window::VIEWPORT_RESIZED:      reset_viewport (window); break;
+                            switch (event.id)
+                            {
+                                case Window::GOT_FOCUS:             state.focused = true;    break;
+                                case Window::LOST_FOCUS:            state.focused = false;   break;
+                                case Window::LOST_GRAPHICS_CONTEXT:                          break;
+                                case Window::RESIZED:
+                                case Window::VIEWPORT_RESIZED:      reset_viewport (window); break;
+                            }
                         }
                     }
 
@@ -224,28 +264,32 @@ namespace basics
                             float  h_ratio = float(scene_view_size.width ) / surface_width;
                             float  v_ratio = float(scene_view_size.height) / surface_height;
 
-                            while (event_queue.poll (event))
-                            {
-                                switch (event.id)
-                                {
-                                    case ID(touch-started):
-                                    case ID(touch-moved):
-                                    case ID(touch-ended):
-                                    {
-                                        float x = *event.properties[ID(x)].as< var::Float > ();
-                                        float y = *event.properties[ID(y)].as< var::Float > ();
+                            frame_input_count = 0;
 
-                                        event.properties[ID(x)] = x * h_ratio;
-                                        event.properties[ID(y)] = (surface_height - y) * v_ratio;
+                            size_t  event_queue_depth = event_queue.size ();
+                            int64_t phase_start       = Timer::get_monotonic_nanoseconds ();
 
-                                        break;
-                                    }
-                                }
+                            dispatch_input (h_ratio, v_ratio);
+
+                            int64_t input_end = Timer::get_monotonic_nanoseconds ();
 
-                                current_scene->handle (event);
+                            {
+                                BASICS_PROFILE_ZONE("Scene::update");
+
+                                current_scene->update (time);
                             }
 
-                            current_scene->update (time);
+                            int64_t update_end = Timer::get_monotonic_nanoseconds ();
+
+                            // With late latching the input received during the update is handled
+                            // as close to the rendering as possible:
+
+                            if (late_input_latching) dispatch_input (h_ratio, v_ratio);
+
+                            int64_t late_input_end = Timer::get_monotonic_nanoseconds ();
+
+                            performance_hud.record_phase (Performance_Hud::INPUT,  float(input_end - phase_start + late_input_end - update_end) * 1e-9f);
+                            performance_hud.record_phase (Performance_Hud::UPDATE, float(update_end - input_end) * 1e-9f);
 
                             Graphics_Context::Accessor graphics_context = window->lock_graphics_context ();
 
@@ -258,28 +302,287 @@ namespace basics
                                     if (canvas) canvas->reset_state ();
                                 }
 
-                                current_scene->render (graphics_context);
+                                render_statistics.begin_frame ();
+
+                                #if defined(BASICS_OPENGLES_GL_RECORDER)
+                                    opengles::gl_recorder.begin_frame ();
+                                #endif
+
+                                {
+                                    BASICS_PROFILE_ZONE("Scene::render");
+
+                                    current_scene->render (graphics_context);
+                                }
+
+                                int64_t render_end = Timer::get_monotonic_nanoseconds ();
+
+                                performance_hud.record_phase (Performance_Hud::RENDER, float(render_end - late_input_end) * 1e-9f);
+
+                                // The overlay is drawn after the scene and before the frame is
+                                // presented, with the statistics of the scene alone:
+
+                                if (performance_hud.is_visible ())
+                                {
+                                    Canvas * canvas = graphics_context->get_renderer< Canvas > (ID(canvas));
+
+                                    if (canvas)
+                                    {
+                                        performance_hud.capture_render_statistics ();
+                                        performance_hud.render (*canvas, scene_view_size);
+                                    }
+                                }
+
+                                record_frame_latency (input_latency.to_render);
+
+                                int64_t flush_start = Timer::get_monotonic_nanoseconds ();
+
+                                {
+                                    BASICS_PROFILE_ZONE("flush_and_display");
+
+                                    graphics_context->flush_and_display ();
+                                }
 
-                                graphics_context->flush_and_display ();
+                                performance_hud.record_phase (Performance_Hud::FLUSH, float(Timer::get_monotonic_nanoseconds () - flush_start) * 1e-9f);
+
+                                record_frame_latency (input_latency.to_display);
+
+                                // El arranque en frío termina al presentar el primer fotograma,
+                                // por lo que aquí se cierra la línea de tiempo y se informa de ella:
+
+                                if (startup_timeline.is_open ())
+                                {
+                                    startup_timeline.mark   ("first frame presented");
+                                    startup_timeline.finish ();
+                                }
                             }
+
+                            performance_hud.record_frame (time, event_queue_depth);
                         }
                     }
                 }
             }
 
+            input_recorder.end_frame (time);
+
+            // Everything allocated in the frame arena during this frame is released at once:
+
+            BASICS_PROFILE_COUNTER("frame arena", int64_t(frame_arena.get_used ()));
+
+            frame_arena.reset ();
+
             time = timer.get_elapsed_seconds ();
         }
         while (!kernel.exit && current_scene);
 
-        if (current_scene) current_scene->finalize ();
-
-        current_scene.reset ();
+        finalize_scene ();
 
         kernel.running = false;
     }
 
     // ---------------------------------------------------------------------------------------------
 
+    void Director::finalize_scene ()
+    {
+        if (current_scene)
+        {
+            current_scene->finalize ();
+            current_scene.reset ();
+
+            // Anything the scene left allocated is reported. Scene objects are not compared
+            // because the next scene already exists at this point, and pools keep their slabs
+            // for the next scene on purpose:
+
+            memory_tracker.report_leaks
+            (
+                scene_memory,
+                "Scene::finalize",
+                1u << Memory_Tracker::SCENES | 1u << Memory_Tracker::POOLS | 1u << Memory_Tracker::FRAME
+            );
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Director::start_replay (const std::string & path, bool exit_at_end)
+    {
+        std::unique_ptr< Input_Replayer > new_replayer(new Input_Replayer(path));
+
+        if (!new_replayer->good ()) return false;
+
+        replayer          = std::move (new_replayer);
+        exit_after_replay = exit_at_end;
+        replaying         = true;
+
+        // Live touches received so far are discarded so that they don't mix with the recording:
+
+        std::lock_guard< std::mutex > lock(touches_mutex);
+
+        pending_touches.clear ();
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Director::stop_replay ()
+    {
+        replaying = false;
+
+        replayer.reset ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Director::replay_frame_input (float & time)
+    {
+        if (!replayer->read_frame (replay_frame))
+        {
+            log.i ("input replay finished");
+
+            stop_replay ();
+
+            if (exit_after_replay) kernel.exit = true;
+
+            return false;
+        }
+
+        time = replay_frame.time;
+
+        // The recorded input is queued as if it had just been received, so it's delivered in
+        // this frame through the usual path:
+
+        for (auto & event : replay_frame.application_events)
+        {
+            switch (event.id)
+            {
+                case Application::Event_Id::WINDOW_CREATED:
+                case Application::Event_Id::WINDOW_DESTROYED:
+                case Application::Event_Id::CONFIGURATION_CHANGED: break;
+
+                default: application.push (event);
+            }
+        }
+
+        for (auto & event : replay_frame.events) event_queue.push (event);
+
+        if (!replay_frame.touches.empty ())
+        {
+            std::lock_guard< std::mutex > lock(touches_mutex);
+
+            pending_touches.append (replay_frame.touches);
+        }
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Director::dispatch_input (float h_ratio, float v_ratio)
+    {
+        BASICS_PROFILE_ZONE("Director::dispatch_input");
+
+        // The pending input events are drained in batches, so the queue is only touched once for
+        // up to event_batch_size events:
+
+        size_t event_count;
+
+        while ((event_count = event_queue.poll (frame_events, event_batch_size)) > 0)
+        {
+            int64_t now = Timer::get_monotonic_nanoseconds ();
+
+            for (size_t index = 0; index < event_count; ++index)
+            {
+                Event & event = frame_events[index];
+
+                input_recorder.record_event (event);
+
+                switch (event.id)
+                {
+                    case ID(touch-started):
+                    case ID(touch-moved):
+                    case ID(touch-ended):
+                    {
+                        Var & x = event.properties[ID(x)];
+                        Var & y = event.properties[ID(y)];
+
+                        x = *x.as< var::Float > () * h_ratio;
+                        y = (surface_height - *y.as< var::Float > ()) * v_ratio;
+
+                        break;
+                    }
+                }
+
+                track_input_latency (event.timestamp, now);
+
+                current_scene->handle (event);
+            }
+        }
+
+        // All the touch samples received since the previous dispatch are rescaled in bulk and
+        // delivered to the scene as a single packet:
+
+        {
+            std::lock_guard< std::mutex > lock(touches_mutex);
+
+            frame_touches = pending_touches;
+
+            pending_touches.clear ();
+        }
+
+        if (!frame_touches.empty ())
+        {
+            int64_t now = Timer::get_monotonic_nanoseconds ();
+
+            for (size_t index = 0, count = frame_touches.size (); index < count; ++index)
+            {
+                if (!frame_touches.is_historical (index))
+                {
+                    track_input_latency (frame_touches.get_timestamp (index), now);
+                }
+            }
+
+            input_recorder.record_touches (frame_touches);
+
+            frame_touches.rescale (h_ratio, v_ratio, surface_height);
+
+            current_scene->handle_touches (frame_touches);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Director::track_input_latency (int64_t timestamp, int64_t now)
+    {
+        // The timestamps of replayed input belong to the recording session:
+
+        if (timestamp > 0 && !replaying)
+        {
+            input_latency.to_handle.record (now - timestamp);
+
+            if (frame_input_count < max_tracked_inputs)
+            {
+                frame_input_timestamps[frame_input_count++] = timestamp;
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Director::record_frame_latency (Latency_Histogram & histogram)
+    {
+        if (frame_input_count > 0)
+        {
+            int64_t now = Timer::get_monotonic_nanoseconds ();
+
+            for (size_t index = 0; index < frame_input_count; ++index)
+            {
+                histogram.record (now - frame_input_timestamps[index]);
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
     void Director::reset_viewport (Window::Accessor & window)
     {
         Graphics_Context::Accessor graphics_context = window->lock_graphics_context ();
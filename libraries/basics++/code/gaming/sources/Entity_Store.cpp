@@ -0,0 +1,385 @@
+/*
+ * ENTITY STORE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802141020
+ */
+
+#include <algorithm>
+#include <thread>
+#include <basics/Entity_Store>
+#include <basics/Kernels>
+#include <basics/Worker_Pool>
+
+namespace basics
+{
+
+    constexpr uint32_t Entity_Store::invalid_index;
+    constexpr size_t   Entity_Store::parallel_threshold;
+
+    // ---------------------------------------------------------------------------------------------
+
+    namespace
+    {
+
+        template< typename TYPE >
+        void gather (std::vector< TYPE > & column, const std::vector< uint32_t > & order)
+        {
+            std::vector< TYPE > sorted;
+
+            sorted.reserve (column.capacity ());
+
+            for (uint32_t position : order) sorted.push_back (column[position]);
+
+            column.swap (sorted);
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Entity_Store::Entity_Store()
+    {
+        hidden_count  = 0;
+        worker_count  = std::max (std::thread::hardware_concurrency (), 1u);
+        next_sequence = 0;
+        unordered     = false;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Entity_Store::Handle Entity_Store::create (const Texture_2D * texture, const Size2f & size, int anchor)
+    {
+        return add (texture, nullptr, size, anchor);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Entity_Store::Handle Entity_Store::create (const Atlas::Slice * slice, const Size2f & size, int anchor)
+    {
+        return add (nullptr, slice, size, anchor);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Entity_Store::Handle Entity_Store::add (const Texture_2D * texture, const Atlas::Slice * slice, const Size2f & size, int anchor)
+    {
+        uint32_t index;
+
+        if (free_indices.empty ())
+        {
+            index = uint32_t(generations.size ());
+
+            generations.push_back (0);
+            positions  .push_back (invalid_index);
+        }
+        else
+        {
+            index = free_indices.back ();
+
+            free_indices.pop_back ();
+        }
+
+        positions[index] = uint32_t(owners.size ());
+
+        xs          .push_back (0.f);
+        ys          .push_back (0.f);
+        speeds_x    .push_back (0.f);
+        speeds_y    .push_back (0.f);
+        widths      .push_back (size.width );
+        heights     .push_back (size.height);
+        anchors     .push_back (anchor );
+        visibilities.push_back (1);
+        textures    .push_back (texture);
+        slices      .push_back (slice  );
+        owners      .push_back (index  );
+        sequences   .push_back (next_sequence++);
+
+        return Handle(index, generations[index]);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Entity_Store::destroy (const Handle & handle)
+    {
+        if (!is_alive (handle)) return;
+
+        // La última entidad pasa a ocupar el hueco para que destruir no tenga que desplazar las
+        // columnas. Si no era la misma, el orden de dibujado se restablece más adelante:
+
+        size_t hole = positions[handle.index];
+        size_t last = owners.size () - 1;
+
+        if (!visibilities[hole]) hidden_count--;
+
+        if (hole != last)
+        {
+            xs          [hole] = xs          [last];
+            ys          [hole] = ys          [last];
+            speeds_x    [hole] = speeds_x    [last];
+            speeds_y    [hole] = speeds_y    [last];
+            widths      [hole] = widths      [last];
+            heights     [hole] = heights     [last];
+            anchors     [hole] = anchors     [last];
+            visibilities[hole] = visibilities[last];
+            textures    [hole] = textures    [last];
+            slices      [hole] = slices      [last];
+            owners      [hole] = owners      [last];
+            sequences   [hole] = sequences   [last];
+
+            positions[owners[hole]] = uint32_t(hole);
+
+            unordered = true;
+        }
+
+        xs          .pop_back ();
+        ys          .pop_back ();
+        speeds_x    .pop_back ();
+        speeds_y    .pop_back ();
+        widths      .pop_back ();
+        heights     .pop_back ();
+        anchors     .pop_back ();
+        visibilities.pop_back ();
+        textures    .pop_back ();
+        slices      .pop_back ();
+        owners      .pop_back ();
+        sequences   .pop_back ();
+
+        positions   [handle.index] = invalid_index;
+        generations [handle.index]++;
+        free_indices.push_back (handle.index);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Entity_Store::clear ()
+    {
+        for (size_t position = 0, count = owners.size (); position < count; ++position)
+        {
+            uint32_t index = owners[position];
+
+            positions   [index] = invalid_index;
+            generations [index]++;
+            free_indices.push_back (index);
+        }
+
+        xs          .clear ();
+        ys          .clear ();
+        speeds_x    .clear ();
+        speeds_y    .clear ();
+        widths      .clear ();
+        heights     .clear ();
+        anchors     .clear ();
+        visibilities.clear ();
+        textures    .clear ();
+        slices      .clear ();
+        owners      .clear ();
+        sequences   .clear ();
+        visible_list.clear ();
+
+        hidden_count  = 0;
+        next_sequence = 0;
+        unordered     = false;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Entity_Store::reserve (size_t capacity)
+    {
+        xs          .reserve (capacity);
+        ys          .reserve (capacity);
+        speeds_x    .reserve (capacity);
+        speeds_y    .reserve (capacity);
+        widths      .reserve (capacity);
+        heights     .reserve (capacity);
+        anchors     .reserve (capacity);
+        visibilities.reserve (capacity);
+        textures    .reserve (capacity);
+        slices      .reserve (capacity);
+        owners      .reserve (capacity);
+        sequences   .reserve (capacity);
+        positions   .reserve (capacity);
+        generations .reserve (capacity);
+        visible_list.reserve (capacity);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Entity_Store::move (float time)
+    {
+        size_t count = owners.size ();
+
+        if (count < parallel_threshold || worker_count < 2)
+        {
+            move (0, count, time);
+        }
+        else
+        {
+            // Cada tarea se ocupa de un tramo contiguo de las columnas. Los tramos se alinean a 16
+            // elementos para que dos hilos no escriban en la misma línea de caché. Los hilos son
+            // los del pool compartido, que no se crean en cada fotograma:
+
+            size_t chunk       = ((count + worker_count - 1) / worker_count + 15) & ~size_t(15);
+            size_t chunk_count = (count + chunk - 1) / chunk;
+
+            worker_pool.run
+            (
+                chunk_count, worker_count,
+                [this, chunk, count, time] (size_t chunk_index)
+                {
+                    size_t first = chunk_index * chunk;
+
+                    move (first, std::min (first + chunk, count), time);
+                }
+            );
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Entity_Store::move (size_t first, size_t last, float time)
+    {
+        if (hidden_count == 0)
+        {
+            kernels::integrate (xs.data () + first, ys.data () + first, speeds_x.data () + first, speeds_y.data () + first, time, last - first);
+        }
+        else
+        {
+            // Las entidades ocultas no se mueven. Se multiplica por 0 en lugar de saltarlas para
+            // que el compilador pueda vectorizar el bucle:
+
+            for (size_t i = first; i < last; ++i)
+            {
+                float step = visibilities[i] ? time : 0.f;
+
+                xs[i] += speeds_x[i] * step;
+                ys[i] += speeds_y[i] * step;
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    const std::vector< uint32_t > & Entity_Store::filter_visible ()
+    {
+        if (unordered) restore_order ();
+
+        visible_list.clear ();
+
+        for (size_t position = 0, count = owners.size (); position < count; ++position)
+        {
+            if (visibilities[position]) visible_list.push_back (uint32_t(position));
+        }
+
+        return visible_list;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    const std::vector< uint32_t > & Entity_Store::filter_visible (const kernels::Bounds2f & view)
+    {
+        if (unordered) restore_order ();
+
+        visible_list.clear ();
+
+        for (size_t position = 0, count = owners.size (); position < count; ++position)
+        {
+            if (visibilities[position])
+            {
+                float left   = get_left_x   (position);
+                float bottom = get_bottom_y (position);
+
+                if
+                (
+                    left   + widths [position] >= view.left   && left   <= view.right &&
+                    bottom + heights[position] >= view.bottom && bottom <= view.top
+                )
+                {
+                    visible_list.push_back (uint32_t(position));
+                }
+            }
+        }
+
+        return visible_list;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Entity_Store::render (Canvas & canvas)
+    {
+        filter_visible ();
+        submit (canvas);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Entity_Store::render (Canvas & canvas, const kernels::Bounds2f & view)
+    {
+        filter_visible (view);
+        submit (canvas);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Entity_Store::submit (Canvas & canvas)
+    {
+        for (uint32_t i : visible_list)
+        {
+            if (slices[i])
+            {
+                canvas.fill_rectangle ({ xs[i], ys[i] }, { widths[i], heights[i] }, slices[i], anchors[i]);
+            }
+            else
+            if (textures[i])
+            {
+                canvas.fill_rectangle ({ xs[i], ys[i] }, { widths[i], heights[i] }, textures[i], anchors[i]);
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Entity_Store::restore_order ()
+    {
+        // Se ordenan las posiciones por orden de creación y se reordenan todas las columnas de una
+        // pasada, con lo que muchas destrucciones seguidas (al cambiar de escena) solo se pagan una
+        // vez. Los números de creación se renumeran para que no lleguen a desbordarse:
+
+        std::vector< uint32_t > order(owners.size ());
+
+        for (uint32_t position = 0; position < uint32_t(order.size ()); ++position) order[position] = position;
+
+        std::sort
+        (
+            order.begin (), order.end (),
+            [this] (uint32_t a, uint32_t b) { return sequences[a] < sequences[b]; }
+        );
+
+        gather (xs,           order);
+        gather (ys,           order);
+        gather (speeds_x,     order);
+        gather (speeds_y,     order);
+        gather (widths,       order);
+        gather (heights,      order);
+        gather (anchors,      order);
+        gather (visibilities, order);
+        gather (textures,     order);
+        gather (slices,       order);
+        gather (owners,       order);
+
+        for (uint32_t position = 0; position < uint32_t(owners.size ()); ++position)
+        {
+            positions[owners[position]] = position;
+            sequences[position]         = position;
+        }
+
+        next_sequence = uint32_t(owners.size ());
+        unordered     = false;
+    }
+
+}
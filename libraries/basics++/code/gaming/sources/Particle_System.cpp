@@ -0,0 +1,199 @@
+/*
+ * PARTICLE SYSTEM
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802161730
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <basics/Kernels>
+#include <basics/Particle_System>
+
+namespace basics
+{
+
+    Particle_System::Particle_System(size_t capacity, const Atlas::Slice * slice)
+    :
+        capacity(capacity),
+        count   (0),
+        dropped (0),
+        seed    (0x9E3779B9),
+        gravity ({ 0.f, 0.f }),
+        slice   (slice)
+    {
+        // Los arrays se reservan redondeando a un múltiplo de 4 para que los bucles SIMD puedan
+        // procesar el último grupo sin tratarlo aparte:
+
+        size_t padded = (capacity + 3) & ~size_t(3);
+
+        xs               .resize (padded);
+        ys               .resize (padded);
+        speeds_x         .resize (padded);
+        speeds_y         .resize (padded);
+        ages             .resize (padded);
+        inverse_lifetimes.resize (padded);
+        start_sizes      .resize (padded);
+        size_deltas      .resize (padded);
+        sizes            .resize (padded);
+        alphas           .resize (padded);
+        colors           .resize (padded);
+        packed_colors    .resize (padded);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Particle_System::burst (const Particle_Emitter & emitter, unsigned amount)
+    {
+        if (count + amount > capacity)
+        {
+            dropped += count + amount - capacity;
+            amount   = unsigned(capacity - count);
+        }
+
+        for (size_t end = count + amount; count < end; ++count)
+        {
+            float angle    = emitter.direction + random (-emitter.spread, emitter.spread);
+            float speed    = random (emitter.min_speed,    emitter.max_speed   );
+            float lifetime = random (emitter.min_lifetime, emitter.max_lifetime);
+
+            xs               [count] = emitter.position[0];
+            ys               [count] = emitter.position[1];
+            speeds_x         [count] = std::cos (angle) * speed;
+            speeds_y         [count] = std::sin (angle) * speed;
+            ages             [count] = 0.f;
+            inverse_lifetimes[count] = lifetime > 0.f ? 1.f / lifetime : 1e30f;
+            start_sizes      [count] = emitter.start_size;
+            size_deltas      [count] = emitter.end_size - emitter.start_size;
+            sizes            [count] = emitter.start_size;
+            alphas           [count] = 1.f;
+            colors           [count] = emitter.color;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Particle_System::emit (Particle_Emitter & emitter, float time)
+    {
+        emitter.accumulator += emitter.rate * time;
+
+        if (emitter.accumulator >= 1.f)
+        {
+            unsigned amount = unsigned(emitter.accumulator);
+
+            emitter.accumulator -= float(amount);
+
+            burst (emitter, amount);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Particle_System::update (float time)
+    {
+        if (count == 0) return;
+
+        // Se acelera y se mueve. Se procesan los huecos de relleno hasta el múltiplo de 4 porque
+        // su contenido no se usa:
+
+        size_t padded = (count + 3) & ~size_t(3);
+
+        kernels::translate (gravity[0] * time, gravity[1] * time, speeds_x.data (), speeds_y.data (), padded);
+        kernels::integrate (xs.data (), ys.data (), speeds_x.data (), speeds_y.data (), time, padded);
+
+        // Se envejece y se calculan el tamaño y la opacidad según la fracción de vida consumida:
+
+        float       * age_data      = ages             .data ();
+        const float * inverse_data  = inverse_lifetimes.data ();
+        const float * start_data    = start_sizes      .data ();
+        const float * delta_data    = size_deltas      .data ();
+        float       * size_data     = sizes            .data ();
+        float       * alpha_data    = alphas           .data ();
+        size_t        index         = 0;
+
+        #if defined(BASICS_MATH_SIMD)
+
+            simd::float4 vtime = simd::splat (time);
+            simd::float4 vzero = simd::zero  ();
+            simd::float4 vone  = simd::splat (1.f);
+
+            for ( ; index < padded; index += 4)
+            {
+                simd::float4 age      = simd::add (simd::load (age_data + index), vtime);
+                simd::float4 progress = simd::minimum (simd::multiply (age, simd::load (inverse_data + index)), vone);
+
+                simd::store (age_data   + index, age);
+                simd::store (size_data  + index, simd::multiply_add (simd::load (start_data + index), simd::load (delta_data + index), progress));
+                simd::store (alpha_data + index, simd::maximum (simd::subtract (vone, progress), vzero));
+            }
+
+        #endif
+
+        for ( ; index < count; ++index)
+        {
+            float age      = age_data[index] += time;
+            float progress = std::min (age * inverse_data[index], 1.f);
+
+            size_data [index] = start_data[index] + delta_data[index] * progress;
+            alpha_data[index] = 1.f - progress;
+        }
+
+        // Se eliminan las que han muerto. Se recorren de atrás hacia delante para que la partícula
+        // que se mueve al hueco ya haya sido comprobada:
+
+        for (size_t i = count; i-- > 0; )
+        {
+            if (alpha_data[i] <= 0.f) remove (i);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Particle_System::remove (size_t index)
+    {
+        size_t last = --count;
+
+        if (index != last)
+        {
+            xs               [index] = xs               [last];
+            ys               [index] = ys               [last];
+            speeds_x         [index] = speeds_x         [last];
+            speeds_y         [index] = speeds_y         [last];
+            ages             [index] = ages             [last];
+            inverse_lifetimes[index] = inverse_lifetimes[last];
+            start_sizes      [index] = start_sizes      [last];
+            size_deltas      [index] = size_deltas      [last];
+            sizes            [index] = sizes            [last];
+            alphas           [index] = alphas           [last];
+            colors           [index] = colors           [last];
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Particle_System::render (Canvas & canvas)
+    {
+        if (count == 0 || !slice) return;
+
+        // Se sustituye el alfa de cada color por la opacidad que corresponde a su edad:
+
+        const float    * alpha_data = alphas.data ();
+        const uint32_t * color_data = colors.data ();
+        uint32_t       * packed     = packed_colors.data ();
+
+        for (size_t index = 0; index < count; ++index)
+        {
+            uint32_t alpha = uint32_t(alpha_data[index] * float(color_data[index] >> 24) + .5f);
+
+            packed[index] = (color_data[index] & 0x00FFFFFF) | (alpha << 24);
+        }
+
+        canvas.fill_rectangles (slice, xs.data (), ys.data (), sizes.data (), packed, count);
+    }
+
+}
@@ -0,0 +1,276 @@
+/*
+ * PERFORMANCE HUD
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802181130
+ */
+
+#include <cstdio>
+#include <basics/Memory_Tracker>
+#include <basics/Performance_Hud>
+#include <basics/Transformation>
+
+namespace basics
+{
+
+    constexpr size_t Performance_Hud::history_size;
+
+    namespace
+    {
+
+        // Fuente de 3x5 píxeles para los caracteres ASCII del 32 al 95. Cada glifo usa 15 bits: tres
+        // por fila empezando por la de arriba, con el píxel de la izquierda en el bit más alto. Las
+        // minúsculas se dibujan como mayúsculas.
+
+        const uint16_t glyphs[64] =
+        {
+            0x0000, 0x2482, 0x5A00, 0x5F7D, 0x3C9E, 0x52A5, 0x2AAB, 0x2400,     //   ! " # $ % & '
+            0x2922, 0x224A, 0x0AA8, 0x05D0, 0x0014, 0x01C0, 0x0002, 0x12A4,     // ( ) * + , - . /
+            0x7B6F, 0x2C97, 0x73E7, 0x73CF, 0x5BC9, 0x79CF, 0x79EF, 0x7249,     // 0 1 2 3 4 5 6 7
+            0x7BEF, 0x7BCF, 0x0410, 0x0414, 0x1511, 0x0E38, 0x4454, 0x6282,     // 8 9 : ; < = > ?
+            0x7BE3, 0x2BED, 0x6BAE, 0x3923, 0x6B6E, 0x79A7, 0x79A4, 0x396B,     // @ A B C D E F G
+            0x5BED, 0x7497, 0x126A, 0x5BAD, 0x4927, 0x5FED, 0x6B6D, 0x2B6A,     // H I J K L M N O
+            0x6BA4, 0x2B73, 0x6BAD, 0x388E, 0x7492, 0x5B6F, 0x5B6A, 0x5BFD,     // P Q R S T U V W
+            0x5AAD, 0x5A92, 0x72A7, 0x6926, 0x4889, 0x324B, 0x2A00, 0x0007,     // X Y Z [ \ ] ^ _
+        };
+
+        const unsigned glyph_width   = 3;
+        const unsigned glyph_height  = 5;
+        const unsigned text_columns  = 40;
+        const unsigned text_lines    = 5;
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Performance_Hud::Performance_Hud()
+    :
+        history_head     (0),
+        history_count    (0),
+        event_queue_depth(0),
+        frame_statistics ({ 0, 0, 0 }),
+        frame_budget     (1.f / 60.f),
+        visible          (false)
+    {
+        for (auto & time : frame_times) time = 0.f;
+        for (auto & time : phase_times) time = 0.f;
+
+        // Texto y gráfica caben holgadamente en esta reserva, por lo que no se reserva memoria
+        // mientras se dibuja:
+
+        size_t capacity = text_columns * text_lines * glyph_width * glyph_height + history_size;
+
+        lefts  .reserve (capacity);
+        bottoms.reserve (capacity);
+        widths .reserve (capacity);
+        heights.reserve (capacity);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Performance_Hud::record_frame (float frame_time, size_t new_event_queue_depth)
+    {
+        frame_times[history_head] = frame_time;
+
+        history_head = (history_head + 1) % history_size;
+
+        if (history_count < history_size) ++history_count;
+
+        event_queue_depth = new_event_queue_depth;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Performance_Hud::render (Canvas & canvas, const Size2u & view_size)
+    {
+        // Se escala para que el panel ocupe un ancho parecido en cualquier resolución virtual:
+
+        float pixel   = float(view_size.width < view_size.height ? view_size.width : view_size.height) / 180.f;
+        float margin  = pixel * 2.f;
+        float width   = pixel * (glyph_width + 1) * text_columns + margin * 2.f;
+        float line    = pixel * (glyph_height + 2);
+        float graph   = pixel * 20.f;
+        float height  = line * text_lines + graph + margin * 3.f;
+        float left    = margin;
+        float top     = float(view_size.height) - margin;
+
+        // Estadísticas de los fotogramas recientes:
+
+        float total   = 0.f;
+        float maximum = 0.f;
+
+        for (size_t index = 0; index < history_count; ++index)
+        {
+            total += frame_times[index];
+
+            if (frame_times[index] > maximum) maximum = frame_times[index];
+        }
+
+        float mean = history_count > 0 ? total / float(history_count) : 0.f;
+
+        canvas.set_transform (Transformation2f());
+
+        // Fondo:
+
+        canvas.set_color   (0.f, 0.f, 0.f);
+        canvas.set_opacity (.6f);
+        canvas.fill_rectangle ({ left, top - height }, { width, height });
+        canvas.set_opacity (1.f);
+
+        // Gráfica: una barra por fotograma, del más antiguo al más reciente. La altura completa
+        // equivale al doble del presupuesto:
+
+        float graph_left   = left + margin;
+        float graph_bottom = top  - height + margin;
+        float graph_width  = width - margin * 2.f;
+        float bar_width    = graph_width / float(history_size);
+        float scale        = graph / (frame_budget * 2.f);
+
+        for (unsigned pass = 0; pass < 2; ++pass)
+        {
+            for (size_t index = 0; index < history_count; ++index)
+            {
+                size_t slot = (history_head + history_size - history_count + index) % history_size;
+                float  time = frame_times[slot];
+
+                if ((time > frame_budget) == (pass == 1))
+                {
+                    float bar_height = time * scale;
+
+                    if (bar_height > graph) bar_height = graph;
+
+                    add_rectangle (graph_left + bar_width * float(history_size - history_count + index), graph_bottom, bar_width, bar_height);
+                }
+            }
+
+            if (pass == 0) canvas.set_color (.2f, .9f, .3f); else canvas.set_color (1.f, .25f, .2f);
+
+            submit (canvas);
+        }
+
+        canvas.set_color    (1.f, 1.f, 0.f);
+        canvas.draw_segment ({ graph_left, graph_bottom + graph * .5f }, { graph_left + graph_width, graph_bottom + graph * .5f });
+
+        // Texto:
+
+        char  text[text_columns + 1];
+        float text_left = left + margin;
+        float text_top  = top  - margin;
+
+        std::snprintf (text, sizeof(text), "FPS %5.1f  %5.2f MS  MAX %5.2f", mean > 0.f ? 1.f / mean : 0.f, mean * 1000.f, maximum * 1000.f);
+        add_text (text, text_left, text_top, pixel);
+
+        std::snprintf
+        (
+            text, sizeof(text), "IN %4.2f UP %4.2f RN %4.2f FL %4.2f",
+            phase_times[INPUT ] * 1000.f,
+            phase_times[UPDATE] * 1000.f,
+            phase_times[RENDER] * 1000.f,
+            phase_times[FLUSH ] * 1000.f
+        );
+        add_text (text, text_left, text_top - line, pixel);
+
+        std::snprintf
+        (
+            text, sizeof(text), "DRAWS %u  BINDS %u  STATE %u",
+            unsigned(frame_statistics.draw_calls),
+            unsigned(frame_statistics.texture_binds),
+            unsigned(frame_statistics.state_changes)
+        );
+        add_text (text, text_left, text_top - line * 2.f, pixel);
+
+        std::snprintf
+        (
+            text, sizeof(text), "TEX %.1f MB  EVENTS %u",
+            double(memory_tracker.get_current (Memory_Tracker::TEXTURES_GPU)) / (1024. * 1024.),
+            unsigned(event_queue_depth)
+        );
+        add_text (text, text_left, text_top - line * 3.f, pixel);
+
+        const double megabyte = 1024. * 1024.;
+
+        if (memory_tracker.get_budget () > 0)
+        {
+            std::snprintf
+            (
+                text, sizeof(text), "MEM %.1f/%.1f MB  PEAK %.1f%s",
+                double(memory_tracker.get_total      ()) / megabyte,
+                double(memory_tracker.get_budget     ()) / megabyte,
+                double(memory_tracker.get_total_peak ()) / megabyte,
+                memory_tracker.is_over_budget () ? " !" : ""
+            );
+        }
+        else
+        {
+            std::snprintf
+            (
+                text, sizeof(text), "MEM %.1f MB  PEAK %.1f MB",
+                double(memory_tracker.get_total      ()) / megabyte,
+                double(memory_tracker.get_total_peak ()) / megabyte
+            );
+        }
+
+        add_text (text, text_left, text_top - line * 4.f, pixel);
+
+        canvas.set_color (1.f, 1.f, 1.f);
+
+        submit (canvas);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Performance_Hud::add_text (const char * text, float left, float top, float pixel_size)
+    {
+        for ( ; *text; ++text, left += pixel_size * (glyph_width + 1))
+        {
+            unsigned character = (unsigned char)*text;
+
+            if (character >= 'a' && character <= 'z') character -= 'a' - 'A';
+            if (character <  32  || character >= 96 ) continue;
+
+            uint16_t glyph = glyphs[character - 32];
+
+            // Los píxeles encendidos contiguos de cada fila se unen en un único rectángulo:
+
+            for (unsigned row = 0; row < glyph_height; ++row)
+            {
+                unsigned bits   = (glyph >> (glyph_width * (glyph_height - 1 - row))) & 7;
+                float    bottom = top - pixel_size * float(row + 1);
+
+                for (unsigned column = 0; column < glyph_width; )
+                {
+                    if (bits & (4 >> column))
+                    {
+                        unsigned start = column;
+
+                        while (column < glyph_width && (bits & (4 >> column))) ++column;
+
+                        add_rectangle (left + pixel_size * float(start), bottom, pixel_size * float(column - start), pixel_size);
+                    }
+                    else
+                    {
+                        ++column;
+                    }
+                }
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Performance_Hud::submit (Canvas & canvas)
+    {
+        canvas.fill_rectangles (lefts.data (), bottoms.data (), widths.data (), heights.data (), lefts.size ());
+
+        lefts  .clear ();
+        bottoms.clear ();
+        widths .clear ();
+        heights.clear ();
+    }
+
+}
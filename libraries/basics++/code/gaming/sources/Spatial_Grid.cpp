@@ -0,0 +1,299 @@
+/*
+ * SPATIAL GRID
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802141545
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <basics/Spatial_Grid>
+
+namespace basics
+{
+
+    Spatial_Grid::Spatial_Grid()
+    {
+        resize ({ 0.f, 0.f }, { 1.f, 1.f }, 1.f);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Spatial_Grid::resize (const Point2f & new_origin, const Size2f & area, float new_cell_size)
+    {
+        for (uint32_t slot = 0, count = uint32_t(items.size ()); slot < count; ++slot)
+        {
+            unlink (items[slot], slot);
+        }
+
+        origin            = new_origin;
+        cell_size         = new_cell_size;
+        inverse_cell_size = 1.f / new_cell_size;
+        columns           = std::max (int(std::ceil (area.width  * inverse_cell_size)), 1);
+        rows              = std::max (int(std::ceil (area.height * inverse_cell_size)), 1);
+
+        cells.assign (size_t(columns) * size_t(rows), Cell());
+
+        // Las entidades se vuelven a enlazar a partir de los límites que ya tenían guardados:
+
+        for (uint32_t slot = 0, count = uint32_t(items.size ()); slot < count; ++slot)
+        {
+            Item & item = items[slot];
+
+            if (item.visible)
+            {
+                item.first_column = column_of (item.bounds.left  );
+                item.last_column  = column_of (item.bounds.right );
+                item.first_row    = row_of    (item.bounds.bottom);
+                item.last_row     = row_of    (item.bounds.top   );
+
+                link (item, slot);
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Spatial_Grid::add (const Entity_Store & store, const Handle & handle)
+    {
+        if (!store.is_alive (handle) || contains (handle)) return;
+
+        if (handle.index >= slots.size ())
+        {
+            slots.resize (handle.index + 1, Entity_Store::invalid_index);
+        }
+        else
+        if (slots[handle.index] != Entity_Store::invalid_index)
+        {
+            remove (slots[handle.index]);       // Entidad destruida cuyo índice se ha reutilizado
+        }
+
+        uint32_t slot = uint32_t(items.size ());
+
+        Item item;
+
+        item.handle       = handle;
+        item.bounds       = Bounds::none ();
+        item.depth        = 0;
+        item.visible      = false;
+        item.first_column = item.first_row = 0;
+        item.last_column  = item.last_row  = -1;
+
+        items.push_back (item);
+
+        slots[handle.index] = slot;
+
+        update (items.back (), slot, store);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Spatial_Grid::remove (const Handle & handle)
+    {
+        if (contains (handle)) remove (slots[handle.index]);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Spatial_Grid::remove (uint32_t slot)
+    {
+        uint32_t index = items[slot].handle.index;
+        uint32_t last  = uint32_t(items.size () - 1);
+
+        unlink (items[slot], slot);
+
+        if (slot != last)
+        {
+            // El último elemento pasa a ocupar el hueco, por lo que se corrigen sus referencias:
+
+            unlink (items[last], last);
+
+            items[slot] = items[last];
+
+            link (items[slot], slot);
+
+            slots[items[slot].handle.index] = slot;
+        }
+
+        items.pop_back ();
+
+        slots[index] = Entity_Store::invalid_index;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Spatial_Grid::clear ()
+    {
+        items.clear ();
+        slots.clear ();
+
+        for (auto & cell : cells) cell.clear ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Spatial_Grid::update (const Entity_Store & store, const Handle & handle)
+    {
+        if (contains (handle))
+        {
+            uint32_t slot = slots[handle.index];
+
+            update (items[slot], slot, store);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Spatial_Grid::synchronize (const Entity_Store & store)
+    {
+        for (uint32_t slot = 0; slot < items.size (); )
+        {
+            if (store.is_alive (items[slot].handle))
+            {
+                update (items[slot], slot, store);
+
+                ++slot;
+            }
+            else
+            {
+                remove (slot);                          // Se sustituye por el último elemento
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Spatial_Grid::update (Item & item, uint32_t slot, const Entity_Store & store)
+    {
+        size_t position = store.position_of (item.handle);
+        float  left     = store.get_left_x   (position);
+        float  bottom   = store.get_bottom_y (position);
+
+        item.bounds  = { left, bottom, left + store.get_widths ()[position], bottom + store.get_heights ()[position] };
+        item.depth   = uint32_t(position);
+
+        bool visible = store.get_visibilities ()[position] != 0;
+        int  first_column, first_row, last_column, last_row;
+
+        if (visible)
+        {
+            first_column = column_of (item.bounds.left  );
+            last_column  = column_of (item.bounds.right );
+            first_row    = row_of    (item.bounds.bottom);
+            last_row     = row_of    (item.bounds.top   );
+        }
+        else
+        {
+            first_column = first_row = 0;
+            last_column  = last_row  = -1;
+        }
+
+        // Solo se tocan las celdas cuando cambia el rango que ocupa la entidad:
+
+        if
+        (
+            first_column != item.first_column || last_column != item.last_column ||
+            first_row    != item.first_row    || last_row    != item.last_row
+        )
+        {
+            unlink (item, slot);
+
+            item.first_column = first_column;
+            item.last_column  = last_column;
+            item.first_row    = first_row;
+            item.last_row     = last_row;
+
+            link (item, slot);
+        }
+
+        item.visible = visible;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Spatial_Grid::Handle Spatial_Grid::hit (const Point2f & point) const
+    {
+        float x = point.coordinates.x ();
+        float y = point.coordinates.y ();
+
+        const Cell & cell = cells[size_t(row_of (y)) * size_t(columns) + size_t(column_of (x))];
+
+        const Item * top = nullptr;
+
+        for (uint32_t slot : cell)
+        {
+            const Item & item = items[slot];
+
+            if
+            (
+                x > item.bounds.left   && x < item.bounds.right &&
+                y > item.bounds.bottom && y < item.bounds.top   &&
+                (top == nullptr || item.depth > top->depth)
+            )
+            {
+                top = &item;
+            }
+        }
+
+        return top ? top->handle : Handle();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Spatial_Grid::link (const Item & item, uint32_t slot)
+    {
+        for (int row = item.first_row; row <= item.last_row; ++row)
+        {
+            for (int column = item.first_column; column <= item.last_column; ++column)
+            {
+                cells[size_t(row) * size_t(columns) + size_t(column)].push_back (slot);
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Spatial_Grid::unlink (const Item & item, uint32_t slot)
+    {
+        for (int row = item.first_row; row <= item.last_row; ++row)
+        {
+            for (int column = item.first_column; column <= item.last_column; ++column)
+            {
+                Cell & cell = cells[size_t(row) * size_t(columns) + size_t(column)];
+
+                auto found = std::find (cell.begin (), cell.end (), slot);
+
+                if (found != cell.end ())
+                {
+                    *found = cell.back ();
+
+                    cell.pop_back ();
+                }
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    int Spatial_Grid::column_of (float x) const
+    {
+        float column = std::floor ((x - origin.coordinates.x ()) * inverse_cell_size);
+
+        return column < 0.f ? 0 : column >= float(columns) ? columns - 1 : int(column);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    int Spatial_Grid::row_of (float y) const
+    {
+        float row = std::floor ((y - origin.coordinates.y ()) * inverse_cell_size);
+
+        return row < 0.f ? 0 : row >= float(rows) ? rows - 1 : int(row);
+    }
+
+}
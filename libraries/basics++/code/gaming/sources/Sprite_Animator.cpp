@@ -0,0 +1,329 @@
+/*
+ * SPRITE ANIMATOR
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802161045
+ */
+
+#include <cmath>
+#include <basics/assert>
+#include <basics/fnv>
+#include <basics/Sprite_Animator>
+
+namespace basics
+{
+
+    constexpr Sprite_Animator::Clip Sprite_Animator::invalid_clip;
+
+    // ---------------------------------------------------------------------------------------------
+
+    Sprite_Animator::Clip Sprite_Animator::add_clip
+    (
+        const Atlas            & atlas,
+        const std::vector< Id > & frame_ids,
+        float                    frames_per_second,
+        Playback                 playback
+    )
+    {
+        assert(frames_per_second > 0.f);
+
+        uint32_t first_frame = uint32_t(frames.size ());
+
+        for (Id id : frame_ids)
+        {
+            const Atlas::Slice * slice = atlas.get_slice (id);
+
+            if (slice) frames.push_back (slice);
+        }
+
+        uint32_t frame_count = uint32_t(frames.size ()) - first_frame;
+
+        if (frame_count == 0) return invalid_clip;
+
+        clips.push_back ({ first_frame, frame_count, frames_per_second, playback });
+
+        return Clip(clips.size () - 1);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Sprite_Animator::Clip Sprite_Animator::add_clip
+    (
+        const Atlas       & atlas,
+        const std::string & prefix,
+        unsigned            frame_count,
+        float               frames_per_second,
+        Playback            playback
+    )
+    {
+        std::vector< Id > frame_ids;
+
+        frame_ids.reserve (frame_count);
+
+        for (unsigned i = 0; i < frame_count; ++i)
+        {
+            frame_ids.push_back (fnv32 (prefix + std::to_string (i)));
+        }
+
+        return add_clip (atlas, frame_ids, frames_per_second, playback);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Sprite_Animator::play (Entity_Store & store, const Handle & entity, Clip clip, float speed)
+    {
+        assert(clip < clips.size ());
+
+        if (!store.is_alive (entity)) return;
+
+        uint32_t slot;
+
+        if (contains (entity))
+        {
+            slot = slots[entity.index];
+        }
+        else
+        {
+            if (entity.index >= slots.size ())
+            {
+                slots.resize (entity.index + 1, Entity_Store::invalid_index);
+            }
+            else
+            if (slots[entity.index] != Entity_Store::invalid_index)
+            {
+                remove (slots[entity.index]);   // Entidad destruida cuyo índice se ha reutilizado
+            }
+
+            slot = uint32_t(handles.size ());
+
+            handles       .push_back (entity);
+            instance_clips.push_back (0);
+            elapsed       .push_back (0.f);
+            speeds        .push_back (0.f);
+            rates         .push_back (0.f);
+            current_frames.push_back (0);
+
+            slots[entity.index] = slot;
+        }
+
+        const Clip_Data & data = clips[clip];
+
+        // Con velocidad negativa se empieza por el final:
+
+        instance_clips[slot] = clip;
+        elapsed       [slot] = speed < 0.f ? float(data.frame_count) - 0.001f : 0.f;
+        speeds        [slot] = speed;
+        rates         [slot] = speed * data.frames_per_second;
+        current_frames[slot] = speed < 0.f ? data.frame_count - 1 : 0;
+
+        store.set_slice (entity, frames[data.first_frame + current_frames[slot]]);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Sprite_Animator::pause (const Handle & entity)
+    {
+        if (contains (entity)) rates[slots[entity.index]] = 0.f;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Sprite_Animator::resume (const Handle & entity)
+    {
+        if (contains (entity))
+        {
+            uint32_t slot = slots[entity.index];
+
+            rates[slot] = speeds[slot] * clips[instance_clips[slot]].frames_per_second;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Sprite_Animator::stop (const Handle & entity)
+    {
+        if (contains (entity)) remove (slots[entity.index]);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Sprite_Animator::set_speed (const Handle & entity, float speed)
+    {
+        if (contains (entity))
+        {
+            uint32_t slot = slots[entity.index];
+
+            if (rates[slot] != 0.f)
+            {
+                rates[slot] = speed * clips[instance_clips[slot]].frames_per_second;
+            }
+
+            speeds[slot] = speed;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Sprite_Animator::clear ()
+    {
+        handles       .clear ();
+        instance_clips.clear ();
+        elapsed       .clear ();
+        speeds        .clear ();
+        rates         .clear ();
+        current_frames.clear ();
+        slots         .clear ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Sprite_Animator::reserve (size_t capacity)
+    {
+        handles       .reserve (capacity);
+        instance_clips.reserve (capacity);
+        elapsed       .reserve (capacity);
+        speeds        .reserve (capacity);
+        rates         .reserve (capacity);
+        current_frames.reserve (capacity);
+        dead          .reserve (capacity);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Sprite_Animator::remove (uint32_t slot)
+    {
+        uint32_t last = uint32_t(handles.size () - 1);
+
+        slots[handles[slot].index] = Entity_Store::invalid_index;
+
+        if (slot != last)
+        {
+            handles       [slot] = handles       [last];
+            instance_clips[slot] = instance_clips[last];
+            elapsed       [slot] = elapsed       [last];
+            speeds        [slot] = speeds        [last];
+            rates         [slot] = rates         [last];
+            current_frames[slot] = current_frames[last];
+
+            slots[handles[slot].index] = slot;
+        }
+
+        handles       .pop_back ();
+        instance_clips.pop_back ();
+        elapsed       .pop_back ();
+        speeds        .pop_back ();
+        rates         .pop_back ();
+        current_frames.pop_back ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Sprite_Animator::update (float time, Entity_Store & store)
+    {
+        size_t count = handles.size ();
+
+        // Primera pasada: se avanza el tiempo de todas las animaciones. No tiene saltos, por lo que
+        // el compilador la puede vectorizar:
+
+        float       * elapsed_data = elapsed.data ();
+        const float * rates_data   = rates  .data ();
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            elapsed_data[i] += rates_data[i] * time;
+        }
+
+        // Segunda pasada: se calcula el fotograma que corresponde a cada una y solo se toca el
+        // almacén cuando cambia:
+
+        dead.clear ();
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (rates_data[i] == 0.f) continue;
+
+            const Clip_Data & clip   = clips[instance_clips[i]];
+            float             length = float(clip.frame_count);
+            float             t      = elapsed_data[i];
+            uint32_t          frame;
+
+            switch (clip.playback)
+            {
+                case ONCE:
+                {
+                    if (t >= length || t < 0.f)
+                    {
+                        t        = t < 0.f ? 0.f : length - 1.f;
+                        rates[i] = 0.f;                     // Se queda en el fotograma extremo
+                    }
+
+                    frame = uint32_t(t);
+                    break;
+                }
+
+                case LOOP:
+                {
+                    // Se mantiene el tiempo acotado para no perder precisión:
+
+                    if (t >= length || t < 0.f)
+                    {
+                        t = std::fmod (t, length);
+                        if (t < 0.f) t += length;
+                    }
+
+                    frame = uint32_t(t);
+                    break;
+                }
+
+                case PING_PONG:
+                default:
+                {
+                    float period = clip.frame_count > 1 ? 2.f * length - 2.f : 1.f;
+
+                    if (t >= period || t < 0.f)
+                    {
+                        t = std::fmod (t, period);
+                        if (t < 0.f) t += period;
+                    }
+
+                    frame = uint32_t(t);
+
+                    if (frame >= clip.frame_count) frame = clip.frame_count * 2 - 2 - frame;
+
+                    break;
+                }
+            }
+
+            elapsed_data[i] = t;
+
+            if (frame >= clip.frame_count) frame = clip.frame_count - 1;
+
+            if (frame != current_frames[i])
+            {
+                if (!store.is_alive (handles[i]))
+                {
+                    dead.push_back (uint32_t(i));
+                    continue;
+                }
+
+                current_frames[i] = frame;
+
+                store.set_slice (handles[i], frames[clip.first_frame + frame]);
+            }
+        }
+
+        // Se descartan las entidades destruidas de atrás hacia delante porque al eliminar una se
+        // mueve la última al hueco:
+
+        for (size_t n = dead.size (); n-- > 0; )
+        {
+            remove (dead[n]);
+        }
+    }
+
+}
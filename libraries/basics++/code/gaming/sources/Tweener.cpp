@@ -0,0 +1,309 @@
+/*
+ * TWEENER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802151710
+ */
+
+#include <cmath>
+#include <limits>
+#include <basics/assert>
+#include <basics/Tweener>
+
+namespace basics
+{
+
+    constexpr uint32_t Tweener::invalid_index;
+    constexpr unsigned Tweener::group_count;
+
+    // ---------------------------------------------------------------------------------------------
+
+    Tweener::Handle Tweener::add
+    (
+        float  * target,
+        float    from,
+        float    to,
+        float    duration,
+        Easing   easing,
+        float    delay,
+        Callback callback,
+        void   * context,
+        unsigned group
+    )
+    {
+        return add (target, nullptr, Entity_Store::Handle(), POSITION_X, from, to, duration, easing, delay, callback, context, group);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Tweener::Handle Tweener::add
+    (
+        Entity_Store                & store,
+        const Entity_Store::Handle  & entity,
+        Property                      property,
+        float                         from,
+        float                         to,
+        float                         duration,
+        Easing                        easing,
+        float                         delay,
+        Callback                      callback,
+        void                        * context,
+        unsigned                      group
+    )
+    {
+        return add (nullptr, &store, entity, property, from, to, duration, easing, delay, callback, context, group);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Tweener::Handle Tweener::add
+    (
+        float                       * target,
+        Entity_Store                * store,
+        const Entity_Store::Handle  & entity,
+        Property                      property,
+        float                         from,
+        float                         to,
+        float                         duration,
+        Easing                        easing,
+        float                         delay,
+        Callback                      callback,
+        void                        * context,
+        unsigned                      group
+    )
+    {
+        assert(group < group_count);
+
+        uint32_t index;
+
+        if (free_indices.empty ())
+        {
+            index = uint32_t(generations.size ());
+
+            generations.push_back (0);
+            positions  .push_back (invalid_index);
+        }
+        else
+        {
+            index = free_indices.back ();
+
+            free_indices.pop_back ();
+        }
+
+        positions[index] = uint32_t(owners.size ());
+
+        // Con duración 0 la interpolación termina en cuanto avanza el tiempo:
+
+        elapsed          .push_back (-delay);
+        inverse_durations.push_back (duration > 0.f ? 1.f / duration : std::numeric_limits< float >::max ());
+        progress         .push_back (0.f);
+        starts           .push_back (from);
+        deltas           .push_back (to - from);
+        easings          .push_back (easing);
+        groups           .push_back (uint8_t(group));
+        targets          .push_back (target);
+        stores           .push_back (store);
+        entities         .push_back (entity);
+        properties       .push_back (property);
+        callbacks        .push_back (callback);
+        contexts         .push_back (context);
+        owners           .push_back (index);
+
+        return Handle(index, generations[index]);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Tweener::cancel (const Handle & handle)
+    {
+        if (is_active (handle)) remove (positions[handle.index]);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Tweener::clear ()
+    {
+        while (!owners.empty ()) remove (owners.size () - 1);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Tweener::reserve (size_t capacity)
+    {
+        elapsed          .reserve (capacity);
+        inverse_durations.reserve (capacity);
+        progress         .reserve (capacity);
+        starts           .reserve (capacity);
+        deltas           .reserve (capacity);
+        easings          .reserve (capacity);
+        groups           .reserve (capacity);
+        targets          .reserve (capacity);
+        stores           .reserve (capacity);
+        entities         .reserve (capacity);
+        properties       .reserve (capacity);
+        callbacks        .reserve (capacity);
+        contexts         .reserve (capacity);
+        owners           .reserve (capacity);
+        positions        .reserve (capacity);
+        generations      .reserve (capacity);
+        free_indices     .reserve (capacity);
+        finished         .reserve (capacity);
+        completions      .reserve (capacity);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Tweener::remove (size_t position)
+    {
+        // La última interpolación pasa a ocupar el hueco:
+
+        size_t   last  = owners.size () - 1;
+        uint32_t index = owners[position];
+
+        if (position != last)
+        {
+            elapsed          [position] = elapsed          [last];
+            inverse_durations[position] = inverse_durations[last];
+            progress         [position] = progress         [last];
+            starts           [position] = starts           [last];
+            deltas           [position] = deltas           [last];
+            easings          [position] = easings          [last];
+            groups           [position] = groups           [last];
+            targets          [position] = targets          [last];
+            stores           [position] = stores           [last];
+            entities         [position] = entities         [last];
+            properties       [position] = properties       [last];
+            callbacks        [position] = callbacks        [last];
+            contexts         [position] = contexts         [last];
+            owners           [position] = owners           [last];
+
+            positions[owners[position]] = uint32_t(position);
+        }
+
+        elapsed          .pop_back ();
+        inverse_durations.pop_back ();
+        progress         .pop_back ();
+        starts           .pop_back ();
+        deltas           .pop_back ();
+        easings          .pop_back ();
+        groups           .pop_back ();
+        targets          .pop_back ();
+        stores           .pop_back ();
+        entities         .pop_back ();
+        properties       .pop_back ();
+        callbacks        .pop_back ();
+        contexts         .pop_back ();
+        owners           .pop_back ();
+
+        positions   [index] = invalid_index;
+        generations [index]++;
+        free_indices.push_back (index);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Tweener::update (float time)
+    {
+        size_t count = owners.size ();
+
+        // Primera pasada: se avanza el tiempo y se calcula el progreso lineal. No tiene saltos, por
+        // lo que el compilador la puede vectorizar:
+
+        float * elapsed_data  = elapsed.data ();
+        float * progress_data = progress.data ();
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            float step = (paused_groups >> groups[i]) & 1 ? 0.f : time;
+
+            elapsed_data[i] += step;
+
+            float t = elapsed_data[i] * inverse_durations[i];
+
+            progress_data[i] = t < 0.f ? 0.f : t > 1.f ? 1.f : t;
+        }
+
+        // Segunda pasada: suavizado, escritura del valor y detección de las que terminan:
+
+        finished.clear ();
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            float t     = progress_data[i];
+            float value = starts[i] + deltas[i] * (t < 1.f ? ease (Easing(easings[i]), t) : 1.f);
+
+            if (targets[i])
+            {
+               *targets[i] = value;
+            }
+            else
+            if (stores[i]->is_alive (entities[i]))
+            {
+                Entity_Store & store = *stores[i];
+
+                switch (properties[i])
+                {
+                    case POSITION_X: store.set_position_x (entities[i], value); break;
+                    case POSITION_Y: store.set_position_y (entities[i], value); break;
+                    case WIDTH:      store.set_size (entities[i], { value, store.get_size (entities[i]).height }); break;
+                    case HEIGHT:     store.set_size (entities[i], { store.get_size (entities[i]).width, value  }); break;
+                }
+            }
+
+            if (t >= 1.f) finished.push_back (uint32_t(i));
+        }
+
+        if (finished.empty ()) return;
+
+        // Se eliminan las que han terminado antes de llamar a los callbacks para que estos puedan
+        // añadir o cancelar interpolaciones. Se recorren de atrás hacia delante porque al eliminar
+        // una se mueve la última al hueco:
+
+        completions.clear ();
+
+        for (size_t n = finished.size (); n-- > 0; )
+        {
+            uint32_t position = finished[n];
+            uint32_t index    = owners[position];
+
+            if (callbacks[position])
+            {
+                completions.push_back ({ callbacks[position], contexts[position], Handle(index, generations[index]) });
+            }
+
+            remove (position);
+        }
+
+        for (size_t n = completions.size (); n-- > 0; )
+        {
+            completions[n].callback (completions[n].context, completions[n].handle);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    float Tweener::ease (Easing easing, float t)
+    {
+        switch (easing)
+        {
+            case LINEAR:            return t;
+            case QUADRATIC_IN:      return t * t;
+            case QUADRATIC_OUT:     return t * (2.f - t);
+            case QUADRATIC_IN_OUT:  return t < .5f ? 2.f * t * t : -1.f + (4.f - 2.f * t) * t;
+            case CUBIC_IN:          return t * t * t;
+            case CUBIC_OUT:         { float u = t - 1.f; return u * u * u + 1.f; }
+            case CUBIC_IN_OUT:      { if (t < .5f) return 4.f * t * t * t; float u = 2.f * t - 2.f; return .5f * u * u * u + 1.f; }
+            case SINE_IN_OUT:       return .5f - .5f * std::cos (t * 3.14159265f);
+            case BACK_OUT:          { const float s = 1.70158f; float u = t - 1.f; return u * u * ((s + 1.f) * u + s) + 1.f; }
+            case STEP:              return t < 1.f ? 0.f : 1.f;
+        }
+
+        return t;
+    }
+
+}
@@ -0,0 +1,163 @@
+/*
+ * WORKER POOL
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802231300
+ */
+
+#include <basics/Worker_Pool>
+
+namespace basics
+{
+
+    Worker_Pool worker_pool;
+
+    // ---------------------------------------------------------------------------------------------
+
+    Worker_Pool::Worker_Pool()
+    :
+        task         (nullptr),
+        task_count   (0),
+        next_task    (0),
+        pending_count(0),
+        active_count (0),
+        generation   (0),
+        stopping     (false)
+    {
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Worker_Pool::~Worker_Pool()
+    {
+        {
+            std::lock_guard< std::mutex > lock(mutex);
+
+            stopping = true;
+        }
+
+        wake_condition.notify_all ();
+
+        for (auto & thread : threads) thread.join ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Worker_Pool::run (size_t new_task_count, unsigned thread_count, const Task & new_task)
+    {
+        if (new_task_count == 0) return;
+
+        if (new_task_count == 1 || thread_count < 2)
+        {
+            for (size_t index = 0; index < new_task_count; ++index) new_task (index);
+            return;
+        }
+
+        std::lock_guard< std::mutex > run_lock(run_mutex);
+
+        ensure_threads (std::min< size_t > (thread_count, new_task_count) - 1);
+
+        {
+            // Un hilo que despertó tarde puede seguir mirando la tanda anterior. Se espera a que
+            // la deje antes de cambiarla:
+
+            std::unique_lock< std::mutex > lock(mutex);
+
+            done_condition.wait (lock, [this] () { return active_count == 0; });
+
+            task          = &new_task;
+            task_count    = new_task_count;
+            pending_count = new_task_count;
+
+            next_task.store (0, std::memory_order_relaxed);
+
+            ++generation;
+        }
+
+        wake_condition.notify_all ();
+
+        // El hilo que llama también toma tareas en lugar de quedarse esperando:
+
+        size_t completed = run_tasks ();
+
+        std::unique_lock< std::mutex > lock(mutex);
+
+        pending_count -= completed;
+
+        done_condition.wait (lock, [this] () { return pending_count == 0; });
+
+        task = nullptr;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Worker_Pool::ensure_threads (size_t count)
+    {
+        while (threads.size () < count)
+        {
+            threads.emplace_back (&Worker_Pool::thread_function, this);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Worker_Pool::thread_function ()
+    {
+        uint64_t seen_generation;
+
+        {
+            std::lock_guard< std::mutex > lock(mutex);
+
+            seen_generation = generation;
+        }
+
+        for (;;)
+        {
+            {
+                std::unique_lock< std::mutex > lock(mutex);
+
+                wake_condition.wait (lock, [&] () { return stopping || generation != seen_generation; });
+
+                if (stopping) return;
+
+                seen_generation = generation;
+
+                ++active_count;
+            }
+
+            size_t completed = run_tasks ();
+
+            {
+                std::lock_guard< std::mutex > lock(mutex);
+
+                pending_count -= completed;
+                active_count  -= 1;
+            }
+
+            done_condition.notify_all ();
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    size_t Worker_Pool::run_tasks ()
+    {
+        // Las tareas se toman de una en una con un contador atómico, así que los hilos que
+        // despiertan tarde simplemente encuentran menos trabajo:
+
+        size_t completed = 0;
+
+        for (size_t index; (index = next_task.fetch_add (1, std::memory_order_relaxed)) < task_count; ++completed)
+        {
+            (*task) (index);
+        }
+
+        return completed;
+    }
+
+}
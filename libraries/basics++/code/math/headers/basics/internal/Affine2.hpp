@@ -0,0 +1,224 @@
+/*
+ *  AFFINE 2
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C1802121730
+ */
+
+#ifndef BASICS_AFFINE2_HEADER
+#define BASICS_AFFINE2_HEADER
+
+    #include <cmath>
+    #include "Point.hpp"
+    #include "Transformation.hpp"
+    #include "Vector.hpp"
+
+    namespace basics
+    {
+
+        /**
+         * Transformación afín 2D guardada como las dos primeras filas de la matriz 3x3 equivalente
+         * (la tercera fila de una transformación afín siempre es 0 0 1):
+         *
+         *     | a  b  tx |
+         *     | c  d  ty |
+         *
+         * Ocupa 6 valores en lugar de 9, y componerla, invertirla o aplicarla a un punto se resuelve
+         * con fórmulas cerradas que evitan las multiplicaciones por 0 y por 1 de la matriz completa.
+         * Sigue el mismo convenio que Transformation: (A * B) aplica primero B y luego A.
+         */
+        template< typename NUMERIC_TYPE >
+        class Affine2
+        {
+        public:
+
+            typedef NUMERIC_TYPE Numeric_Type;
+            typedef Numeric_Type Number;
+
+            typedef basics::Transformation< 2, Numeric_Type > Transformation;
+            typedef basics::Point         < 2, Numeric_Type > Point;
+            typedef basics::Vector        < 2, Numeric_Type > Vector;
+
+        public:
+
+            Number a, b, tx;
+            Number c, d, ty;
+
+        public:
+
+            constexpr Affine2()
+            :
+                a(1), b(0), tx(0),
+                c(0), d(1), ty(0)
+            {
+            }
+
+            constexpr Affine2(Number a, Number b, Number tx, Number c, Number d, Number ty)
+            :
+                a(a), b(b), tx(tx),
+                c(c), d(d), ty(ty)
+            {
+            }
+
+            /**
+             * Toma las dos primeras filas de la matriz de la transformación (se supone que es afín).
+             */
+            explicit Affine2(const Transformation & transformation)
+            :
+                a(transformation.matrix[0][0]), b(transformation.matrix[0][1]), tx(transformation.matrix[0][2]),
+                c(transformation.matrix[1][0]), d(transformation.matrix[1][1]), ty(transformation.matrix[1][2])
+            {
+            }
+
+        public:
+
+            static constexpr Affine2 translation (Number x, Number y)
+            {
+                return Affine2(1, 0, x, 0, 1, y);
+            }
+
+            static constexpr Affine2 scaling (Number scale_x, Number scale_y)
+            {
+                return Affine2(scale_x, 0, 0, 0, scale_y, 0);
+            }
+
+            static constexpr Affine2 scaling (Number scale)
+            {
+                return Affine2(scale, 0, 0, 0, scale, 0);
+            }
+
+            /**
+             * Crea una rotación a partir del seno y el coseno del ángulo ya calculados, lo cual
+             * permite crearla en tiempo de compilación o reutilizar valores precalculados.
+             */
+            static constexpr Affine2 rotation (Number sin, Number cos)
+            {
+                return Affine2(cos, -sin, 0, sin, cos, 0);
+            }
+
+            static Affine2 rotation (Number angle)
+            {
+                return rotation (std::sin (angle), std::cos (angle));
+            }
+
+            /**
+             * Equivale a rotate_then_translate_2d() con el seno y el coseno ya calculados.
+             */
+            static constexpr Affine2 rotation_then_translation (Number sin, Number cos, Number x, Number y)
+            {
+                return Affine2(cos, -sin, x, sin, cos, y);
+            }
+
+            /**
+             * Equivale a scale_then_translate_2d().
+             */
+            static constexpr Affine2 scaling_then_translation (Number scale_x, Number scale_y, Number x, Number y)
+            {
+                return Affine2(scale_x, 0, x, 0, scale_y, y);
+            }
+
+            /**
+             * Equivale a translate_then_scale_2d().
+             */
+            static constexpr Affine2 translation_then_scaling (Number x, Number y, Number scale_x, Number scale_y)
+            {
+                return Affine2(scale_x, 0, x * scale_x, 0, scale_y, y * scale_y);
+            }
+
+        public:
+
+            constexpr Affine2 operator * (const Affine2 & other) const
+            {
+                return Affine2
+                (
+                    a * other.a + b * other.c,  a * other.b + b * other.d,  a * other.tx + b * other.ty + tx,
+                    c * other.a + d * other.c,  c * other.b + d * other.d,  c * other.tx + d * other.ty + ty
+                );
+            }
+
+            Affine2 & operator *= (const Affine2 & other)
+            {
+                return *this = *this * other;
+            }
+
+            constexpr Number determinant () const
+            {
+                return a * d - b * c;
+            }
+
+            /**
+             * Retorna la transformación inversa. La transformación debe ser invertible (su
+             * determinante no puede ser 0).
+             */
+            Affine2 inverse () const
+            {
+                Number inverse_determinant = Number(1) / determinant ();
+
+                Number ia =  d * inverse_determinant;
+                Number ib = -b * inverse_determinant;
+                Number ic = -c * inverse_determinant;
+                Number id =  a * inverse_determinant;
+
+                return Affine2(ia, ib, -(ia * tx + ib * ty), ic, id, -(ic * tx + id * ty));
+            }
+
+        public:
+
+            Point transform (const Point & point) const
+            {
+                return Point(a * point[0] + b * point[1] + tx, c * point[0] + d * point[1] + ty);
+            }
+
+            /**
+             * Transforma un vector (las traslaciones no le afectan).
+             */
+            Vector transform (const Vector & vector) const
+            {
+                return Vector(a * vector[0] + b * vector[1], c * vector[0] + d * vector[1]);
+            }
+
+            Point operator * (const Point & point) const
+            {
+                return transform (point);
+            }
+
+        public:
+
+            Transformation to_transformation () const
+            {
+                Transformation transformation;
+
+                transformation.matrix[0][0] = a; transformation.matrix[0][1] = b; transformation.matrix[0][2] = tx;
+                transformation.matrix[1][0] = c; transformation.matrix[1][1] = d; transformation.matrix[1][2] = ty;
+
+                return transformation;
+            }
+
+            operator Transformation () const
+            {
+                return to_transformation ();
+            }
+
+            bool operator == (const Affine2 & other) const
+            {
+                return a == other.a && b == other.b && tx == other.tx && c == other.c && d == other.d && ty == other.ty;
+            }
+
+            bool operator != (const Affine2 & other) const
+            {
+                return !(*this == other);
+            }
+
+        };
+
+        typedef Affine2< float  > Affine2f;
+        typedef Affine2< double > Affine2d;
+
+    }
+
+#endif
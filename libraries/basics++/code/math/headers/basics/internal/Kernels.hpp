@@ -0,0 +1,481 @@
+/*
+ *  KERNELS
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C1802131240
+ */
+
+#ifndef BASICS_KERNELS_HEADER
+#define BASICS_KERNELS_HEADER
+
+    #include <cmath>
+    #include <cstddef>
+    #include <limits>
+    #include "Affine2.hpp"
+    #include "Point.hpp"
+    #include "Simd.hpp"
+
+    namespace basics
+    {
+
+        /**
+         * Funciones que operan sobre arrays completos de puntos 2D, guardados como dos arrays
+         * separados de coordenadas x e y (estructura de arrays) o como arrays contiguos de Point2f.
+         * Usan SSE o NEON cuando están disponibles.
+         * Cada elemento se procesa de forma independiente, por lo que el trabajo se puede repartir
+         * entre varios hilos (por ejemplo con un parallel_for) pasando a cada uno un subrango de los
+         * arrays. Los resultados parciales de bounds() se combinan con Bounds2f::merge().
+         * Salvo que se indique lo contrario, los arrays de salida pueden coincidir con los de entrada.
+         */
+        namespace kernels
+        {
+
+            static_assert(sizeof(Point2f) == 2 * sizeof(float), "basics::kernels require Point2f to be two packed floats.");
+
+            /**
+             * Caja alineada con los ejes que envuelve un conjunto de puntos.
+             */
+            struct Bounds2f
+            {
+                float left, bottom, right, top;
+
+                static constexpr Bounds2f none ()
+                {
+                    return
+                    {
+                         std::numeric_limits< float >::max (),
+                         std::numeric_limits< float >::max (),
+                        -std::numeric_limits< float >::max (),
+                        -std::numeric_limits< float >::max ()
+                    };
+                }
+
+                bool empty () const
+                {
+                    return left > right || bottom > top;
+                }
+
+                void merge (const Bounds2f & other)
+                {
+                    if (other.left   < left  ) left   = other.left;
+                    if (other.bottom < bottom) bottom = other.bottom;
+                    if (other.right  > right ) right  = other.right;
+                    if (other.top    > top   ) top    = other.top;
+                }
+            };
+
+            // -------------------------------------------------------------------------------------
+
+            /**
+             * Calcula el seno y el coseno de un ángulo con la misma aproximación polinómica que usa
+             * la versión vectorial (error de unos pocos ulp para |angle| < 8192).
+             */
+            inline void sincos (float angle, float & sine, float & cosine)
+            {
+                float quadrant = std::nearbyint (angle * 0.636619772367581f);       // 2 / pi
+                int   q        = int(quadrant);
+
+                float r  = ((angle - quadrant * 1.5703125f) - quadrant * 4.837512969970703125e-4f) - quadrant * 7.54978995489188216e-8f;
+                float r2 = r * r;
+
+                float s  = r + r * r2 * (-1.6666654611e-1f + r2 * (8.3321608736e-3f + r2 * -1.9515295891e-4f));
+                float c  = 1.f - 0.5f * r2 + r2 * r2 * (4.166664568298827e-2f + r2 * (-1.388731625493765e-3f + r2 * 2.443315711809948e-5f));
+
+                if (q & 1) { float t = s; s = c; c = t; }
+
+                sine   = (q       & 2) ? -s : s;
+                cosine = ((q + 1) & 2) ? -c : c;
+            }
+
+            #if defined(BASICS_MATH_SIMD)
+
+                inline void sincos (simd::float4 angle, simd::float4 & sine, simd::float4 & cosine)
+                {
+                    using namespace simd;
+
+                    int4   q        = round_to_int (multiply (angle, splat (0.636619772367581f)));
+                    float4 quadrant = to_float (q);
+
+                    float4 r  = subtract (angle, multiply (quadrant, splat (1.5703125f)));
+                           r  = subtract (r,     multiply (quadrant, splat (4.837512969970703125e-4f)));
+                           r  = subtract (r,     multiply (quadrant, splat (7.54978995489188216e-8f)));
+                    float4 r2 = multiply (r, r);
+
+                    float4 s  = multiply_add (splat (8.3321608736e-3f), r2, splat (-1.9515295891e-4f));
+                           s  = multiply_add (splat (-1.6666654611e-1f), r2, s);
+                           s  = multiply_add (r, multiply (r, r2), s);
+
+                    float4 c  = multiply_add (splat (-1.388731625493765e-3f), r2, splat (2.443315711809948e-5f));
+                           c  = multiply_add (splat (4.166664568298827e-2f), r2, c);
+                           c  = multiply_add (subtract (splat (1.f), multiply (splat (0.5f), r2)), multiply (r2, r2), c);
+
+                    sine   = negate_if_bit1 (q,              select_odd (q, s, c));
+                    cosine = negate_if_bit1 (add_int (q, 1), select_odd (q, c, s));
+                }
+
+            #endif
+
+            /**
+             * Calcula el seno y el coseno de todos los ángulos.
+             */
+            inline void sincos (const float * angles, float * sines, float * cosines, size_t count)
+            {
+                size_t index = 0;
+
+                #if defined(BASICS_MATH_SIMD)
+
+                    for ( ; index + 4 <= count; index += 4)
+                    {
+                        simd::float4 sine, cosine;
+
+                        sincos (simd::load (angles + index), sine, cosine);
+
+                        simd::store (sines   + index, sine  );
+                        simd::store (cosines + index, cosine);
+                    }
+
+                #endif
+
+                for ( ; index < count; ++index)
+                {
+                    sincos (angles[index], sines[index], cosines[index]);
+                }
+            }
+
+            // -------------------------------------------------------------------------------------
+
+            inline void transform (const Affine2f & affine, const float * xs, const float * ys, float * out_xs, float * out_ys, size_t count)
+            {
+                size_t index = 0;
+
+                #if defined(BASICS_MATH_SIMD)
+
+                    simd::float4 a  = simd::splat (affine.a ), b = simd::splat (affine.b), tx = simd::splat (affine.tx);
+                    simd::float4 c  = simd::splat (affine.c ), d = simd::splat (affine.d), ty = simd::splat (affine.ty);
+
+                    for ( ; index + 4 <= count; index += 4)
+                    {
+                        simd::float4 x = simd::load (xs + index);
+                        simd::float4 y = simd::load (ys + index);
+
+                        simd::store (out_xs + index, simd::multiply_add (simd::multiply_add (tx, a, x), b, y));
+                        simd::store (out_ys + index, simd::multiply_add (simd::multiply_add (ty, c, x), d, y));
+                    }
+
+                #endif
+
+                for ( ; index < count; ++index)
+                {
+                    float x = xs[index];
+                    float y = ys[index];
+
+                    out_xs[index] = affine.a * x + affine.b * y + affine.tx;
+                    out_ys[index] = affine.c * x + affine.d * y + affine.ty;
+                }
+            }
+
+            inline void transform (const Affine2f & affine, const Point2f * points, Point2f * out_points, size_t count)
+            {
+                const float * in  = reinterpret_cast< const float * >(points    );
+                      float * out = reinterpret_cast<       float * >(out_points);
+                size_t        index = 0;
+
+                #if defined(BASICS_MATH_SIMD)
+
+                    // Cada vector contiene dos puntos (x0, y0, x1, y1):
+
+                    simd::float4 ac = simd::set (affine.a,  affine.c,  affine.a,  affine.c );
+                    simd::float4 bd = simd::set (affine.b,  affine.d,  affine.b,  affine.d );
+                    simd::float4 t  = simd::set (affine.tx, affine.ty, affine.tx, affine.ty);
+
+                    for ( ; index + 2 <= count; index += 2)
+                    {
+                        simd::float4 xy = simd::load (in + index * 2);
+
+                        simd::float4 result = simd::multiply_add (t,      ac, simd::duplicate_even (xy));
+                                     result = simd::multiply_add (result, bd, simd::duplicate_odd  (xy));
+
+                        simd::store (out + index * 2, result);
+                    }
+
+                #endif
+
+                for ( ; index < count; ++index)
+                {
+                    float x = in[index * 2    ];
+                    float y = in[index * 2 + 1];
+
+                    out[index * 2    ] = affine.a * x + affine.b * y + affine.tx;
+                    out[index * 2 + 1] = affine.c * x + affine.d * y + affine.ty;
+                }
+            }
+
+            // -------------------------------------------------------------------------------------
+
+            inline void translate (float dx, float dy, float * xs, float * ys, size_t count)
+            {
+                size_t index = 0;
+
+                #if defined(BASICS_MATH_SIMD)
+
+                    simd::float4 vdx = simd::splat (dx);
+                    simd::float4 vdy = simd::splat (dy);
+
+                    for ( ; index + 4 <= count; index += 4)
+                    {
+                        simd::store (xs + index, simd::add (simd::load (xs + index), vdx));
+                        simd::store (ys + index, simd::add (simd::load (ys + index), vdy));
+                    }
+
+                #endif
+
+                for ( ; index < count; ++index)
+                {
+                    xs[index] += dx;
+                    ys[index] += dy;
+                }
+            }
+
+            inline void translate (float dx, float dy, Point2f * points, size_t count)
+            {
+                float * values = reinterpret_cast< float * >(points);
+                size_t  index  = 0;
+
+                #if defined(BASICS_MATH_SIMD)
+
+                    simd::float4 displacement = simd::set (dx, dy, dx, dy);
+
+                    for ( ; index + 2 <= count; index += 2)
+                    {
+                        simd::store (values + index * 2, simd::add (simd::load (values + index * 2), displacement));
+                    }
+
+                #endif
+
+                for ( ; index < count; ++index)
+                {
+                    values[index * 2    ] += dx;
+                    values[index * 2 + 1] += dy;
+                }
+            }
+
+            // -------------------------------------------------------------------------------------
+
+            inline void scale (float sx, float sy, float * xs, float * ys, size_t count)
+            {
+                size_t index = 0;
+
+                #if defined(BASICS_MATH_SIMD)
+
+                    simd::float4 vsx = simd::splat (sx);
+                    simd::float4 vsy = simd::splat (sy);
+
+                    for ( ; index + 4 <= count; index += 4)
+                    {
+                        simd::store (xs + index, simd::multiply (simd::load (xs + index), vsx));
+                        simd::store (ys + index, simd::multiply (simd::load (ys + index), vsy));
+                    }
+
+                #endif
+
+                for ( ; index < count; ++index)
+                {
+                    xs[index] *= sx;
+                    ys[index] *= sy;
+                }
+            }
+
+            inline void scale (float sx, float sy, Point2f * points, size_t count)
+            {
+                float * values = reinterpret_cast< float * >(points);
+                size_t  index  = 0;
+
+                #if defined(BASICS_MATH_SIMD)
+
+                    simd::float4 factors = simd::set (sx, sy, sx, sy);
+
+                    for ( ; index + 2 <= count; index += 2)
+                    {
+                        simd::store (values + index * 2, simd::multiply (simd::load (values + index * 2), factors));
+                    }
+
+                #endif
+
+                for ( ; index < count; ++index)
+                {
+                    values[index * 2    ] *= sx;
+                    values[index * 2 + 1] *= sy;
+                }
+            }
+
+            // -------------------------------------------------------------------------------------
+
+            /**
+             * Gira cada punto alrededor del origen según su propio ángulo (en radianes).
+             */
+            inline void rotate (const float * angles, const float * xs, const float * ys, float * out_xs, float * out_ys, size_t count)
+            {
+                size_t index = 0;
+
+                #if defined(BASICS_MATH_SIMD)
+
+                    for ( ; index + 4 <= count; index += 4)
+                    {
+                        simd::float4 sine, cosine;
+
+                        sincos (simd::load (angles + index), sine, cosine);
+
+                        simd::float4 x = simd::load (xs + index);
+                        simd::float4 y = simd::load (ys + index);
+
+                        simd::store (out_xs + index, simd::subtract (simd::multiply (x, cosine), simd::multiply (y, sine)));
+                        simd::store (out_ys + index, simd::add      (simd::multiply (x, sine  ), simd::multiply (y, cosine)));
+                    }
+
+                #endif
+
+                for ( ; index < count; ++index)
+                {
+                    float sine, cosine;
+
+                    sincos (angles[index], sine, cosine);
+
+                    float x = xs[index];
+                    float y = ys[index];
+
+                    out_xs[index] = x * cosine - y * sine;
+                    out_ys[index] = x * sine   + y * cosine;
+                }
+            }
+
+            // -------------------------------------------------------------------------------------
+
+            /**
+             * Desplaza cada posición según su velocidad durante el tiempo indicado (x += vx * time).
+             */
+            inline void integrate (float * xs, float * ys, const float * speeds_x, const float * speeds_y, float time, size_t count)
+            {
+                size_t index = 0;
+
+                #if defined(BASICS_MATH_SIMD)
+
+                    simd::float4 vtime = simd::splat (time);
+
+                    for ( ; index + 4 <= count; index += 4)
+                    {
+                        simd::store (xs + index, simd::multiply_add (simd::load (xs + index), simd::load (speeds_x + index), vtime));
+                        simd::store (ys + index, simd::multiply_add (simd::load (ys + index), simd::load (speeds_y + index), vtime));
+                    }
+
+                #endif
+
+                for ( ; index < count; ++index)
+                {
+                    xs[index] += speeds_x[index] * time;
+                    ys[index] += speeds_y[index] * time;
+                }
+            }
+
+            // -------------------------------------------------------------------------------------
+
+            inline Bounds2f bounds (const float * xs, const float * ys, size_t count)
+            {
+                Bounds2f result = Bounds2f::none ();
+                size_t   index  = 0;
+
+                #if defined(BASICS_MATH_SIMD)
+
+                    if (count >= 4)
+                    {
+                        simd::float4 min_x = simd::load (xs), max_x = min_x;
+                        simd::float4 min_y = simd::load (ys), max_y = min_y;
+
+                        for (index = 4; index + 4 <= count; index += 4)
+                        {
+                            simd::float4 x = simd::load (xs + index);
+                            simd::float4 y = simd::load (ys + index);
+
+                            min_x = simd::minimum (min_x, x);
+                            max_x = simd::maximum (max_x, x);
+                            min_y = simd::minimum (min_y, y);
+                            max_y = simd::maximum (max_y, y);
+                        }
+
+                        result.left   = simd::horizontal_minimum (min_x);
+                        result.bottom = simd::horizontal_minimum (min_y);
+                        result.right  = simd::horizontal_maximum (max_x);
+                        result.top    = simd::horizontal_maximum (max_y);
+                    }
+
+                #endif
+
+                for ( ; index < count; ++index)
+                {
+                    if (xs[index] < result.left  ) result.left   = xs[index];
+                    if (xs[index] > result.right ) result.right  = xs[index];
+                    if (ys[index] < result.bottom) result.bottom = ys[index];
+                    if (ys[index] > result.top   ) result.top    = ys[index];
+                }
+
+                return result;
+            }
+
+            inline Bounds2f bounds (const Point2f * points, size_t count)
+            {
+                const float * values = reinterpret_cast< const float * >(points);
+                Bounds2f      result = Bounds2f::none ();
+                size_t        index  = 0;
+
+                #if defined(BASICS_MATH_SIMD)
+
+                    if (count >= 2)
+                    {
+                        // Los lanes pares acumulan las x y los impares las y:
+
+                        simd::float4 low = simd::load (values), high = low;
+
+                        for (index = 2; index + 2 <= count; index += 2)
+                        {
+                            simd::float4 xy = simd::load (values + index * 2);
+
+                            low  = simd::minimum (low,  xy);
+                            high = simd::maximum (high, xy);
+                        }
+
+                        float lows[4], highs[4];
+
+                        simd::store (lows,  low );
+                        simd::store (highs, high);
+
+                        result.left   = lows [0] < lows [2] ? lows [0] : lows [2];
+                        result.bottom = lows [1] < lows [3] ? lows [1] : lows [3];
+                        result.right  = highs[0] > highs[2] ? highs[0] : highs[2];
+                        result.top    = highs[1] > highs[3] ? highs[1] : highs[3];
+                    }
+
+                #endif
+
+                for ( ; index < count; ++index)
+                {
+                    float x = values[index * 2    ];
+                    float y = values[index * 2 + 1];
+
+                    if (x < result.left  ) result.left   = x;
+                    if (x > result.right ) result.right  = x;
+                    if (y < result.bottom) result.bottom = y;
+                    if (y > result.top   ) result.top    = y;
+                }
+
+                return result;
+            }
+
+        }
+
+    }
+
+#endif
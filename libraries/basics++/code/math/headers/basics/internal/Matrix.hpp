@@ -262,4 +262,6 @@
 
     }
 
+    #include "Matrix_Simd.hpp"
+
 #endif
@@ -0,0 +1,116 @@
+/*
+ *  MATRIX SIMD
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C1802121015
+ */
+
+#ifndef BASICS_MATRIX_SIMD_HEADER
+#define BASICS_MATRIX_SIMD_HEADER
+
+    // Especializaciones SSE/NEON de los productos de matrices de floats 3x3 y 4x4 más usados. Cada
+    // lane repite la misma secuencia de operaciones que la plantilla genérica (empezando en 0 y
+    // acumulando desde el último índice hacia el primero). Los proyectos de CMake (math y
+    // benchmarks) compilan con -ffp-contract=off y BASICS_MATH_NO_FMA para que el resultado sea
+    // idéntico bit a bit al de la plantilla genérica, lo que comprueban los benchmarks en cada
+    // ejecución. Con otras opciones el compilador puede fusionar multiplicaciones y sumas en uno de
+    // los dos caminos y no en el otro, y cada elemento puede diferir en el último bit.
+    // Los productos de una matriz por un vector columna no se especializan porque transponer la
+    // matriz para operar por columnas resultaba más lento que la plantilla genérica.
+
+    #include "Simd.hpp"
+
+    #if defined(BASICS_MATH_SIMD)
+
+        namespace basics
+        {
+
+            namespace simd
+            {
+
+                /**
+                 * Calcula la combinación lineal a0 * r0 + a1 * r1 + ... sumando desde el último término,
+                 * igual que la plantilla genérica.
+                 */
+                inline float4 combine (float a0, float4 r0, float a1, float4 r1, float a2, float4 r2)
+                {
+                    float4 total = zero ();
+
+                    total = multiply_add (total, splat (a2), r2);
+                    total = multiply_add (total, splat (a1), r1);
+                    total = multiply_add (total, splat (a0), r0);
+
+                    return total;
+                }
+
+                inline float4 combine (float a0, float4 r0, float a1, float4 r1, float a2, float4 r2, float a3, float4 r3)
+                {
+                    float4 total = zero ();
+
+                    total = multiply_add (total, splat (a3), r3);
+                    total = multiply_add (total, splat (a2), r2);
+                    total = multiply_add (total, splat (a1), r1);
+                    total = multiply_add (total, splat (a0), r0);
+
+                    return total;
+                }
+
+            }
+
+            // -------------------------------------------------------------------------------------
+
+            template< >
+            template< >
+            inline const Matrix< 3, 3, float > Matrix< 3, 3, float >::operator * < 3 > (const Matrix< 3, 3, float > & other) const
+            {
+                Matrix< 3, 3, float > result;
+
+                const float * a = this->values;
+                const float * b = other.values;
+
+                // Las dos primeras filas se pueden leer con 4 lanes sin salirse del array. El cuarto
+                // lane de cada fila intermedia se sobrescribe al guardar la fila siguiente:
+
+                simd::float4 b0 = simd::load  (b + 0);
+                simd::float4 b1 = simd::load  (b + 3);
+                simd::float4 b2 = simd::load3 (b + 6);
+
+                simd::store  (result.values + 0, simd::combine (a[0], b0, a[1], b1, a[2], b2));
+                simd::store  (result.values + 3, simd::combine (a[3], b0, a[4], b1, a[5], b2));
+                simd::store3 (result.values + 6, simd::combine (a[6], b0, a[7], b1, a[8], b2));
+
+                return result;
+            }
+
+            template< >
+            template< >
+            inline const Matrix< 4, 4, float > Matrix< 4, 4, float >::operator * < 4 > (const Matrix< 4, 4, float > & other) const
+            {
+                Matrix< 4, 4, float > result;
+
+                const float * a = this->values;
+                const float * b = other.values;
+
+                simd::float4 b0 = simd::load (b +  0);
+                simd::float4 b1 = simd::load (b +  4);
+                simd::float4 b2 = simd::load (b +  8);
+                simd::float4 b3 = simd::load (b + 12);
+
+                for (unsigned r = 0; r < 16; r += 4)
+                {
+                    simd::store (result.values + r, simd::combine (a[r + 0], b0, a[r + 1], b1, a[r + 2], b2, a[r + 3], b3));
+                }
+
+                return result;
+            }
+
+        }
+
+    #endif
+
+#endif
@@ -0,0 +1,204 @@
+/*
+ *  SIMD
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C1802131105
+ */
+
+#ifndef BASICS_SIMD_HEADER
+#define BASICS_SIMD_HEADER
+
+    // Operaciones mínimas sobre vectores de 4 floats que abstraen SSE2 y NEON para el módulo de
+    // matemáticas. Si el procesador no dispone de ninguna de ellas no se define BASICS_MATH_SIMD y
+    // el código que las usa debe recurrir a su versión escalar.
+    // Cuando el procesador dispone de FMA multiply_add() fusiona la multiplicación y la suma, que es
+    // más rápido y redondea una vez menos. Los compiladores también fusionan por defecto parte de
+    // las operaciones del código escalar, pero no necesariamente las mismas, por lo que los
+    // resultados pueden diferir en unos pocos ULP. Para obtener exactamente los mismos resultados
+    // que el código escalar hay que compilar con -ffp-contract=off y definir BASICS_MATH_NO_FMA,
+    // como hacen los proyectos de CMake (projects/math y projects/benchmarks).
+    // Se pueden desactivar definiendo BASICS_MATH_NO_SIMD.
+
+    #if !defined(BASICS_MATH_NO_SIMD)
+        #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+            #define BASICS_MATH_SSE
+            #if defined(__FMA__) && !defined(BASICS_MATH_NO_FMA)
+                #define BASICS_MATH_FMA
+                #include <immintrin.h>
+            #else
+                #include <emmintrin.h>
+            #endif
+        #elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+            #define BASICS_MATH_NEON
+            #if defined(__ARM_FEATURE_FMA) && !defined(BASICS_MATH_NO_FMA)
+                #define BASICS_MATH_FMA
+            #endif
+            #include <arm_neon.h>
+        #endif
+    #endif
+
+    #if defined(BASICS_MATH_SSE) || defined(BASICS_MATH_NEON)
+
+        #define BASICS_MATH_SIMD
+
+        namespace basics { namespace simd
+        {
+
+            #if defined(BASICS_MATH_SSE)
+
+                typedef __m128  float4;
+                typedef __m128i int4;
+
+                inline float4 zero       ()                         { return _mm_setzero_ps ();     }
+                inline float4 splat      (float value)              { return _mm_set1_ps (value);   }
+                inline float4 set        (float a, float b, float c, float d) { return _mm_setr_ps (a, b, c, d); }
+                inline float4 load       (const float * values)     { return _mm_loadu_ps (values); }
+                inline float4 load3      (const float * values)     { return _mm_set_ps (0.f, values[2], values[1], values[0]); }
+                inline void   store      (float * values, float4 a) { _mm_storeu_ps (values, a);    }
+
+                inline void   store3     (float * values, float4 a)
+                {
+                    _mm_storel_pi (reinterpret_cast< __m64 * >(values), a);
+                    _mm_store_ss  (values + 2, _mm_movehl_ps (a, a));
+                }
+
+                inline float4 add        (float4 a, float4 b)       { return _mm_add_ps (a, b);     }
+                inline float4 subtract   (float4 a, float4 b)       { return _mm_sub_ps (a, b);     }
+                inline float4 multiply   (float4 a, float4 b)       { return _mm_mul_ps (a, b);     }
+                inline float4 minimum    (float4 a, float4 b)       { return _mm_min_ps (a, b);     }
+                inline float4 maximum    (float4 a, float4 b)       { return _mm_max_ps (a, b);     }
+
+                #if defined(BASICS_MATH_FMA)
+                inline float4 multiply_add (float4 total, float4 a, float4 b) { return _mm_fmadd_ps (a, b, total); }
+                #else
+                inline float4 multiply_add (float4 total, float4 a, float4 b) { return _mm_add_ps (total, _mm_mul_ps (a, b)); }
+                #endif
+
+                /// Retorna { a0, a0, a2, a2 } y { a1, a1, a3, a3 }. Sirve para separar las x y las y de dos puntos 2D.
+                inline float4 duplicate_even (float4 a)             { return _mm_shuffle_ps (a, a, _MM_SHUFFLE(2, 2, 0, 0)); }
+                inline float4 duplicate_odd  (float4 a)             { return _mm_shuffle_ps (a, a, _MM_SHUFFLE(3, 3, 1, 1)); }
+
+                inline int4   round_to_int   (float4 a)             { return _mm_cvtps_epi32 (a); }
+                inline float4 to_float       (int4   a)             { return _mm_cvtepi32_ps (a); }
+
+                /// Retorna b en los lanes en los que el bit 0 de mask es 1 y a en el resto.
+                inline float4 select_odd     (int4 mask, float4 a, float4 b)
+                {
+                    float4 condition = _mm_castsi128_ps (_mm_cmpeq_epi32 (_mm_and_si128 (mask, _mm_set1_epi32 (1)), _mm_set1_epi32 (1)));
+
+                    return _mm_or_ps (_mm_and_ps (condition, b), _mm_andnot_ps (condition, a));
+                }
+
+                /// Cambia el signo de los lanes en los que el bit 1 de mask es 1.
+                inline float4 negate_if_bit1 (int4 mask, float4 a)
+                {
+                    return _mm_xor_ps (a, _mm_castsi128_ps (_mm_slli_epi32 (_mm_and_si128 (mask, _mm_set1_epi32 (2)), 30)));
+                }
+
+                inline int4   add_int        (int4 a, int b)        { return _mm_add_epi32 (a, _mm_set1_epi32 (b)); }
+
+            #else
+
+                typedef float32x4_t float4;
+                typedef int32x4_t   int4;
+
+                inline float4 zero       ()                         { return vdupq_n_f32 (0.f);     }
+                inline float4 splat      (float value)              { return vdupq_n_f32 (value);   }
+                inline float4 load       (const float * values)     { return vld1q_f32 (values);    }
+                inline float4 load3      (const float * values)     { return vcombine_f32 (vld1_f32 (values), vset_lane_f32 (values[2], vdup_n_f32 (0.f), 0)); }
+                inline void   store      (float * values, float4 a) { vst1q_f32 (values, a);        }
+
+                inline float4 set        (float a, float b, float c, float d)
+                {
+                    const float values[] = { a, b, c, d };
+
+                    return vld1q_f32 (values);
+                }
+
+                inline void   store3     (float * values, float4 a)
+                {
+                    vst1_f32       (values,     vget_low_f32 (a));
+                    vst1q_lane_f32 (values + 2, a, 2);
+                }
+
+                inline float4 add        (float4 a, float4 b)       { return vaddq_f32 (a, b);      }
+                inline float4 subtract   (float4 a, float4 b)       { return vsubq_f32 (a, b);      }
+                inline float4 multiply   (float4 a, float4 b)       { return vmulq_f32 (a, b);      }
+                inline float4 minimum    (float4 a, float4 b)       { return vminq_f32 (a, b);      }
+                inline float4 maximum    (float4 a, float4 b)       { return vmaxq_f32 (a, b);      }
+
+                #if defined(BASICS_MATH_FMA)
+                inline float4 multiply_add (float4 total, float4 a, float4 b) { return vfmaq_f32 (total, a, b); }
+                #else
+                inline float4 multiply_add (float4 total, float4 a, float4 b) { return vaddq_f32 (total, vmulq_f32 (a, b)); }
+                #endif
+
+                inline float4 duplicate_even (float4 a)             { return vtrnq_f32 (a, a).val[0]; }
+                inline float4 duplicate_odd  (float4 a)             { return vtrnq_f32 (a, a).val[1]; }
+
+                inline int4   round_to_int   (float4 a)
+                {
+                    // Se redondea al entero más cercano sumando ±0.5 antes de truncar (ARMv7 no
+                    // dispone de vcvtnq_s32_f32):
+
+                    uint32x4_t negative = vcltq_f32 (a, vdupq_n_f32 (0.f));
+
+                    return vcvtq_s32_f32 (vaddq_f32 (a, vbslq_f32 (negative, vdupq_n_f32 (-.5f), vdupq_n_f32 (.5f))));
+                }
+
+                inline float4 to_float       (int4 a)               { return vcvtq_f32_s32 (a); }
+
+                inline float4 select_odd     (int4 mask, float4 a, float4 b)
+                {
+                    uint32x4_t condition = vtstq_s32 (mask, vdupq_n_s32 (1));
+
+                    return vbslq_f32 (condition, b, a);
+                }
+
+                inline float4 negate_if_bit1 (int4 mask, float4 a)
+                {
+                    uint32x4_t sign = vshlq_n_u32 (vreinterpretq_u32_s32 (vandq_s32 (mask, vdupq_n_s32 (2))), 30);
+
+                    return vreinterpretq_f32_u32 (veorq_u32 (vreinterpretq_u32_f32 (a), sign));
+                }
+
+                inline int4   add_int        (int4 a, int b)        { return vaddq_s32 (a, vdupq_n_s32 (b)); }
+
+            #endif
+
+            inline float horizontal_minimum (float4 a)
+            {
+                float values[4];
+
+                store (values, a);
+
+                float result = values[0];
+
+                for (unsigned index = 1; index < 4; ++index) if (values[index] < result) result = values[index];
+
+                return result;
+            }
+
+            inline float horizontal_maximum (float4 a)
+            {
+                float values[4];
+
+                store (values, a);
+
+                float result = values[0];
+
+                for (unsigned index = 1; index < 4; ++index) if (values[index] > result) result = values[index];
+
+                return result;
+            }
+
+        }}
+
+    #endif
+
+#endif
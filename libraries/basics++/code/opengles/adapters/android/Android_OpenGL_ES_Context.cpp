@@ -22,6 +22,7 @@
 
 #if defined(BASICS_ANDROID_OS)
 
+    #include <basics/Startup_Timeline>
     #include <basics/opengles/OpenGL_ES1>
     #include "Android_OpenGL_ES_Context.hpp"
     #include "../../../base/adapters/android/Native_Window.hpp"
@@ -171,6 +172,10 @@
                 {
                     if (egl_version_major > 1 || (egl_version_major == 1 && egl_version_minor >= 3))
                     {
+                        // eglInitialize() puede tardar decenas de milisegundos en un arranque en frío:
+
+                        startup_timeline.mark ("egl display initialized");
+
                         return true;
                     }
                 }
@@ -204,6 +209,8 @@
                     eglQuerySurface (display, surface, EGL_WIDTH,  &surface_width );
                     eglQuerySurface (display, surface, EGL_HEIGHT, &surface_height);
 
+                    startup_timeline.mark ("egl surface created");
+
                     return true;
                 }
             }
@@ -221,6 +228,8 @@
 
             context = eglCreateContext (display, config, EGL_NO_CONTEXT, context_attributes);
 
+            startup_timeline.mark ("egl context created");
+
             return context != EGL_NO_CONTEXT;
         }
 
@@ -14,6 +14,8 @@
 #define BASICS_OPENGLES_CANVAS_ES2_HEADER
 
     #include <memory>
+    #include <vector>
+    #include <basics/Affine2>
     #include <basics/Canvas>
     #include <basics/Transformation>
 
@@ -30,6 +32,8 @@
             static const char * internal_vertex_shader_t;
             static const char * internal_fragment_shader_f;
             static const char * internal_fragment_shader_t;
+            static const char * internal_vertex_shader_b;
+            static const char * internal_fragment_shader_b;
 
         public:
 
@@ -42,29 +46,46 @@
                 register_factory (ID(opengles2), Canvas_ES2::create);
             }
 
+        private:
+
+            struct Batch_Vertex
+            {
+                float    x, y;
+                float    u, v;
+                uint32_t color;
+            };
+
         private:
 
             Size2f size;
             Size2f half_size;
 
-            Transformation2f transform;
-            Transformation2f projection;
+            Affine2f transform;
+            Affine2f projection;
 
             std::shared_ptr< Shader_Program > shader_program_f;
             std::shared_ptr< Shader_Program > shader_program_t;
+            std::shared_ptr< Shader_Program > shader_program_b;
 
             int  transform_f_id;
-            int projection_f_id;
             int      color_f_id;
             int    opacity_f_id;
             int  transform_t_id;
-            int projection_t_id;
             int    sampler_t_id;
             int    opacity_t_id;
+            int  transform_b_id;
+            int    sampler_b_id;
+            int    opacity_b_id;
 
             unsigned   vertex_position_location_f;
             unsigned   vertex_position_location_t;
             unsigned vertex_texture_uv_location_t;
+            unsigned   vertex_position_location_b;
+            unsigned vertex_texture_uv_location_b;
+            unsigned     vertex_color_location_b;
+
+            std::vector< Batch_Vertex > batch;
+            std::vector< Point2f      > flat_batch;
 
         public:
 
@@ -97,6 +118,12 @@
             void fill_rectangle  (const Point2f & bottom_left, const Size2f & size) override;
             void fill_rectangle  (const Point2f & where, const Size2f & size, const basics::Texture_2D * texture, int handling = CENTER) override;
             void fill_rectangle  (const Point2f & where, const Size2f & size, const Atlas::Slice * slice, int handling = CENTER) override;
+            void fill_rectangles (const float * lefts, const float * bottoms, const float * widths, const float * heights, size_t count) override;
+            void fill_rectangles (const Atlas::Slice * slice, const float * xs, const float * ys, const float * sizes, const uint32_t * colors, size_t count) override;
+
+        private:
+
+            void upload_transform ();
 
         };
 
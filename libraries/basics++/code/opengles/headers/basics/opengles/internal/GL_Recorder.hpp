@@ -0,0 +1,328 @@
+/*
+ *  GL RECORDER
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C1802181020
+ */
+
+// Al compilar con BASICS_OPENGLES_GL_RECORDER definido, <basics/opengles/OpenGL_ES2> redirige las
+// funciones gl* a las de basics::opengles::recorded, que registran cada llamada con sus argumentos
+// en gl_recorder y después la reenvían al driver. Con BASICS_OPENGLES_GL_STUB (que activa también
+// el registro) no se llama al driver: se usa una implementación en CPU que no dibuja nada pero
+// devuelve valores válidos, por lo que se puede ejecutar sin GPU y sin enlazar GLESv2.
+//
+// Uso:
+//
+//     opengles::gl_recorder.begin_frame ();        // Director lo hace antes de Scene::render()
+//
+//     scene.render (context);
+//
+//     assert(opengles::gl_recorder.get_frame_counts ().draw_calls      <= 12);
+//     assert(opengles::gl_recorder.get_frame_counts ().uniform_uploads <= 20);
+
+#ifndef BASICS_OPENGLES_GL_RECORDER_HEADER
+#define BASICS_OPENGLES_GL_RECORDER_HEADER
+
+    // El stub en CPU solo se puede usar a través del registro de llamadas:
+
+    #if defined(BASICS_OPENGLES_GL_STUB) && !defined(BASICS_OPENGLES_GL_RECORDER)
+        #define BASICS_OPENGLES_GL_RECORDER
+    #endif
+
+    #include <cstdint>
+    #include <ostream>
+    #include <string>
+    #include <vector>
+    #include <initializer_list>
+    #include <GLES2/gl2.h>
+    #include <basics/Non_Copyable>
+
+    namespace basics { namespace opengles
+    {
+
+        /**
+         * Registro de las llamadas a OpenGL ES 2 de un fotograma y contadores del trabajo que
+         * suponen. Solo se debe usar desde el hilo que renderiza.
+         */
+        class GL_Recorder : Non_Copyable
+        {
+        public:
+
+            enum Category : uint8_t
+            {
+                DRAW,
+                BIND,                       ///< Texturas, programas y buffers.
+                UNIFORM,
+                UPLOAD,                     ///< Envío de datos de texturas y de buffers.
+                STATE,
+                RESOURCE,                   ///< Creación, compilación y destrucción de objetos.
+                QUERY,
+                OTHER,
+            };
+
+            static constexpr unsigned max_arguments = 9;
+
+            struct Call
+            {
+                const char * name;
+                Category     category;
+                uint8_t      argument_count;
+                double       arguments[max_arguments];      ///< Los punteros se guardan como su dirección.
+                std::string  text;                          ///< Nombre del uniform o del atributo, si lo hay.
+            };
+
+            struct Counts
+            {
+                uint32_t calls;
+                uint32_t draw_calls;
+                uint32_t vertices;
+                uint32_t binds;
+                uint32_t uniform_uploads;
+                uint32_t buffer_uploads;                    ///< Incluye los draws con arrays de vértices en memoria del cliente.
+                uint32_t state_changes;
+                uint64_t bytes_uploaded;
+            };
+
+        private:
+
+            /**
+             * Estado de los arrays de vértices necesario para calcular cuántos bytes se envían en
+             * cada draw cuando los vértices están en memoria del cliente.
+             */
+            struct Attribute
+            {
+                bool     enabled;
+                bool     client_memory;
+                uint32_t element_size;
+                uint32_t stride;
+            };
+
+            static constexpr unsigned max_attributes = 16;
+
+        private:
+
+            std::vector< Call > calls;
+            Counts              frame_counts;
+            Counts              last_frame_counts;
+            Counts              total_counts;
+            uint32_t            frame_number;
+            bool                recording_calls;                ///< Si es false solo se cuenta.
+
+            Attribute           attributes[max_attributes];
+            GLuint              array_buffer;
+            GLuint              element_array_buffer;
+
+        public:
+
+            GL_Recorder();
+
+        public:
+
+            /**
+             * Guarda los contadores del fotograma actual como los del último y empieza uno nuevo
+             * vaciando el registro de llamadas.
+             */
+            void begin_frame ();
+
+            /**
+             * Pone a cero todos los contadores y vacía el registro, pero conserva el estado de
+             * los arrays de vértices porque el contexto de OpenGL lo conserva.
+             */
+            void reset ();
+
+            void set_call_recording (bool status)
+            {
+                recording_calls = status;
+            }
+
+            bool is_recording_calls () const
+            {
+                return recording_calls;
+            }
+
+            uint32_t get_frame_number () const
+            {
+                return frame_number;
+            }
+
+            const Counts & get_frame_counts () const
+            {
+                return frame_counts;
+            }
+
+            const Counts & get_last_frame_counts () const
+            {
+                return last_frame_counts;
+            }
+
+            const Counts & get_total_counts () const
+            {
+                return total_counts;
+            }
+
+            const std::vector< Call > & get_calls () const
+            {
+                return calls;
+            }
+
+            /**
+             * Número de llamadas a la función indicada (por ejemplo, "glDrawArrays") registradas
+             * en el fotograma actual.
+             */
+            size_t count (const char * name) const;
+
+            /**
+             * Escribe en texto las llamadas registradas en el fotograma actual y sus contadores.
+             */
+            void write (std::ostream & output) const;
+
+        public:
+
+            // Usadas por las funciones de basics::opengles::recorded:
+
+            void record (const char * name, Category category, std::initializer_list< double > arguments, const char * text = nullptr);
+
+            void record_upload       (uint64_t bytes);
+            void record_draw         (GLsizei  count);
+            void record_indexed_draw (GLsizei  count, GLenum type);
+
+            void set_attribute_pointer (GLuint index, GLint size, GLenum type, GLsizei stride);
+            void set_attribute_enabled (GLuint index, bool status);
+            void set_buffer_binding    (GLenum target, GLuint buffer);
+
+            static uint32_t get_type_size  (GLenum type);
+            static uint32_t get_pixel_size (GLenum format, GLenum type);
+
+        };
+
+        extern GL_Recorder gl_recorder;
+
+        /**
+         * Funciones que sustituyen a las de OpenGL ES 2 cuando BASICS_OPENGLES_GL_RECORDER está
+         * definido. Tienen la misma firma que las originales.
+         */
+        namespace recorded
+        {
+
+            void   glActiveTexture            (GLenum texture);
+            void   glAttachShader             (GLuint program, GLuint shader);
+            void   glBindAttribLocation       (GLuint program, GLuint index, const GLchar * name);
+            void   glBindBuffer               (GLenum target, GLuint buffer);
+            void   glBindTexture              (GLenum target, GLuint texture);
+            void   glBlendFunc                (GLenum source, GLenum destination);
+            void   glBufferData               (GLenum target, GLsizeiptr size, const void * data, GLenum usage);
+            void   glBufferSubData            (GLenum target, GLintptr offset, GLsizeiptr size, const void * data);
+            void   glClear                    (GLbitfield mask);
+            void   glClearColor               (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha);
+            void   glCompileShader            (GLuint shader);
+            GLuint glCreateProgram            ();
+            GLuint glCreateShader             (GLenum type);
+            void   glDeleteBuffers            (GLsizei count, const GLuint * buffers);
+            void   glDeleteProgram            (GLuint program);
+            void   glDeleteShader             (GLuint shader);
+            void   glDeleteTextures           (GLsizei count, const GLuint * textures);
+            void   glDisable                  (GLenum capability);
+            void   glDisableVertexAttribArray (GLuint index);
+            void   glDrawArrays               (GLenum mode, GLint first, GLsizei count);
+            void   glDrawElements             (GLenum mode, GLsizei count, GLenum type, const void * indices);
+            void   glEnable                   (GLenum capability);
+            void   glEnableVertexAttribArray  (GLuint index);
+            void   glGenBuffers               (GLsizei count, GLuint * buffers);
+            void   glGenTextures              (GLsizei count, GLuint * textures);
+            GLint  glGetAttribLocation        (GLuint program, const GLchar * name);
+            GLenum glGetError                 ();
+            void   glGetProgramInfoLog        (GLuint program, GLsizei size, GLsizei * length, GLchar * log);
+            void   glGetProgramiv             (GLuint program, GLenum name, GLint * value);
+            void   glGetShaderInfoLog         (GLuint shader,  GLsizei size, GLsizei * length, GLchar * log);
+            void   glGetShaderiv              (GLuint shader,  GLenum name, GLint * value);
+            GLint  glGetUniformLocation       (GLuint program, const GLchar * name);
+            void   glLinkProgram              (GLuint program);
+            void   glShaderSource             (GLuint shader, GLsizei count, const GLchar * const * strings, const GLint * lengths);
+            void   glTexImage2D               (GLenum target, GLint level, GLint internal_format, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void * pixels);
+            void   glTexParameteri            (GLenum target, GLenum name, GLint value);
+            void   glTexSubImage2D            (GLenum target, GLint level, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, const void * pixels);
+            void   glUniform1f                (GLint location, GLfloat x);
+            void   glUniform1i                (GLint location, GLint   x);
+            void   glUniform2f                (GLint location, GLfloat x, GLfloat y);
+            void   glUniform3f                (GLint location, GLfloat x, GLfloat y, GLfloat z);
+            void   glUniform4f                (GLint location, GLfloat x, GLfloat y, GLfloat z, GLfloat w);
+            void   glUniformMatrix2fv         (GLint location, GLsizei count, GLboolean transpose, const GLfloat * values);
+            void   glUniformMatrix3fv         (GLint location, GLsizei count, GLboolean transpose, const GLfloat * values);
+            void   glUniformMatrix4fv         (GLint location, GLsizei count, GLboolean transpose, const GLfloat * values);
+            void   glUseProgram               (GLuint program);
+            void   glVertexAttrib1f           (GLuint index, GLfloat x);
+            void   glVertexAttrib2fv          (GLuint index, const GLfloat * values);
+            void   glVertexAttrib3fv          (GLuint index, const GLfloat * values);
+            void   glVertexAttrib4fv          (GLuint index, const GLfloat * values);
+            void   glVertexAttribPointer      (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void * pointer);
+            void   glViewport                 (GLint x, GLint y, GLsizei width, GLsizei height);
+
+        }
+
+    }}
+
+    // La redirección no se aplica en GL_Recorder.cpp, que tiene que llamar a las originales:
+
+    #if defined(BASICS_OPENGLES_GL_RECORDER) && !defined(BASICS_OPENGLES_GL_RECORDER_IMPLEMENTATION)
+
+        #define glActiveTexture             ::basics::opengles::recorded::glActiveTexture
+        #define glAttachShader              ::basics::opengles::recorded::glAttachShader
+        #define glBindAttribLocation        ::basics::opengles::recorded::glBindAttribLocation
+        #define glBindBuffer                ::basics::opengles::recorded::glBindBuffer
+        #define glBindTexture               ::basics::opengles::recorded::glBindTexture
+        #define glBlendFunc                 ::basics::opengles::recorded::glBlendFunc
+        #define glBufferData                ::basics::opengles::recorded::glBufferData
+        #define glBufferSubData             ::basics::opengles::recorded::glBufferSubData
+        #define glClear                     ::basics::opengles::recorded::glClear
+        #define glClearColor                ::basics::opengles::recorded::glClearColor
+        #define glCompileShader             ::basics::opengles::recorded::glCompileShader
+        #define glCreateProgram             ::basics::opengles::recorded::glCreateProgram
+        #define glCreateShader              ::basics::opengles::recorded::glCreateShader
+        #define glDeleteBuffers             ::basics::opengles::recorded::glDeleteBuffers
+        #define glDeleteProgram             ::basics::opengles::recorded::glDeleteProgram
+        #define glDeleteShader              ::basics::opengles::recorded::glDeleteShader
+        #define glDeleteTextures            ::basics::opengles::recorded::glDeleteTextures
+        #define glDisable                   ::basics::opengles::recorded::glDisable
+        #define glDisableVertexAttribArray  ::basics::opengles::recorded::glDisableVertexAttribArray
+        #define glDrawArrays                ::basics::opengles::recorded::glDrawArrays
+        #define glDrawElements              ::basics::opengles::recorded::glDrawElements
+        #define glEnable                    ::basics::opengles::recorded::glEnable
+        #define glEnableVertexAttribArray   ::basics::opengles::recorded::glEnableVertexAttribArray
+        #define glGenBuffers                ::basics::opengles::recorded::glGenBuffers
+        #define glGenTextures               ::basics::opengles::recorded::glGenTextures
+        #define glGetAttribLocation         ::basics::opengles::recorded::glGetAttribLocation
+        #define glGetError                  ::basics::opengles::recorded::glGetError
+        #define glGetProgramInfoLog         ::basics::opengles::recorded::glGetProgramInfoLog
+        #define glGetProgramiv              ::basics::opengles::recorded::glGetProgramiv
+        #define glGetShaderInfoLog          ::basics::opengles::recorded::glGetShaderInfoLog
+        #define glGetShaderiv               ::basics::opengles::recorded::glGetShaderiv
+        #define glGetUniformLocation        ::basics::opengles::recorded::glGetUniformLocation
+        #define glLinkProgram               ::basics::opengles::recorded::glLinkProgram
+        #define glShaderSource              ::basics::opengles::recorded::glShaderSource
+        #define glTexImage2D                ::basics::opengles::recorded::glTexImage2D
+        #define glTexParameteri             ::basics::opengles::recorded::glTexParameteri
+        #define glTexSubImage2D             ::basics::opengles::recorded::glTexSubImage2D
+        #define glUniform1f                 ::basics::opengles::recorded::glUniform1f
+        #define glUniform1i                 ::basics::opengles::recorded::glUniform1i
+        #define glUniform2f                 ::basics::opengles::recorded::glUniform2f
+        #define glUniform3f                 ::basics::opengles::recorded::glUniform3f
+        #define glUniform4f                 ::basics::opengles::recorded::glUniform4f
+        #define glUniformMatrix2fv          ::basics::opengles::recorded::glUniformMatrix2fv
+        #define glUniformMatrix3fv          ::basics::opengles::recorded::glUniformMatrix3fv
+        #define glUniformMatrix4fv          ::basics::opengles::recorded::glUniformMatrix4fv
+        #define glUseProgram                ::basics::opengles::recorded::glUseProgram
+        #define glVertexAttrib1f            ::basics::opengles::recorded::glVertexAttrib1f
+        #define glVertexAttrib2fv           ::basics::opengles::recorded::glVertexAttrib2fv
+        #define glVertexAttrib3fv           ::basics::opengles::recorded::glVertexAttrib3fv
+        #define glVertexAttrib4fv           ::basics::opengles::recorded::glVertexAttrib4fv
+        #define glVertexAttribPointer       ::basics::opengles::recorded::glVertexAttribPointer
+        #define glViewport                  ::basics::opengles::recorded::glViewport
+
+    #endif
+
+#endif
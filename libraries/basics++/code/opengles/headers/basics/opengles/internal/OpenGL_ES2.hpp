@@ -16,6 +16,10 @@
     #include <GLES2/gl2.h>
     #include <GLES2/gl2ext.h>
 
+    #if defined(BASICS_OPENGLES_GL_RECORDER) || defined(BASICS_OPENGLES_GL_STUB)
+        #include <basics/opengles/GL_Recorder>
+    #endif
+
     namespace basics
     {
         class OpenGL_ES2;
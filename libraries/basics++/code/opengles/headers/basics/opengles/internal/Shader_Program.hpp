@@ -19,6 +19,7 @@
     #include <basics/Matrix>
     #include <basics/Point>
     #include <basics/Vector>
+    #include <basics/Render_Statistics>
     #include <basics/opengles/Shader>
 
     namespace basics { namespace opengles
@@ -113,6 +114,8 @@
                     glUseProgram (program_object_id);
 
                     active_shader_program = this;
+
+                    ++render_statistics.state_changes;
                 }
             }
 
@@ -15,6 +15,7 @@
 
     #include <basics/Color_Buffer>
     #include <basics/Graphics_Resource>
+    #include <basics/Memory_Tracker>
     #include <basics/opengles/OpenGL_ES2>
     #include <basics/Texture_2D>
 
@@ -54,6 +55,7 @@
                 basics::Texture_2D(width, height),
                 color_buffer      (color_buffer )
             {
+                memory_tracker.add (Memory_Tracker::TEXTURES_CPU, get_color_buffer_bytes ());
             }
 
             Texture_2D(const Texture_2D & ) = delete;
@@ -63,19 +65,15 @@
                 if (active_texture == this) active_texture = nullptr;
 
                 finalize ();
+
+                memory_tracker.remove (Memory_Tracker::TEXTURES_CPU, get_color_buffer_bytes ());
             }
 
         public:
 
             bool initialize () override;
 
-            void finalize () override
-            {
-                if (initialized)
-                {
-                    glDeleteTextures (1, &texture_object_id);
-                }
-            }
+            void finalize () override;
 
         public:
 
@@ -88,6 +86,13 @@
 
             bool use () const;
 
+        private:
+
+            int64_t get_color_buffer_bytes () const
+            {
+                return int64_t(color_buffer.buffer.capacity ()) * int64_t(sizeof(Rgba8888));
+            }
+
         };
 
     }}
@@ -10,6 +10,10 @@
  * C1801091703
  */
 
+#include <basics/Affine2>
+#include <basics/Object_Pool>
+#include <basics/Render_Statistics>
+#include <basics/Startup_Timeline>
 #include <basics/Transformation>
 #include <basics/opengles/OpenGL_ES2>
 #include <basics/opengles/Canvas_ES2>
@@ -24,24 +28,22 @@ namespace basics { namespace opengles
     const char * Canvas_ES2::internal_vertex_shader_f =
         "precision mediump float;"
         "uniform   mat3 transform;"
-        "uniform   mat3 projection;"
         "attribute vec2 vertex_position;"
         "void main()"
         "{"
-            "gl_Position = vec4((vec3(vertex_position, 1.0) * transform * projection).xy, 0.0, 1.0);"
+            "gl_Position = vec4((vec3(vertex_position, 1.0) * transform).xy, 0.0, 1.0);"
         "}";
 
     const char * Canvas_ES2::internal_vertex_shader_t =
         "precision mediump float;"
         "uniform   mat3 transform;"
-        "uniform   mat3 projection;"
         "attribute vec2 vertex_position;"
         "attribute vec2 vertex_texture_uv;"
         "varying   vec2 varying_uv;"
         "void main()"
         "{"
             "varying_uv  = vertex_texture_uv;"
-            "gl_Position = vec4((vec3(vertex_position, 1.0) * transform * projection).xy, 0.0, 1.0);"
+            "gl_Position = vec4((vec3(vertex_position, 1.0) * transform).xy, 0.0, 1.0);"
         "}";
 
     const char * Canvas_ES2::internal_fragment_shader_f =
@@ -64,6 +66,35 @@ namespace basics { namespace opengles
             "gl_FragColor = vec4(texel.rgb, texel.a * opacity);"
         "}";
 
+    // Los quads de los lotes llevan un color por vértice que tiñe el texel:
+
+    const char * Canvas_ES2::internal_vertex_shader_b =
+        "precision mediump float;"
+        "uniform   mat3 transform;"
+        "attribute vec2 vertex_position;"
+        "attribute vec2 vertex_texture_uv;"
+        "attribute vec4 vertex_color;"
+        "varying   vec2 varying_uv;"
+        "varying   vec4 varying_color;"
+        "void main()"
+        "{"
+            "varying_uv    = vertex_texture_uv;"
+            "varying_color = vertex_color;"
+            "gl_Position   = vec4((vec3(vertex_position, 1.0) * transform).xy, 0.0, 1.0);"
+        "}";
+
+    const char * Canvas_ES2::internal_fragment_shader_b =
+        "precision mediump   float;"
+        "uniform   sampler2D sampler;"
+        "uniform   float     opacity;"
+        "varying   vec2      varying_uv;"
+        "varying   vec4      varying_color;"
+        "void main()"
+        "{"
+            "vec4 texel   = texture2D (sampler, varying_uv) * varying_color;"
+            "gl_FragColor = vec4(texel.rgb, texel.a * opacity);"
+        "}";
+
     static const Point2f normal_texture_uvs[] =
     {
         { 0.f, 1.f },
@@ -109,7 +140,11 @@ namespace basics { namespace opengles
     :
         size{ float(size.width), float(size.height) }
     {
-        shader_program_f.reset (new Shader_Program);
+        // Compilar y enlazar los tres programas es uno de los pasos más lentos de un arranque en frío:
+
+        startup_timeline.mark ("canvas shaders compiling");
+
+        shader_program_f = make_pooled< Shader_Program > ();
 
         shader_program_f->add (Shader::Source_Code::from_string (internal_vertex_shader_f,   Shader::Source_Code::VERTEX  ));
         shader_program_f->add (Shader::Source_Code::from_string (internal_fragment_shader_f, Shader::Source_Code::FRAGMENT));
@@ -121,12 +156,11 @@ namespace basics { namespace opengles
             shader_program_f->use ();
 
              transform_f_id = shader_program_f->get_uniform_id ("transform" );
-            projection_f_id = shader_program_f->get_uniform_id ("projection");
                  color_f_id = shader_program_f->get_uniform_id ("color"     );
                opacity_f_id = shader_program_f->get_uniform_id ("opacity"   );
         }
 
-        shader_program_t.reset (new Shader_Program);
+        shader_program_t = make_pooled< Shader_Program > ();
 
         shader_program_t->add (Shader::Source_Code::from_string (internal_vertex_shader_t,   Shader::Source_Code::VERTEX  ));
         shader_program_t->add (Shader::Source_Code::from_string (internal_fragment_shader_t, Shader::Source_Code::FRAGMENT));
@@ -138,7 +172,6 @@ namespace basics { namespace opengles
             shader_program_t->use ();
 
              transform_t_id = shader_program_t->get_uniform_id ("transform" );
-            projection_t_id = shader_program_t->get_uniform_id ("projection");
                sampler_t_id = shader_program_t->get_uniform_id ("sampler"   );
                opacity_t_id = shader_program_t->get_uniform_id ("opacity"   );
 
@@ -148,6 +181,30 @@ namespace basics { namespace opengles
             shader_program_t->set_uniform_value (sampler_t_id, 0);
         }
 
+        shader_program_b = make_pooled< Shader_Program > ();
+
+        shader_program_b->add (Shader::Source_Code::from_string (internal_vertex_shader_b,   Shader::Source_Code::VERTEX  ));
+        shader_program_b->add (Shader::Source_Code::from_string (internal_fragment_shader_b, Shader::Source_Code::FRAGMENT));
+
+        context->add (shader_program_b);
+
+        if (shader_program_b->is_usable ())
+        {
+            shader_program_b->use ();
+
+             transform_b_id = shader_program_b->get_uniform_id ("transform" );
+               sampler_b_id = shader_program_b->get_uniform_id ("sampler"   );
+               opacity_b_id = shader_program_b->get_uniform_id ("opacity"   );
+
+              vertex_position_location_b = shader_program_b->get_vertex_attribute_id ("vertex_position"  );
+            vertex_texture_uv_location_b = shader_program_b->get_vertex_attribute_id ("vertex_texture_uv");
+                vertex_color_location_b = shader_program_b->get_vertex_attribute_id ("vertex_color"     );
+
+            shader_program_b->set_uniform_value (sampler_b_id, 0);
+        }
+
+        startup_timeline.mark ("canvas shaders compiled");
+
         reset_state ();
     }
 
@@ -157,6 +214,8 @@ namespace basics { namespace opengles
         glBlendFunc   (GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
         glClearColor  (0.f, 0.f, 0.f, 1.f);
 
+        render_statistics.state_changes += 2;
+
         set_size      ({ unsigned(size.width), unsigned(size.height) });
         set_transform (Transformation2f());
         set_color     (1.f, 1.f, 1.f);
@@ -168,13 +227,9 @@ namespace basics { namespace opengles
         size.width  = float(new_viewport_size.width );
         size.height = float(new_viewport_size.height);
         half_size   = size * 0.5f;
-        projection  = translate_then_scale_2d (Vector2f{ -half_size.width, -half_size.height }, 2.f / size.width, 2.f / size.height);
-
-        shader_program_f->use ();
-        shader_program_f->set_uniform_value (projection_f_id, projection.matrix);
+        projection  = Affine2f::translation_then_scaling (-half_size.width, -half_size.height, 2.f / size.width, 2.f / size.height);
 
-        shader_program_t->use ();
-        shader_program_t->set_uniform_value (projection_t_id, projection.matrix);
+        upload_transform ();
     }
 
     void Canvas_ES2::set_clear_color (float r, float g, float b)
@@ -188,6 +243,8 @@ namespace basics { namespace opengles
         shader_program_f->set_uniform_value (opacity_f_id, opacity);
         shader_program_t->use ();
         shader_program_t->set_uniform_value (opacity_t_id, opacity);
+        shader_program_b->use ();
+        shader_program_b->set_uniform_value (opacity_b_id, opacity);
     }
 
     void Canvas_ES2::set_color (float r, float g, float b)
@@ -198,24 +255,33 @@ namespace basics { namespace opengles
 
     void Canvas_ES2::set_transform (const Transformation2f & new_transform)
     {
-        transform = new_transform;
-
-        shader_program_f->use ();
-        shader_program_f->set_uniform_value (transform_f_id, transform.matrix);
+        transform = Affine2f(new_transform);
 
-        shader_program_t->use ();
-        shader_program_t->set_uniform_value (transform_t_id, transform.matrix);
+        upload_transform ();
     }
 
     void Canvas_ES2::apply_transform (const Transformation2f & t)
     {
-        transform = t * transform;
+        transform = Affine2f(t) * transform;
+
+        upload_transform ();
+    }
+
+    void Canvas_ES2::upload_transform ()
+    {
+        // La proyección se compone con la transformación una sola vez en la CPU para que los vertex
+        // shaders solo tengan que aplicar una matriz a cada vértice:
+
+        Matrix33f matrix = (projection * transform).to_transformation ().matrix;
 
         shader_program_f->use ();
-        shader_program_f->set_uniform_value (transform_f_id, transform.matrix);
+        shader_program_f->set_uniform_value (transform_f_id, matrix);
 
         shader_program_t->use ();
-        shader_program_t->set_uniform_value (transform_t_id, transform.matrix);
+        shader_program_t->set_uniform_value (transform_t_id, matrix);
+
+        shader_program_b->use ();
+        shader_program_b->set_uniform_value (transform_b_id, matrix);
     }
 
     void Canvas_ES2::clear ()
@@ -231,6 +297,8 @@ namespace basics { namespace opengles
         glDisableVertexAttribArray (1);
         glVertexAttribPointer      (0, 2, GL_FLOAT, GL_FALSE, 0, position.coordinates);
         glDrawArrays               (GL_POINTS, 0, 1);
+
+        ++render_statistics.draw_calls;
     }
 
     void Canvas_ES2::draw_segment (const Point2f & a, const Point2f & b)
@@ -243,6 +311,8 @@ namespace basics { namespace opengles
         glDisableVertexAttribArray (1);
         glVertexAttribPointer      (0, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
         glDrawArrays               (GL_LINES, 0, 2);
+
+        ++render_statistics.draw_calls;
     }
 
     void Canvas_ES2::draw_triangle (const Point2f & a, const Point2f & b, const Point2f & c)
@@ -255,6 +325,8 @@ namespace basics { namespace opengles
         glDisableVertexAttribArray (1);
         glVertexAttribPointer      (0, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
         glDrawArrays               (GL_LINE_STRIP, 0, 4);
+
+        ++render_statistics.draw_calls;
     }
 
     void Canvas_ES2::fill_triangle (const Point2f & a, const Point2f & b, const Point2f & c)
@@ -267,6 +339,8 @@ namespace basics { namespace opengles
         glDisableVertexAttribArray (1);
         glVertexAttribPointer      (0, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
         glDrawArrays               (GL_TRIANGLES, 0, 3);
+
+        ++render_statistics.draw_calls;
     }
 
     void Canvas_ES2::draw_rectangle (const Point2f & bottom_left, const Size2f & size)
@@ -288,6 +362,8 @@ namespace basics { namespace opengles
         glDisableVertexAttribArray (1);
         glVertexAttribPointer      (0, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
         glDrawArrays               (GL_LINE_STRIP, 0, 5);
+
+        ++render_statistics.draw_calls;
     }
 
     void Canvas_ES2::fill_rectangle (const Point2f & bottom_left, const Size2f & size)
@@ -308,6 +384,8 @@ namespace basics { namespace opengles
         glDisableVertexAttribArray (1);
         glVertexAttribPointer      (0, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
         glDrawArrays               (GL_TRIANGLE_STRIP, 0, 4);
+
+        ++render_statistics.draw_calls;
     }
 
     void Canvas_ES2::fill_rectangle (const Point2f & where, const Size2f & size, const basics::Texture_2D * texture, int handling)
@@ -364,6 +442,8 @@ namespace basics { namespace opengles
             glVertexAttribPointer     (  vertex_position_location_t, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
             glVertexAttribPointer     (vertex_texture_uv_location_t, 2, GL_FLOAT, GL_FALSE, 0, texture_uvs);
             glDrawArrays              (GL_TRIANGLE_STRIP, 0, 4);
+
+            ++render_statistics.draw_calls;
         }
     }
 
@@ -378,12 +458,12 @@ namespace basics { namespace opengles
 
         if (opengl_es_texture)
         {
-            float   horizontal_ratio  = 1.f / opengl_es_texture->get_width  ();
-            float     vertical_ratio  = 1.f / opengl_es_texture->get_height ();
-            float   normalized_left   = slice->left   * horizontal_ratio;
-            float   normalized_right  = slice->right  * horizontal_ratio;
-            float   normalized_top    = slice->top    *   vertical_ratio;
-            float   normalized_bottom = slice->bottom *   vertical_ratio;
+            // Las coordenadas normalizadas ya vienen calculadas desde el atlas:
+
+            float   normalized_left   = slice->u_left;
+            float   normalized_right  = slice->u_right;
+            float   normalized_top    = slice->v_top;
+            float   normalized_bottom = slice->v_bottom;
 
             Point2f bottom_left;
             Point2f texture_uvs[] =
@@ -442,6 +522,108 @@ namespace basics { namespace opengles
             glVertexAttribPointer     (  vertex_position_location_t, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
             glVertexAttribPointer     (vertex_texture_uv_location_t, 2, GL_FLOAT, GL_FALSE, 0, texture_uvs);
             glDrawArrays              (GL_TRIANGLE_STRIP, 0, 4);
+
+            ++render_statistics.draw_calls;
+        }
+    }
+
+    void Canvas_ES2::fill_rectangles
+    (
+        const float        * lefts,
+        const float        * bottoms,
+        const float        * widths,
+        const float        * heights,
+        size_t               count
+    )
+    {
+        if (count == 0) return;
+
+        flat_batch.resize (count * 6);
+
+        Point2f * vertex = flat_batch.data ();
+
+        for (size_t index = 0; index < count; ++index, vertex += 6)
+        {
+            float left   = lefts  [index], right = left   + widths [index];
+            float bottom = bottoms[index], top   = bottom + heights[index];
+
+            vertex[0] = { left,  bottom };
+            vertex[1] = { left,  top    };
+            vertex[2] = { right, bottom };
+            vertex[3] = { right, bottom };
+            vertex[4] = { left,  top    };
+            vertex[5] = { right, top    };
+        }
+
+        shader_program_f->use ();
+
+        glEnableVertexAttribArray  (0);
+        glDisableVertexAttribArray (1);
+        glVertexAttribPointer      (0, 2, GL_FLOAT, GL_FALSE, 0, flat_batch.data ());
+        glDrawArrays               (GL_TRIANGLES, 0, GLsizei(count * 6));
+
+        ++render_statistics.draw_calls;
+    }
+
+    void Canvas_ES2::fill_rectangles
+    (
+        const Atlas::Slice * slice,
+        const float        * xs,
+        const float        * ys,
+        const float        * sizes,
+        const uint32_t     * colors,
+        size_t               count
+    )
+    {
+        if (!slice || !slice->atlas || count == 0)
+        {
+            return;
+        }
+
+        const opengles::Texture_2D * opengl_es_texture = dynamic_cast< const opengles::Texture_2D * >(slice->atlas->get_texture ().get ());
+
+        if (opengl_es_texture)
+        {
+            // Se escriben dos triángulos por quad en un único array de vértices para poder enviar
+            // todo el lote con una sola llamada de dibujado:
+
+            batch.resize (count * 6);
+
+            Batch_Vertex * vertex = batch.data ();
+
+            const float u0 = slice->u_left,   u1 = slice->u_right;
+            const float v0 = slice->v_bottom, v1 = slice->v_top;
+
+            for (size_t index = 0; index < count; ++index, vertex += 6)
+            {
+                float    half   = sizes[index] * 0.5f;
+                float    left   = xs[index] - half, right = xs[index] + half;
+                float    bottom = ys[index] - half, top   = ys[index] + half;
+                uint32_t color  = colors ? colors[index] : 0xFFFFFFFF;
+
+                vertex[0] = { left,  bottom, u0, v1, color };
+                vertex[1] = { left,  top,    u0, v0, color };
+                vertex[2] = { right, bottom, u1, v1, color };
+                vertex[3] = { right, bottom, u1, v1, color };
+                vertex[4] = { left,  top,    u0, v0, color };
+                vertex[5] = { right, top,    u1, v0, color };
+            }
+
+            opengl_es_texture->use ();
+            shader_program_b ->use ();
+
+            const char * base = reinterpret_cast< const char * >(batch.data ());
+
+            glEnableVertexAttribArray  (  vertex_position_location_b);
+            glEnableVertexAttribArray  (vertex_texture_uv_location_b);
+            glEnableVertexAttribArray  (    vertex_color_location_b);
+            glVertexAttribPointer      (  vertex_position_location_b, 2, GL_FLOAT,         GL_FALSE, sizeof(Batch_Vertex), base);
+            glVertexAttribPointer      (vertex_texture_uv_location_b, 2, GL_FLOAT,         GL_FALSE, sizeof(Batch_Vertex), base + 2 * sizeof(float));
+            glVertexAttribPointer      (    vertex_color_location_b, 4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(Batch_Vertex), base + 4 * sizeof(float));
+            glDrawArrays               (GL_TRIANGLES, 0, GLsizei(count * 6));
+            glDisableVertexAttribArray (    vertex_color_location_b);
+
+            ++render_statistics.draw_calls;
         }
     }
 
@@ -0,0 +1,713 @@
+/*
+ * GL RECORDER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version 1.0
+ * See the LICENSE file or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802181020
+ */
+
+// Aquí no se deben redirigir las funciones de OpenGL porque hay que llamar a las originales:
+
+#define BASICS_OPENGLES_GL_RECORDER_IMPLEMENTATION
+
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <basics/opengles/GL_Recorder>
+
+namespace basics { namespace opengles
+{
+
+    constexpr unsigned GL_Recorder::max_arguments;
+    constexpr unsigned GL_Recorder::max_attributes;
+
+    GL_Recorder gl_recorder;
+
+    GL_Recorder::GL_Recorder()
+    :
+        recording_calls     (true),
+        array_buffer        (0),
+        element_array_buffer(0)
+    {
+        std::memset (attributes, 0, sizeof(attributes));
+
+        reset ();
+    }
+
+    void GL_Recorder::begin_frame ()
+    {
+        total_counts.calls           += frame_counts.calls;
+        total_counts.draw_calls      += frame_counts.draw_calls;
+        total_counts.vertices        += frame_counts.vertices;
+        total_counts.binds           += frame_counts.binds;
+        total_counts.uniform_uploads += frame_counts.uniform_uploads;
+        total_counts.buffer_uploads  += frame_counts.buffer_uploads;
+        total_counts.state_changes   += frame_counts.state_changes;
+        total_counts.bytes_uploaded  += frame_counts.bytes_uploaded;
+
+        last_frame_counts = frame_counts;
+        frame_counts      = Counts();
+
+        calls.clear ();
+
+        ++frame_number;
+    }
+
+    void GL_Recorder::reset ()
+    {
+        calls.clear ();
+
+        frame_counts      = Counts();
+        last_frame_counts = Counts();
+        total_counts      = Counts();
+        frame_number      = 0;
+    }
+
+    size_t GL_Recorder::count (const char * name) const
+    {
+        size_t result = 0;
+
+        for (auto & call : calls)
+        {
+            if (std::strcmp (call.name, name) == 0) ++result;
+        }
+
+        return result;
+    }
+
+    void GL_Recorder::write (std::ostream & output) const
+    {
+        output
+            << "frame "            << frame_number
+            << ": "                << frame_counts.calls
+            << " calls, "          << frame_counts.draw_calls
+            << " draws, "          << frame_counts.vertices
+            << " vertices, "       << frame_counts.binds
+            << " binds, "          << frame_counts.uniform_uploads
+            << " uniforms, "       << frame_counts.buffer_uploads
+            << " uploads ("        << frame_counts.bytes_uploaded
+            << " bytes), "         << frame_counts.state_changes
+            << " state changes\n";
+
+        for (auto & call : calls)
+        {
+            output << call.name << " (";
+
+            for (unsigned i = 0; i < call.argument_count; ++i)
+            {
+                double argument = call.arguments[i];
+
+                if (i > 0) output << ", ";
+
+                // Los enteros (incluidas las direcciones) se escriben sin notación científica:
+
+                if (argument == std::floor (argument) && std::fabs (argument) < 9007199254740992.0)
+                {
+                    output << int64_t(argument);
+                }
+                else
+                    output << argument;
+            }
+
+            output << ')';
+
+            if (!call.text.empty ()) output << " \"" << call.text << '"';
+
+            output << '\n';
+        }
+    }
+
+    void GL_Recorder::record (const char * name, Category category, std::initializer_list< double > arguments, const char * text)
+    {
+        ++frame_counts.calls;
+
+        switch (category)
+        {
+            case DRAW:    ++frame_counts.draw_calls;      break;
+            case BIND:    ++frame_counts.binds;           break;
+            case UNIFORM: ++frame_counts.uniform_uploads; break;
+            case STATE:   ++frame_counts.state_changes;   break;
+            default:                                      break;
+        }
+
+        if (recording_calls)
+        {
+            calls.emplace_back ();
+
+            Call & call = calls.back ();
+
+            call.name           = name;
+            call.category       = category;
+            call.argument_count = 0;
+
+            for (double argument : arguments)
+            {
+                if (call.argument_count < max_arguments) call.arguments[call.argument_count++] = argument;
+            }
+
+            if (text) call.text = text;
+        }
+    }
+
+    void GL_Recorder::record_upload (uint64_t bytes)
+    {
+        if (bytes > 0)
+        {
+            ++frame_counts.buffer_uploads;
+            frame_counts.bytes_uploaded += bytes;
+        }
+    }
+
+    void GL_Recorder::record_draw (GLsizei count)
+    {
+        if (count <= 0) return;
+
+        frame_counts.vertices += uint32_t(count);
+
+        // Los arrays de vértices que están en memoria del cliente se copian en cada draw:
+
+        uint64_t bytes = 0;
+
+        for (auto & attribute : attributes)
+        {
+            if (attribute.enabled && attribute.client_memory)
+            {
+                bytes += uint64_t(attribute.stride) * uint64_t(count - 1) + attribute.element_size;
+            }
+        }
+
+        record_upload (bytes);
+    }
+
+    void GL_Recorder::record_indexed_draw (GLsizei count, GLenum type)
+    {
+        // Solo se pueden contar los bytes de los índices porque no se sabe qué rango de vértices
+        // usan sin recorrerlos:
+
+        if (count <= 0) return;
+
+        frame_counts.vertices += uint32_t(count);
+
+        if (element_array_buffer == 0) record_upload (uint64_t(count) * get_type_size (type));
+    }
+
+    void GL_Recorder::set_attribute_pointer (GLuint index, GLint size, GLenum type, GLsizei stride)
+    {
+        if (index < max_attributes)
+        {
+            Attribute & attribute = attributes[index];
+
+            attribute.client_memory = array_buffer == 0;
+            attribute.element_size  = uint32_t(size) * get_type_size (type);
+            attribute.stride        = stride > 0 ? uint32_t(stride) : attribute.element_size;
+        }
+    }
+
+    void GL_Recorder::set_attribute_enabled (GLuint index, bool status)
+    {
+        if (index < max_attributes) attributes[index].enabled = status;
+    }
+
+    void GL_Recorder::set_buffer_binding (GLenum target, GLuint buffer)
+    {
+        if (target == GL_ARRAY_BUFFER        ) array_buffer         = buffer; else
+        if (target == GL_ELEMENT_ARRAY_BUFFER) element_array_buffer = buffer;
+    }
+
+    uint32_t GL_Recorder::get_type_size (GLenum type)
+    {
+        switch (type)
+        {
+            case GL_BYTE:
+            case GL_UNSIGNED_BYTE:  return 1;
+            case GL_SHORT:
+            case GL_UNSIGNED_SHORT: return 2;
+            default:                return 4;
+        }
+    }
+
+    uint32_t GL_Recorder::get_pixel_size (GLenum format, GLenum type)
+    {
+        switch (type)
+        {
+            case GL_UNSIGNED_SHORT_5_6_5:
+            case GL_UNSIGNED_SHORT_4_4_4_4:
+            case GL_UNSIGNED_SHORT_5_5_5_1: return 2;
+        }
+
+        switch (format)
+        {
+            case GL_ALPHA:
+            case GL_LUMINANCE:              return 1;
+            case GL_LUMINANCE_ALPHA:        return 2;
+            case GL_RGB:                    return 3;
+            default:                        return 4;
+        }
+    }
+
+}}
+
+#if defined(BASICS_OPENGLES_GL_RECORDER)
+
+    // Con el stub no se llama al driver:
+
+    #if defined(BASICS_OPENGLES_GL_STUB)
+        #define BASICS_GL_FORWARD(CALL)
+    #else
+        #define BASICS_GL_FORWARD(CALL) CALL
+    #endif
+
+    namespace basics { namespace opengles
+    {
+
+        namespace
+        {
+
+            inline double address (const void * pointer)
+            {
+                return double(uintptr_t(pointer));
+            }
+
+            #if defined(BASICS_OPENGLES_GL_STUB)
+
+                // Estado mínimo para que el código que usa OpenGL funcione igual que con un driver:
+                // los nombres de los objetos son distintos de 0 y las posiciones de los uniforms y
+                // de los atributos son estables para cada programa.
+
+                struct Stub
+                {
+                    GLuint last_name = 0;
+
+                    std::map< std::pair< GLuint, std::string >, GLint > uniform_locations;
+                    std::map< std::pair< GLuint, std::string >, GLint > attribute_locations;
+
+                    GLuint generate_name ()
+                    {
+                        return ++last_name;
+                    }
+
+                    static GLint get_location (std::map< std::pair< GLuint, std::string >, GLint > & locations, GLuint program, const GLchar * name)
+                    {
+                        auto inserted = locations.insert ({ { program, name }, GLint(locations.size ()) });
+
+                        return inserted.first->second;
+                    }
+                }
+                stub;
+
+            #endif
+
+        }
+
+        namespace recorded
+        {
+
+            void glActiveTexture (GLenum texture)
+            {
+                gl_recorder.record ("glActiveTexture", GL_Recorder::STATE, { double(texture) });
+                BASICS_GL_FORWARD(::glActiveTexture (texture));
+            }
+
+            void glAttachShader (GLuint program, GLuint shader)
+            {
+                gl_recorder.record ("glAttachShader", GL_Recorder::RESOURCE, { double(program), double(shader) });
+                BASICS_GL_FORWARD(::glAttachShader (program, shader));
+            }
+
+            void glBindAttribLocation (GLuint program, GLuint index, const GLchar * name)
+            {
+                gl_recorder.record ("glBindAttribLocation", GL_Recorder::RESOURCE, { double(program), double(index), address (name) }, name);
+                BASICS_GL_FORWARD(::glBindAttribLocation (program, index, name));
+            }
+
+            void glBindBuffer (GLenum target, GLuint buffer)
+            {
+                gl_recorder.record ("glBindBuffer", GL_Recorder::BIND, { double(target), double(buffer) });
+                gl_recorder.set_buffer_binding (target, buffer);
+                BASICS_GL_FORWARD(::glBindBuffer (target, buffer));
+            }
+
+            void glBindTexture (GLenum target, GLuint texture)
+            {
+                gl_recorder.record ("glBindTexture", GL_Recorder::BIND, { double(target), double(texture) });
+                BASICS_GL_FORWARD(::glBindTexture (target, texture));
+            }
+
+            void glBlendFunc (GLenum source, GLenum destination)
+            {
+                gl_recorder.record ("glBlendFunc", GL_Recorder::STATE, { double(source), double(destination) });
+                BASICS_GL_FORWARD(::glBlendFunc (source, destination));
+            }
+
+            void glBufferData (GLenum target, GLsizeiptr size, const void * data, GLenum usage)
+            {
+                gl_recorder.record ("glBufferData", GL_Recorder::UPLOAD, { double(target), double(size), address (data), double(usage) });
+                gl_recorder.record_upload (data ? uint64_t(size) : 0);
+                BASICS_GL_FORWARD(::glBufferData (target, size, data, usage));
+            }
+
+            void glBufferSubData (GLenum target, GLintptr offset, GLsizeiptr size, const void * data)
+            {
+                gl_recorder.record ("glBufferSubData", GL_Recorder::UPLOAD, { double(target), double(offset), double(size), address (data) });
+                gl_recorder.record_upload (uint64_t(size));
+                BASICS_GL_FORWARD(::glBufferSubData (target, offset, size, data));
+            }
+
+            void glClear (GLbitfield mask)
+            {
+                gl_recorder.record ("glClear", GL_Recorder::OTHER, { double(mask) });
+                BASICS_GL_FORWARD(::glClear (mask));
+            }
+
+            void glClearColor (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
+            {
+                gl_recorder.record ("glClearColor", GL_Recorder::STATE, { red, green, blue, alpha });
+                BASICS_GL_FORWARD(::glClearColor (red, green, blue, alpha));
+            }
+
+            void glCompileShader (GLuint shader)
+            {
+                gl_recorder.record ("glCompileShader", GL_Recorder::RESOURCE, { double(shader) });
+                BASICS_GL_FORWARD(::glCompileShader (shader));
+            }
+
+            GLuint glCreateProgram ()
+            {
+                gl_recorder.record ("glCreateProgram", GL_Recorder::RESOURCE, { });
+
+                #if defined(BASICS_OPENGLES_GL_STUB)
+                    return stub.generate_name ();
+                #else
+                    return ::glCreateProgram ();
+                #endif
+            }
+
+            GLuint glCreateShader (GLenum type)
+            {
+                gl_recorder.record ("glCreateShader", GL_Recorder::RESOURCE, { double(type) });
+
+                #if defined(BASICS_OPENGLES_GL_STUB)
+                    return stub.generate_name ();
+                #else
+                    return ::glCreateShader (type);
+                #endif
+            }
+
+            void glDeleteBuffers (GLsizei count, const GLuint * buffers)
+            {
+                gl_recorder.record ("glDeleteBuffers", GL_Recorder::RESOURCE, { double(count), address (buffers) });
+                BASICS_GL_FORWARD(::glDeleteBuffers (count, buffers));
+            }
+
+            void glDeleteProgram (GLuint program)
+            {
+                gl_recorder.record ("glDeleteProgram", GL_Recorder::RESOURCE, { double(program) });
+                BASICS_GL_FORWARD(::glDeleteProgram (program));
+            }
+
+            void glDeleteShader (GLuint shader)
+            {
+                gl_recorder.record ("glDeleteShader", GL_Recorder::RESOURCE, { double(shader) });
+                BASICS_GL_FORWARD(::glDeleteShader (shader));
+            }
+
+            void glDeleteTextures (GLsizei count, const GLuint * textures)
+            {
+                gl_recorder.record ("glDeleteTextures", GL_Recorder::RESOURCE, { double(count), address (textures) });
+                BASICS_GL_FORWARD(::glDeleteTextures (count, textures));
+            }
+
+            void glDisable (GLenum capability)
+            {
+                gl_recorder.record ("glDisable", GL_Recorder::STATE, { double(capability) });
+                BASICS_GL_FORWARD(::glDisable (capability));
+            }
+
+            void glDisableVertexAttribArray (GLuint index)
+            {
+                gl_recorder.record ("glDisableVertexAttribArray", GL_Recorder::STATE, { double(index) });
+                gl_recorder.set_attribute_enabled (index, false);
+                BASICS_GL_FORWARD(::glDisableVertexAttribArray (index));
+            }
+
+            void glDrawArrays (GLenum mode, GLint first, GLsizei count)
+            {
+                gl_recorder.record ("glDrawArrays", GL_Recorder::DRAW, { double(mode), double(first), double(count) });
+                gl_recorder.record_draw (count);
+                BASICS_GL_FORWARD(::glDrawArrays (mode, first, count));
+            }
+
+            void glDrawElements (GLenum mode, GLsizei count, GLenum type, const void * indices)
+            {
+                gl_recorder.record ("glDrawElements", GL_Recorder::DRAW, { double(mode), double(count), double(type), address (indices) });
+                gl_recorder.record_indexed_draw (count, type);
+                BASICS_GL_FORWARD(::glDrawElements (mode, count, type, indices));
+            }
+
+            void glEnable (GLenum capability)
+            {
+                gl_recorder.record ("glEnable", GL_Recorder::STATE, { double(capability) });
+                BASICS_GL_FORWARD(::glEnable (capability));
+            }
+
+            void glEnableVertexAttribArray (GLuint index)
+            {
+                gl_recorder.record ("glEnableVertexAttribArray", GL_Recorder::STATE, { double(index) });
+                gl_recorder.set_attribute_enabled (index, true);
+                BASICS_GL_FORWARD(::glEnableVertexAttribArray (index));
+            }
+
+            void glGenBuffers (GLsizei count, GLuint * buffers)
+            {
+                gl_recorder.record ("glGenBuffers", GL_Recorder::RESOURCE, { double(count), address (buffers) });
+
+                #if defined(BASICS_OPENGLES_GL_STUB)
+                    for (GLsizei i = 0; i < count; ++i) buffers[i] = stub.generate_name ();
+                #else
+                    ::glGenBuffers (count, buffers);
+                #endif
+            }
+
+            void glGenTextures (GLsizei count, GLuint * textures)
+            {
+                gl_recorder.record ("glGenTextures", GL_Recorder::RESOURCE, { double(count), address (textures) });
+
+                #if defined(BASICS_OPENGLES_GL_STUB)
+                    for (GLsizei i = 0; i < count; ++i) textures[i] = stub.generate_name ();
+                #else
+                    ::glGenTextures (count, textures);
+                #endif
+            }
+
+            GLint glGetAttribLocation (GLuint program, const GLchar * name)
+            {
+                gl_recorder.record ("glGetAttribLocation", GL_Recorder::QUERY, { double(program), address (name) }, name);
+
+                #if defined(BASICS_OPENGLES_GL_STUB)
+                    return Stub::get_location (stub.attribute_locations, program, name);
+                #else
+                    return ::glGetAttribLocation (program, name);
+                #endif
+            }
+
+            GLenum glGetError ()
+            {
+                gl_recorder.record ("glGetError", GL_Recorder::QUERY, { });
+
+                #if defined(BASICS_OPENGLES_GL_STUB)
+                    return GL_NO_ERROR;
+                #else
+                    return ::glGetError ();
+                #endif
+            }
+
+            void glGetProgramInfoLog (GLuint program, GLsizei size, GLsizei * length, GLchar * log)
+            {
+                gl_recorder.record ("glGetProgramInfoLog", GL_Recorder::QUERY, { double(program), double(size), address (length), address (log) });
+
+                #if defined(BASICS_OPENGLES_GL_STUB)
+                    if (length  ) *length = 0;
+                    if (size > 0) *log    = 0;
+                #else
+                    ::glGetProgramInfoLog (program, size, length, log);
+                #endif
+            }
+
+            void glGetProgramiv (GLuint program, GLenum name, GLint * value)
+            {
+                gl_recorder.record ("glGetProgramiv", GL_Recorder::QUERY, { double(program), double(name), address (value) });
+
+                #if defined(BASICS_OPENGLES_GL_STUB)
+                    *value = name == GL_LINK_STATUS || name == GL_VALIDATE_STATUS ? GL_TRUE : 0;
+                #else
+                    ::glGetProgramiv (program, name, value);
+                #endif
+            }
+
+            void glGetShaderInfoLog (GLuint shader, GLsizei size, GLsizei * length, GLchar * log)
+            {
+                gl_recorder.record ("glGetShaderInfoLog", GL_Recorder::QUERY, { double(shader), double(size), address (length), address (log) });
+
+                #if defined(BASICS_OPENGLES_GL_STUB)
+                    if (length  ) *length = 0;
+                    if (size > 0) *log    = 0;
+                #else
+                    ::glGetShaderInfoLog (shader, size, length, log);
+                #endif
+            }
+
+            void glGetShaderiv (GLuint shader, GLenum name, GLint * value)
+            {
+                gl_recorder.record ("glGetShaderiv", GL_Recorder::QUERY, { double(shader), double(name), address (value) });
+
+                #if defined(BASICS_OPENGLES_GL_STUB)
+                    *value = name == GL_COMPILE_STATUS ? GL_TRUE : 0;
+                #else
+                    ::glGetShaderiv (shader, name, value);
+                #endif
+            }
+
+            GLint glGetUniformLocation (GLuint program, const GLchar * name)
+            {
+                gl_recorder.record ("glGetUniformLocation", GL_Recorder::QUERY, { double(program), address (name) }, name);
+
+                #if defined(BASICS_OPENGLES_GL_STUB)
+                    return Stub::get_location (stub.uniform_locations, program, name);
+                #else
+                    return ::glGetUniformLocation (program, name);
+                #endif
+            }
+
+            void glLinkProgram (GLuint program)
+            {
+                gl_recorder.record ("glLinkProgram", GL_Recorder::RESOURCE, { double(program) });
+                BASICS_GL_FORWARD(::glLinkProgram (program));
+            }
+
+            void glShaderSource (GLuint shader, GLsizei count, const GLchar * const * strings, const GLint * lengths)
+            {
+                gl_recorder.record ("glShaderSource", GL_Recorder::RESOURCE, { double(shader), double(count), address (strings), address (lengths) });
+                BASICS_GL_FORWARD(::glShaderSource (shader, count, strings, lengths));
+            }
+
+            void glTexImage2D (GLenum target, GLint level, GLint internal_format, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void * pixels)
+            {
+                gl_recorder.record
+                (
+                    "glTexImage2D",
+                    GL_Recorder::UPLOAD,
+                    { double(target), double(level), double(internal_format), double(width), double(height), double(border), double(format), double(type), address (pixels) }
+                );
+
+                gl_recorder.record_upload (pixels ? uint64_t(width) * uint64_t(height) * GL_Recorder::get_pixel_size (format, type) : 0);
+
+                BASICS_GL_FORWARD(::glTexImage2D (target, level, internal_format, width, height, border, format, type, pixels));
+            }
+
+            void glTexParameteri (GLenum target, GLenum name, GLint value)
+            {
+                gl_recorder.record ("glTexParameteri", GL_Recorder::STATE, { double(target), double(name), double(value) });
+                BASICS_GL_FORWARD(::glTexParameteri (target, name, value));
+            }
+
+            void glTexSubImage2D (GLenum target, GLint level, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, const void * pixels)
+            {
+                gl_recorder.record
+                (
+                    "glTexSubImage2D",
+                    GL_Recorder::UPLOAD,
+                    { double(target), double(level), double(x), double(y), double(width), double(height), double(format), double(type), address (pixels) }
+                );
+
+                gl_recorder.record_upload (uint64_t(width) * uint64_t(height) * GL_Recorder::get_pixel_size (format, type));
+
+                BASICS_GL_FORWARD(::glTexSubImage2D (target, level, x, y, width, height, format, type, pixels));
+            }
+
+            void glUniform1f (GLint location, GLfloat x)
+            {
+                gl_recorder.record ("glUniform1f", GL_Recorder::UNIFORM, { double(location), x });
+                BASICS_GL_FORWARD(::glUniform1f (location, x));
+            }
+
+            void glUniform1i (GLint location, GLint x)
+            {
+                gl_recorder.record ("glUniform1i", GL_Recorder::UNIFORM, { double(location), double(x) });
+                BASICS_GL_FORWARD(::glUniform1i (location, x));
+            }
+
+            void glUniform2f (GLint location, GLfloat x, GLfloat y)
+            {
+                gl_recorder.record ("glUniform2f", GL_Recorder::UNIFORM, { double(location), x, y });
+                BASICS_GL_FORWARD(::glUniform2f (location, x, y));
+            }
+
+            void glUniform3f (GLint location, GLfloat x, GLfloat y, GLfloat z)
+            {
+                gl_recorder.record ("glUniform3f", GL_Recorder::UNIFORM, { double(location), x, y, z });
+                BASICS_GL_FORWARD(::glUniform3f (location, x, y, z));
+            }
+
+            void glUniform4f (GLint location, GLfloat x, GLfloat y, GLfloat z, GLfloat w)
+            {
+                gl_recorder.record ("glUniform4f", GL_Recorder::UNIFORM, { double(location), x, y, z, w });
+                BASICS_GL_FORWARD(::glUniform4f (location, x, y, z, w));
+            }
+
+            void glUniformMatrix2fv (GLint location, GLsizei count, GLboolean transpose, const GLfloat * values)
+            {
+                gl_recorder.record ("glUniformMatrix2fv", GL_Recorder::UNIFORM, { double(location), double(count), double(transpose), address (values) });
+                BASICS_GL_FORWARD(::glUniformMatrix2fv (location, count, transpose, values));
+            }
+
+            void glUniformMatrix3fv (GLint location, GLsizei count, GLboolean transpose, const GLfloat * values)
+            {
+                gl_recorder.record ("glUniformMatrix3fv", GL_Recorder::UNIFORM, { double(location), double(count), double(transpose), address (values) });
+                BASICS_GL_FORWARD(::glUniformMatrix3fv (location, count, transpose, values));
+            }
+
+            void glUniformMatrix4fv (GLint location, GLsizei count, GLboolean transpose, const GLfloat * values)
+            {
+                gl_recorder.record ("glUniformMatrix4fv", GL_Recorder::UNIFORM, { double(location), double(count), double(transpose), address (values) });
+                BASICS_GL_FORWARD(::glUniformMatrix4fv (location, count, transpose, values));
+            }
+
+            void glUseProgram (GLuint program)
+            {
+                gl_recorder.record ("glUseProgram", GL_Recorder::BIND, { double(program) });
+                BASICS_GL_FORWARD(::glUseProgram (program));
+            }
+
+            void glVertexAttrib1f (GLuint index, GLfloat x)
+            {
+                gl_recorder.record ("glVertexAttrib1f", GL_Recorder::STATE, { double(index), x });
+                BASICS_GL_FORWARD(::glVertexAttrib1f (index, x));
+            }
+
+            void glVertexAttrib2fv (GLuint index, const GLfloat * values)
+            {
+                gl_recorder.record ("glVertexAttrib2fv", GL_Recorder::STATE, { double(index), address (values) });
+                BASICS_GL_FORWARD(::glVertexAttrib2fv (index, values));
+            }
+
+            void glVertexAttrib3fv (GLuint index, const GLfloat * values)
+            {
+                gl_recorder.record ("glVertexAttrib3fv", GL_Recorder::STATE, { double(index), address (values) });
+                BASICS_GL_FORWARD(::glVertexAttrib3fv (index, values));
+            }
+
+            void glVertexAttrib4fv (GLuint index, const GLfloat * values)
+            {
+                gl_recorder.record ("glVertexAttrib4fv", GL_Recorder::STATE, { double(index), address (values) });
+                BASICS_GL_FORWARD(::glVertexAttrib4fv (index, values));
+            }
+
+            void glVertexAttribPointer (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void * pointer)
+            {
+                gl_recorder.record
+                (
+                    "glVertexAttribPointer",
+                    GL_Recorder::STATE,
+                    { double(index), double(size), double(type), double(normalized), double(stride), address (pointer) }
+                );
+
+                gl_recorder.set_attribute_pointer (index, size, type, stride);
+
+                BASICS_GL_FORWARD(::glVertexAttribPointer (index, size, type, normalized, stride, pointer));
+            }
+
+            void glViewport (GLint x, GLint y, GLsizei width, GLsizei height)
+            {
+                gl_recorder.record ("glViewport", GL_Recorder::STATE, { double(x), double(y), double(width), double(height) });
+                BASICS_GL_FORWARD(::glViewport (x, y, width, height));
+            }
+
+        }
+
+    }}
+
+#endif
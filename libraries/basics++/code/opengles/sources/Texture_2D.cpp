@@ -11,6 +11,8 @@
  */
 
 #include <basics/assert>
+#include <basics/Object_Pool>
+#include <basics/Render_Statistics>
 #include <basics/opengles/Texture_2D>
 
 namespace basics { namespace opengles
@@ -20,7 +22,9 @@ namespace basics { namespace opengles
 
     std::shared_ptr< basics::Texture_2D > Texture_2D::create (Id id, Color_Buffer< Rgba8888 > & color_buffer, const Options & options)
     {
-        return std::shared_ptr< Texture_2D >(new Texture_2D(color_buffer, options.width, options.height));
+        // El objeto y su contador de referencias se reservan juntos en el pool de las texturas:
+
+        return make_pooled< Texture_2D > (color_buffer, options.width, options.height);
     }
 
     bool Texture_2D::initialize ()
@@ -56,6 +60,8 @@ namespace basics { namespace opengles
                 assert(glGetError () == GL_NO_ERROR);
                 assert(width > 0 && height > 0);
 
+                memory_tracker.add (Memory_Tracker::TEXTURES_GPU, int64_t(color_buffer.get_width ()) * color_buffer.get_height () * 4);
+
                 initialized = true;
             }
         }
@@ -72,6 +78,8 @@ namespace basics { namespace opengles
             glBindTexture   (GL_TEXTURE_2D, texture_object_id);
             glActiveTexture (GL_TEXTURE0);
 
+            ++render_statistics.texture_binds;
+
             active_texture  = this;
 
             return true;
@@ -80,4 +88,16 @@ namespace basics { namespace opengles
         return false;
     }
 
+    void Texture_2D::finalize ()
+    {
+        if (initialized)
+        {
+            glDeleteTextures (1, &texture_object_id);
+
+            memory_tracker.remove (Memory_Tracker::TEXTURES_GPU, int64_t(color_buffer.get_width ()) * color_buffer.get_height () * 4);
+
+            initialized = false;
+        }
+    }
+
 }}